@@ -3,8 +3,11 @@
 #include <vector>
 #include <random>
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <unordered_map>
 #include "include/smallstring.hpp"
 
@@ -190,6 +193,14 @@ BENCHMARK_F(BenchmarkFixture, SmallByteString_SmallCopy)(benchmark::State& state
     }
 }
 
+BENCHMARK_F(BenchmarkFixture, WideSmallString_SmallCopy)(benchmark::State& state) {
+    small::wide_small_string source(small_str);
+    for (auto _ : state) {
+        small::wide_small_string copy = source;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+
 BENCHMARK_F(BenchmarkFixture, StdString_LargeCopy)(benchmark::State& state) {
     std::string source(large_str);
     for (auto _ : state) {
@@ -214,6 +225,14 @@ BENCHMARK_F(BenchmarkFixture, SmallByteString_LargeCopy)(benchmark::State& state
     }
 }
 
+BENCHMARK_F(BenchmarkFixture, WideSmallString_LargeCopy)(benchmark::State& state) {
+    small::wide_small_string source(large_str);
+    for (auto _ : state) {
+        small::wide_small_string copy = source;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+
 // =============================================================================
 // Move Operations
 // =============================================================================
@@ -342,6 +361,432 @@ BENCHMARK_F(BenchmarkFixture, SmallByteString_StringAppend)(benchmark::State& st
     }
 }
 
+// =============================================================================
+// Append-heavy Growth - log payloads growing to 4KB / 64KB / 16MB
+// =============================================================================
+
+// appends 64 bytes records until the payload reaches final_size, every growth step of a Median/Long buffer is a
+// realloc for malloc_core, reallocs/op counts the capacity changes (malloc slack harvesting lowers it)
+template <typename String>
+static void append_payload(benchmark::State& state, size_t final_size) {
+    const std::string record(64, 'L');
+    size_t reallocations = 0;
+    for (auto _ : state) {
+        String payload;
+        auto capacity = payload.capacity();
+        while (payload.size() < final_size) {
+            payload.append(record.data(), static_cast<typename String::size_type>(record.size()));
+            if (payload.capacity() != capacity) [[unlikely]] {
+                capacity = payload.capacity();
+                ++reallocations;
+            }
+        }
+        benchmark::DoNotOptimize(payload.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * final_size));
+    state.counters["reallocs/op"] =
+      benchmark::Counter(static_cast<double>(reallocations), benchmark::Counter::kAvgIterations);
+}
+
+// char by char growth of short identifiers, the Short tier is where the malloc slack is large relative to the buffer
+template <typename String>
+static void push_back_payload(benchmark::State& state, size_t final_size) {
+    size_t reallocations = 0;
+    for (auto _ : state) {
+        String payload;
+        auto capacity = payload.capacity();
+        for (size_t i = 0; i < final_size; ++i) {
+            payload.push_back(static_cast<char>('a' + i % 26));
+            if (payload.capacity() != capacity) [[unlikely]] {
+                capacity = payload.capacity();
+                ++reallocations;
+            }
+        }
+        benchmark::DoNotOptimize(payload.data());
+    }
+    state.counters["reallocs/op"] =
+      benchmark::Counter(static_cast<double>(reallocations), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_PushBackTo200)(benchmark::State& state) {
+    push_back_payload<std::string>(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_PushBackTo200)(benchmark::State& state) {
+    push_back_payload<small::small_string>(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_AppendTo4K)(benchmark::State& state) {
+    append_payload<std::string>(state, 4 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_AppendTo4K)(benchmark::State& state) {
+    append_payload<small::small_string>(state, 4 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_AppendTo64K)(benchmark::State& state) {
+    append_payload<std::string>(state, 64 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_AppendTo64K)(benchmark::State& state) {
+    append_payload<small::small_string>(state, 64 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_AppendTo16M)(benchmark::State& state) {
+    append_payload<std::string>(state, 16 * 1024 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_AppendTo16M)(benchmark::State& state) {
+    append_payload<small::small_string>(state, 16 * 1024 * 1024);
+}
+
+// =============================================================================
+// Huge Core - 64-bit Median/Long headers, Internal and Short unchanged
+// =============================================================================
+
+template <typename String>
+static void construct_mixed(benchmark::State& state, const std::vector<std::string>& strings) {
+    for (auto _ : state) {
+        for (const auto& text : strings) {
+            String str(text);
+            benchmark::DoNotOptimize(str.data());
+        }
+    }
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_ConstructShortSet)(benchmark::State& state) {
+    construct_mixed<small::small_string>(state, short_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, HugeSmallString_ConstructShortSet)(benchmark::State& state) {
+    construct_mixed<small::huge_small_string>(state, short_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_ConstructMixedSet)(benchmark::State& state) {
+    construct_mixed<small::small_string>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, HugeSmallString_ConstructMixedSet)(benchmark::State& state) {
+    construct_mixed<small::huge_small_string>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, HugeSmallString_PushBackTo200)(benchmark::State& state) {
+    push_back_payload<small::huge_small_string>(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, HugeSmallString_AppendTo4K)(benchmark::State& state) {
+    append_payload<small::huge_small_string>(state, 4 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, HugeSmallString_AppendTo16M)(benchmark::State& state) {
+    append_payload<small::huge_small_string>(state, 16 * 1024 * 1024);
+}
+
+// =============================================================================
+// Offset Core - buffers in a shared segment, addressed by segment id and offset
+// =============================================================================
+
+// one anonymous shared mapping for every offset_core benchmark, large enough for the 4K appends and the mixed set
+static auto bench_segment() -> small::shared_segment* {
+    static small::shared_segment* segment = [] {
+        constexpr std::size_t kSize = 64UL * 1024UL * 1024UL;
+        auto* region = ::mmap(nullptr, kSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        return region == MAP_FAILED ? nullptr : small::shared_segment::create(region, kSize, 1);
+    }();
+    return segment;
+}
+
+// reads every string of a table, the consumer side of a mapped table
+template <typename String>
+static void scan_table(benchmark::State& state, const std::vector<std::string>& strings) {
+    std::vector<String> table(strings.begin(), strings.end());
+    for (auto _ : state) {
+        size_t total = 0;
+        for (const auto& str : table) {
+            total += str.size() + static_cast<unsigned char>(str.c_str()[0]);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+}
+
+BENCHMARK_F(BenchmarkFixture, OffsetSmallString_ConstructMixedSet)(benchmark::State& state) {
+    small::shared_segment::scope scope(bench_segment());
+    construct_mixed<small::offset_small_string>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, OffsetSmallString_AppendTo4K)(benchmark::State& state) {
+    small::shared_segment::scope scope(bench_segment());
+    append_payload<small::offset_small_string>(state, 4 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_ScanMixedTable)(benchmark::State& state) {
+    scan_table<small::small_string>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, OffsetSmallString_ScanMixedTable)(benchmark::State& state) {
+    small::shared_segment::scope scope(bench_segment());
+    scan_table<small::offset_small_string>(state, mixed_strings);
+}
+
+// =============================================================================
+// Long Tier size() - a table of Long strings, the buffer headers are far apart
+// =============================================================================
+
+// 2048 strings of ~20K chars, 40 MB of buffers, so each header read of the scan is a cache miss
+template <typename String>
+static auto make_long_table() -> std::vector<String> {
+    std::vector<String> table;
+    table.reserve(2048);
+    for (size_t i = 0; i < 2048; ++i) {
+        std::string text(20000 + i % 64, static_cast<char>('a' + i % 26));
+        table.emplace_back(text.data(), text.size());
+    }
+    return table;
+}
+
+template <typename String>
+static void long_size_scan(benchmark::State& state) {
+    auto table = make_long_table<String>();
+    for (auto _ : state) {
+        size_t total = 0;
+        for (const auto& str : table) {
+            total += str.size();
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(table.size()));
+}
+
+// the writes keep the size cached by wide_core in sync with the buffer header
+template <typename String>
+static void long_push_pop(benchmark::State& state) {
+    auto table = make_long_table<String>();
+    for (auto _ : state) {
+        for (auto& str : table) {
+            str.push_back('x');
+            str.pop_back();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(table.size()));
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_LongSizeScan)(benchmark::State& state) {
+    long_size_scan<std::string>(state);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_LongSizeScan)(benchmark::State& state) {
+    long_size_scan<small::small_string>(state);
+}
+
+BENCHMARK_F(BenchmarkFixture, WideSmallString_LongSizeScan)(benchmark::State& state) {
+    long_size_scan<small::wide_small_string>(state);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_LongPushPop)(benchmark::State& state) {
+    long_push_pop<std::string>(state);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_LongPushPop)(benchmark::State& state) {
+    long_push_pop<small::small_string>(state);
+}
+
+BENCHMARK_F(BenchmarkFixture, WideSmallString_LongPushPop)(benchmark::State& state) {
+    long_push_pop<small::wide_small_string>(state);
+}
+
+// =============================================================================
+// Growth Policies - same append workload, different GrowthPolicy
+// =============================================================================
+
+template <typename Growth>
+using policy_small_string = small::basic_small_string<char, small::small_string_buffer, small::malloc_core,
+                                                      std::char_traits<char>, std::allocator<char>, true, Growth>;
+
+BENCHMARK_F(BenchmarkFixture, PowerOfTwoGrowth_AppendTo64K)(benchmark::State& state) {
+    append_payload<policy_small_string<small::power_of_two_growth>>(state, 64 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, JemallocClassGrowth_AppendTo64K)(benchmark::State& state) {
+    append_payload<policy_small_string<small::jemalloc_class_growth<>>>(state, 64 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, CappedGeometricGrowth_AppendTo16M)(benchmark::State& state) {
+    append_payload<policy_small_string<small::capped_geometric_growth<>>>(state, 16 * 1024 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, PowerOfTwoGrowth_AppendTo16M)(benchmark::State& state) {
+    append_payload<policy_small_string<small::power_of_two_growth>>(state, 16 * 1024 * 1024);
+}
+
+// =============================================================================
+// Shrink Policy - long-lived strings trimmed after growing
+// =============================================================================
+
+// a cache of strings resized to mostly short values with an occasional large one, a shrink policy trades
+// reallocations for the capacity the cache keeps
+template <typename String>
+static void trim_churn_payload(benchmark::State& state) {
+    std::vector<String> cache(256);
+    size_t reallocations = 0;
+    size_t round = 0;
+    for (auto _ : state) {
+        for (auto& entry : cache) {
+            auto capacity = entry.capacity();
+            auto size = round % 61 == 0 ? 8192 : 16 + round % 48;
+            entry.resize(size, 'c');
+            if (entry.capacity() != capacity) [[unlikely]] {
+                ++reallocations;
+            }
+            ++round;
+        }
+        benchmark::DoNotOptimize(cache.data());
+    }
+    size_t retained = 0;
+    for (const auto& entry : cache) {
+        retained += entry.capacity();
+    }
+    state.counters["reallocs/op"] =
+      benchmark::Counter(static_cast<double>(reallocations), benchmark::Counter::kAvgIterations);
+    state.counters["capacity/string"] = static_cast<double>(retained) / static_cast<double>(cache.size());
+}
+
+// a payload cleared and refilled to its old size, the shrink policy releases it on every clear
+template <typename String>
+static void clear_refill_payload(benchmark::State& state) {
+    const std::string record(64, 'R');
+    String payload;
+    for (auto _ : state) {
+        payload.clear();
+        while (payload.size() < 4096) {
+            payload.append(record.data(), static_cast<typename String::size_type>(record.size()));
+        }
+        benchmark::DoNotOptimize(payload.data());
+    }
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_TrimChurn)(benchmark::State& state) {
+    trim_churn_payload<std::string>(state);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_TrimChurn)(benchmark::State& state) {
+    trim_churn_payload<small::small_string>(state);
+}
+
+BENCHMARK_F(BenchmarkFixture, HysteresisShrink_TrimChurn)(benchmark::State& state) {
+    trim_churn_payload<policy_small_string<small::hysteresis_shrink<>>>(state);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_ClearRefill4K)(benchmark::State& state) {
+    clear_refill_payload<small::small_string>(state);
+}
+
+BENCHMARK_F(BenchmarkFixture, HysteresisShrink_ClearRefill4K)(benchmark::State& state) {
+    clear_refill_payload<policy_small_string<small::hysteresis_shrink<>>>(state);
+}
+
+// =============================================================================
+// Copy-on-Write - one response body fanned out to many consumers
+// =============================================================================
+
+template <typename String>
+static void fan_out_payload(benchmark::State& state, size_t body_size) {
+    const String body(std::string(body_size, 'B'));
+    std::vector<String> consumers;
+    consumers.reserve(32);
+    for (auto _ : state) {
+        for (int i = 0; i < 32; ++i) {
+            consumers.push_back(body);
+        }
+        benchmark::DoNotOptimize(consumers.data());
+        consumers.clear();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * 32));
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_FanOut16K)(benchmark::State& state) {
+    fan_out_payload<std::string>(state, 16 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_FanOut16K)(benchmark::State& state) {
+    fan_out_payload<small::small_string>(state, 16 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SharedSmallString_FanOut16K)(benchmark::State& state) {
+    fan_out_payload<small::shared_small_string>(state, 16 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_FanOut1K)(benchmark::State& state) {
+    fan_out_payload<small::small_string>(state, 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SharedSmallString_FanOut1K)(benchmark::State& state) {
+    fan_out_payload<small::shared_small_string>(state, 1024);
+}
+
+// the first write of every copy pays the deferred copy
+BENCHMARK_F(BenchmarkFixture, SharedSmallString_FanOutAndWrite16K)(benchmark::State& state) {
+    const small::shared_small_string body(std::string(16 * 1024, 'B'));
+    for (auto _ : state) {
+        auto copy = body;
+        copy.push_back('!');
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_CopyAndWrite16K)(benchmark::State& state) {
+    const small::small_string body(std::string(16 * 1024, 'B'));
+    for (auto _ : state) {
+        auto copy = body;
+        copy.push_back('!');
+        benchmark::DoNotOptimize(copy.data());
+    }
+}
+
+// =============================================================================
+// Borrowed Literals - static_text wrapped without allocation vs copied literals
+// =============================================================================
+
+static constexpr char kHeaderLiteral[] = "Content-Type: application/json; charset=utf-8";
+static constexpr small::static_text kHeaderText{"Content-Type: application/json; charset=utf-8"};
+
+BENCHMARK_F(BenchmarkFixture, StdString_ConstructLiteral)(benchmark::State& state) {
+    for (auto _ : state) {
+        std::string str(kHeaderLiteral);
+        benchmark::DoNotOptimize(str.data());
+    }
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_ConstructLiteral)(benchmark::State& state) {
+    for (auto _ : state) {
+        small::small_string str(kHeaderLiteral);
+        benchmark::DoNotOptimize(str.data());
+    }
+}
+
+BENCHMARK_F(BenchmarkFixture, BorrowingSmallString_BorrowLiteral)(benchmark::State& state) {
+    for (auto _ : state) {
+        small::borrowing_small_string str(kHeaderText);
+        benchmark::DoNotOptimize(std::as_const(str).data());
+    }
+}
+
+// =============================================================================
+// Mapped Long Tier - mmap/mremap backed payloads vs malloc/realloc
+// =============================================================================
+
+BENCHMARK_F(BenchmarkFixture, MappedSmallString_AppendTo16M)(benchmark::State& state) {
+    append_payload<small::mapped_small_string>(state, 16 * 1024 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_AppendTo128M)(benchmark::State& state) {
+    append_payload<small::small_string>(state, 128 * 1024 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, MappedSmallString_AppendTo128M)(benchmark::State& state) {
+    append_payload<small::mapped_small_string>(state, 128 * 1024 * 1024);
+}
+
 // =============================================================================
 // Search Operations
 // =============================================================================
@@ -378,20 +823,542 @@ BENCHMARK_F(BenchmarkFixture, StdString_CharFind)(benchmark::State& state) {
     }
 }
 
-BENCHMARK_F(BenchmarkFixture, SmallString_CharFind)(benchmark::State& state) {
-    small::small_string haystack = "Lorem ipsum dolor sit amet, consectetur adipiscing elit";
+BENCHMARK_F(BenchmarkFixture, SmallString_CharFind)(benchmark::State& state) {
+    small::small_string haystack = "Lorem ipsum dolor sit amet, consectetur adipiscing elit";
+    for (auto _ : state) {
+        auto pos = haystack.find('e');
+        benchmark::DoNotOptimize(pos);
+    }
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallByteString_CharFind)(benchmark::State& state) {
+    small::small_byte_string haystack = "Lorem ipsum dolor sit amet, consectetur adipiscing elit";
+    for (auto _ : state) {
+        auto pos = haystack.find('e');
+        benchmark::DoNotOptimize(pos);
+    }
+}
+
+// log lines full of spaces, the needle starts with a space and sits at the end, sizes from Internal to Long
+static auto spaced_haystack(size_t size) -> std::string {
+    std::string text;
+    while (text.size() + 3 < size) {
+        text += "k v ";
+    }
+    text.resize(size - 3, ' ');
+    return text + " x=";
+}
+
+template <typename String>
+static void find_common_first(benchmark::State& state, size_t size) {
+    auto text = spaced_haystack(size);
+    String haystack(text.data(), text.size());
+    for (auto _ : state) {
+        auto pos = haystack.find(" x=");
+        benchmark::DoNotOptimize(pos);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+// JSON full of quotes, the needle is a quoted key
+template <typename String>
+static void find_json_key(benchmark::State& state, size_t size) {
+    std::string text;
+    while (text.size() + 12 < size) {
+        text += "\"a\":\"b\",";
+    }
+    text.resize(size - 12, '"');
+    text += "\"timestamp\":";
+    String haystack(text.data(), text.size());
+    for (auto _ : state) {
+        auto pos = haystack.find("\"timestamp\"");
+        benchmark::DoNotOptimize(pos);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_InternalSpaces_Find)(benchmark::State& state) {
+    find_common_first<std::string>(state, 6);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_InternalSpaces_Find)(benchmark::State& state) {
+    find_common_first<small::small_string>(state, 6);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_ShortSpaces_Find)(benchmark::State& state) {
+    find_common_first<std::string>(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_ShortSpaces_Find)(benchmark::State& state) {
+    find_common_first<small::small_string>(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_MedianSpaces_Find)(benchmark::State& state) {
+    find_common_first<std::string>(state, 4000);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_MedianSpaces_Find)(benchmark::State& state) {
+    find_common_first<small::small_string>(state, 4000);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_LongSpaces_Find)(benchmark::State& state) {
+    find_common_first<std::string>(state, 64 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_LongSpaces_Find)(benchmark::State& state) {
+    find_common_first<small::small_string>(state, 64 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_ShortJson_Find)(benchmark::State& state) {
+    find_json_key<std::string>(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_ShortJson_Find)(benchmark::State& state) {
+    find_json_key<small::small_string>(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_LongJson_Find)(benchmark::State& state) {
+    find_json_key<std::string>(state, 64 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_LongJson_Find)(benchmark::State& state) {
+    find_json_key<small::small_string>(state, 64 * 1024);
+}
+
+// deep paths, the last separator and the last "/dir" are near the start of the last component
+static auto deep_path(size_t size) -> std::string {
+    std::string path;
+    while (path.size() + 16 < size) {
+        path += "/segment";
+    }
+    path += "/";
+    path.resize(size, 'f');
+    return path;
+}
+
+template <typename String>
+static void rfind_separator(benchmark::State& state, size_t size) {
+    auto text = deep_path(size);
+    // the first component holds the only '\\', the scan walks the whole string
+    text[1] = '\\';
+    String haystack(text.data(), text.size());
+    for (auto _ : state) {
+        auto pos = haystack.rfind('\\');
+        benchmark::DoNotOptimize(pos);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+template <typename String>
+static void rfind_component(benchmark::State& state, size_t size) {
+    auto text = deep_path(size);
+    text.replace(0, 4, "/top");
+    String haystack(text.data(), text.size());
+    for (auto _ : state) {
+        auto pos = haystack.rfind("/top");
+        benchmark::DoNotOptimize(pos);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+static void memrchr_separator(benchmark::State& state, size_t size) {
+    auto text = deep_path(size);
+    text[1] = '\\';
+    for (auto _ : state) {
+        const auto* found = ::memrchr(text.data(), '\\', text.size());
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+BENCHMARK_F(BenchmarkFixture, Memrchr_ShortPath_RFind)(benchmark::State& state) {
+    memrchr_separator(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_ShortPath_RFind)(benchmark::State& state) {
+    rfind_separator<std::string>(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_ShortPath_RFind)(benchmark::State& state) {
+    rfind_separator<small::small_string>(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, Memrchr_LongPath_RFind)(benchmark::State& state) {
+    memrchr_separator(state, 64 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_LongPath_RFind)(benchmark::State& state) {
+    rfind_separator<std::string>(state, 64 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_LongPath_RFind)(benchmark::State& state) {
+    rfind_separator<small::small_string>(state, 64 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_ShortComponent_RFind)(benchmark::State& state) {
+    rfind_component<std::string>(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_ShortComponent_RFind)(benchmark::State& state) {
+    rfind_component<small::small_string>(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_LongComponent_RFind)(benchmark::State& state) {
+    rfind_component<std::string>(state, 64 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_LongComponent_RFind)(benchmark::State& state) {
+    rfind_component<small::small_string>(state, 64 * 1024);
+}
+
+// counts the tokens of a text split on whitespace and punctuation
+static constexpr std::string_view kTokenSeparators = " \t\r\n,.;:!?()[]{}\"'";
+
+static auto token_text(size_t size) -> std::string {
+    std::string text;
+    while (text.size() < size) {
+        text += "lorem, ipsum (dolor) sit; amet: consectetur_adipiscing\t";
+    }
+    text.resize(size);
+    return text;
+}
+
+template <typename String, typename Separators>
+static void tokenize(benchmark::State& state, size_t size, const Separators& separators) {
+    auto text = token_text(size);
+    String haystack(text.data(), text.size());
+    for (auto _ : state) {
+        size_t tokens = 0;
+        auto begin = haystack.find_first_not_of(separators);
+        while (begin != String::npos) {
+            auto end = haystack.find_first_of(separators, begin);
+            ++tokens;
+            if (end == String::npos) {
+                break;
+            }
+            begin = haystack.find_first_not_of(separators, end);
+        }
+        benchmark::DoNotOptimize(tokens);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_ShortTokens_FindFirstOf)(benchmark::State& state) {
+    tokenize<std::string>(state, 200, kTokenSeparators);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_ShortTokens_FindFirstOf)(benchmark::State& state) {
+    tokenize<small::small_string>(state, 200, kTokenSeparators);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallStringCharSet_ShortTokens_FindFirstOf)(benchmark::State& state) {
+    tokenize<small::small_string>(state, 200, small::char_set(kTokenSeparators));
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_LongTokens_FindFirstOf)(benchmark::State& state) {
+    tokenize<std::string>(state, 64 * 1024, kTokenSeparators);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_LongTokens_FindFirstOf)(benchmark::State& state) {
+    tokenize<small::small_string>(state, 64 * 1024, kTokenSeparators);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallStringCharSet_LongTokens_FindFirstOf)(benchmark::State& state) {
+    tokenize<small::small_string>(state, 64 * 1024, small::char_set(kTokenSeparators));
+}
+
+// the last char outside a set of trailing padding, over a long run of padding
+template <typename String, typename Padding>
+static void trim_right(benchmark::State& state, const Padding& padding) {
+    std::string text = "payload" + std::string(64 * 1024, ' ');
+    for (size_t i = 7; i < text.size(); i += 3) {
+        text[i] = '\t';
+    }
+    String haystack(text.data(), text.size());
+    for (auto _ : state) {
+        auto pos = haystack.find_last_not_of(padding);
+        benchmark::DoNotOptimize(pos);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_TrimRight_FindLastNotOf)(benchmark::State& state) {
+    trim_right<std::string>(state, std::string_view(" \t\r\n"));
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_TrimRight_FindLastNotOf)(benchmark::State& state) {
+    trim_right<small::small_string>(state, std::string_view(" \t\r\n"));
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallStringCharSet_TrimRight_FindLastNotOf)(benchmark::State& state) {
+    trim_right<small::small_string>(state, small::char_set(" \t\r\n"));
+}
+
+// the same needle over many payloads, needle lengths 1 to 64 as the benchmark argument
+static auto payload_text() -> std::string {
+    static const char* const words[] = {"the ",   "quick ", "brown ",  "fox ",   "jumps ", "over ", "lazy ", "dog ",
+                                        "lorem ", "ipsum ", "payload ", "value ", "key ",   "id ",   "user "};
+    std::mt19937 gen(42);
+    std::string text;
+    while (text.size() < 64 * 1024) {
+        text += words[gen() % std::size(words)];
+    }
+    return text;
+}
+
+// a needle cut from the text with its middle byte changed, so it misses and the whole payload is scanned
+static auto payload_needle(const std::string& text, size_t count) -> std::string {
+    std::string needle = text.substr(1000, count);
+    needle[count / 2] = '#';
+    return needle;
+}
+
+template <typename String>
+static void find_needle_matrix(benchmark::State& state) {
+    auto text = payload_text();
+    auto needle = payload_needle(text, static_cast<size_t>(state.range(0)));
+    String haystack(text.data(), text.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(haystack.find(needle));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, StdString_Needle_Find)(benchmark::State& state) {
+    find_needle_matrix<std::string>(state);
+}
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, SmallString_Needle_Find)(benchmark::State& state) {
+    find_needle_matrix<small::small_string>(state);
+}
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, SmallString_Needle_FindSearcher)(benchmark::State& state) {
+    auto text = payload_text();
+    const small::searcher needle(payload_needle(text, static_cast<size_t>(state.range(0))));
+    small::small_string haystack(text.data(), text.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(haystack.find(needle));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, StdString_Needle_StdHorspool)(benchmark::State& state) {
+    auto text = payload_text();
+    auto needle = payload_needle(text, static_cast<size_t>(state.range(0)));
+    const std::boyer_moore_horspool_searcher horspool(needle.begin(), needle.end());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::search(text.begin(), text.end(), horspool));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+BENCHMARK_DEFINE_F(BenchmarkFixture, StdString_Needle_StdSearchSearcher)(benchmark::State& state) {
+    auto text = payload_text();
+    const small::searcher needle(payload_needle(text, static_cast<size_t>(state.range(0))));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::search(text.begin(), text.end(), needle));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+
+BENCHMARK_REGISTER_F(BenchmarkFixture, StdString_Needle_Find)->RangeMultiplier(2)->Range(1, 64);
+BENCHMARK_REGISTER_F(BenchmarkFixture, SmallString_Needle_Find)->RangeMultiplier(2)->Range(1, 64);
+BENCHMARK_REGISTER_F(BenchmarkFixture, SmallString_Needle_FindSearcher)->RangeMultiplier(2)->Range(1, 64);
+BENCHMARK_REGISTER_F(BenchmarkFixture, StdString_Needle_StdHorspool)->RangeMultiplier(2)->Range(1, 64);
+BENCHMARK_REGISTER_F(BenchmarkFixture, StdString_Needle_StdSearchSearcher)->RangeMultiplier(2)->Range(1, 64);
+
+// an ingest filter: messages checked against a deny list of 5000 substrings that none of them contains
+static auto deny_list() -> std::vector<std::string> {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::vector<std::string> patterns;
+    while (patterns.size() < 5000) {
+        std::string pattern(6 + gen() % 7, ' ');
+        for (auto& ch : pattern) {
+            ch = static_cast<char>(letter(gen));
+        }
+        if (payload_text().find(pattern) == std::string::npos) {
+            patterns.push_back(pattern);
+        }
+    }
+    return patterns;
+}
+
+template <typename String>
+static void deny_list_loop_find(benchmark::State& state, size_t size) {
+    static const auto patterns = deny_list();
+    auto text = payload_text().substr(0, size);
+    String message(text.data(), text.size());
+    for (auto _ : state) {
+        bool denied = false;
+        for (const auto& pattern : patterns) {
+            if (message.find(std::string_view(pattern)) != String::npos) {
+                denied = true;
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(denied);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+static void deny_list_multi_searcher(benchmark::State& state, size_t size) {
+    static const auto patterns = deny_list();
+    static const small::multi_searcher searcher(patterns.begin(), patterns.end());
+    auto text = payload_text().substr(0, size);
+    small::small_string message(text.data(), text.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(message.find(searcher) != small::small_string::npos);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_ShortDenyList_LoopFind)(benchmark::State& state) {
+    deny_list_loop_find<std::string>(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_ShortDenyList_LoopFind)(benchmark::State& state) {
+    deny_list_loop_find<small::small_string>(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_ShortDenyList_MultiSearcher)(benchmark::State& state) {
+    deny_list_multi_searcher(state, 200);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdString_LongDenyList_LoopFind)(benchmark::State& state) {
+    deny_list_loop_find<std::string>(state, 16 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_LongDenyList_LoopFind)(benchmark::State& state) {
+    deny_list_loop_find<small::small_string>(state, 16 * 1024);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_LongDenyList_MultiSearcher)(benchmark::State& state) {
+    deny_list_multi_searcher(state, 16 * 1024);
+}
+
+// =============================================================================
+// UTF-16 / UTF-32 Strings - char16_t and char32_t code units
+// =============================================================================
+
+template<typename String>
+String widen(const std::string& text) {
+    String wide;
+    for (char ch : text) {
+        wide.push_back(static_cast<typename String::value_type>(ch));
+    }
+    return wide;
+}
+
+template<typename String>
+void construct_wide_mixed(benchmark::State& state, const std::vector<std::string>& strings) {
+    using WideStd = std::basic_string<typename String::value_type>;
+    std::vector<WideStd> wide_strings;
+    for (const auto& text : strings) {
+        wide_strings.push_back(widen<WideStd>(text));
+    }
+    for (auto _ : state) {
+        for (const auto& text : wide_strings) {
+            String str(text);
+            benchmark::DoNotOptimize(str.data());
+        }
+    }
+}
+
+template<typename String>
+void find_wide(benchmark::State& state) {
+    auto haystack = widen<String>("Lorem ipsum dolor sit amet, consectetur adipiscing elit");
+    auto needle = widen<String>("dolor");
+    for (auto _ : state) {
+        auto pos = haystack.find(needle.data(), 0, needle.size());
+        benchmark::DoNotOptimize(pos);
+    }
+}
+
+BENCHMARK_F(BenchmarkFixture, StdU16String_ConstructMixed)(benchmark::State& state) {
+    construct_wide_mixed<std::u16string>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallU16String_ConstructMixed)(benchmark::State& state) {
+    construct_wide_mixed<small::u16string>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdU32String_ConstructMixed)(benchmark::State& state) {
+    construct_wide_mixed<std::u32string>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallU32String_ConstructMixed)(benchmark::State& state) {
+    construct_wide_mixed<small::u32string>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdU16String_AppendTo4K)(benchmark::State& state) {
+    for (auto _ : state) {
+        std::u16string str;
+        for (int i = 0; i < 4096; ++i) {
+            str.push_back(u'\u03b1');
+        }
+        benchmark::DoNotOptimize(str.data());
+    }
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallU16String_AppendTo4K)(benchmark::State& state) {
+    for (auto _ : state) {
+        small::u16string str;
+        for (int i = 0; i < 4096; ++i) {
+            str.push_back(u'\u03b1');
+        }
+        benchmark::DoNotOptimize(str.data());
+    }
+}
+
+BENCHMARK_F(BenchmarkFixture, StdU16String_Find)(benchmark::State& state) {
+    find_wide<std::u16string>(state);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallU16String_Find)(benchmark::State& state) {
+    find_wide<small::u16string>(state);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdU32String_Find)(benchmark::State& state) {
+    find_wide<std::u32string>(state);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallU32String_Find)(benchmark::State& state) {
+    find_wide<small::u32string>(state);
+}
+
+BENCHMARK_F(BenchmarkFixture, MemoryFootprint_StdU16String_VectorMixed)(benchmark::State& state) {
+    std::vector<std::u16string> vec;
+    size_t memory_usage = sizeof(vec);
+    for (const auto& text : mixed_strings) {
+        vec.push_back(widen<std::u16string>(text));
+    }
+    memory_usage += vec.capacity() * sizeof(std::u16string);
+    for (const auto& str : vec) {
+        memory_usage += str.capacity() > 7 ? (str.capacity() + 1) * sizeof(char16_t) : 0;
+    }
     for (auto _ : state) {
-        auto pos = haystack.find('e');
-        benchmark::DoNotOptimize(pos);
+        benchmark::DoNotOptimize(memory_usage);
     }
+    state.counters["MemoryBytes"] = static_cast<double>(memory_usage);
+    state.counters["MemoryPerItem"] = static_cast<double>(memory_usage) / vec.size();
 }
 
-BENCHMARK_F(BenchmarkFixture, SmallByteString_CharFind)(benchmark::State& state) {
-    small::small_byte_string haystack = "Lorem ipsum dolor sit amet, consectetur adipiscing elit";
+BENCHMARK_F(BenchmarkFixture, MemoryFootprint_SmallU16String_VectorMixed)(benchmark::State& state) {
+    std::vector<small::u16string> vec;
+    size_t memory_usage = sizeof(vec);
+    for (const auto& text : mixed_strings) {
+        vec.push_back(widen<small::u16string>(text));
+    }
+    memory_usage += vec.capacity() * sizeof(small::u16string);
+    for (const auto& str : vec) {
+        memory_usage += str.capacity() > 2 ? (str.capacity() + 1) * sizeof(char16_t) : 0;
+    }
     for (auto _ : state) {
-        auto pos = haystack.find('e');
-        benchmark::DoNotOptimize(pos);
+        benchmark::DoNotOptimize(memory_usage);
     }
+    state.counters["MemoryBytes"] = static_cast<double>(memory_usage);
+    state.counters["MemoryPerItem"] = static_cast<double>(memory_usage) / vec.size();
 }
 
 // =============================================================================
@@ -480,6 +1447,16 @@ BENCHMARK_F(BenchmarkFixture, SmallByteString_MapInsert)(benchmark::State& state
     }
 }
 
+BENCHMARK_F(BenchmarkFixture, WideSmallString_MapInsert)(benchmark::State& state) {
+    for (auto _ : state) {
+        std::map<small::wide_small_string, int> map;
+        for (size_t i = 0; i < short_strings.size(); ++i) {
+            map.emplace(small::wide_small_string(short_strings[i]), static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(map);
+    }
+}
+
 BENCHMARK_F(BenchmarkFixture, StdString_MapLookup)(benchmark::State& state) {
     std::map<std::string, int> map;
     for (size_t i = 0; i < short_strings.size(); ++i) {
@@ -532,6 +1509,25 @@ BENCHMARK_F(BenchmarkFixture, SmallByteString_MapLookup)(benchmark::State& state
     }
 }
 
+BENCHMARK_F(BenchmarkFixture, WideSmallString_MapLookup)(benchmark::State& state) {
+    std::map<small::wide_small_string, int> map;
+    std::vector<small::wide_small_string> keys;
+    keys.reserve(short_strings.size());
+    
+    for (size_t i = 0; i < short_strings.size(); ++i) {
+        small::wide_small_string key(short_strings[i]);
+        map.emplace(key, static_cast<int>(i));
+        keys.push_back(key);
+    }
+    
+    for (auto _ : state) {
+        for (const auto& key : keys) {
+            auto it = map.find(key);
+            benchmark::DoNotOptimize(it);
+        }
+    }
+}
+
 BENCHMARK_F(BenchmarkFixture, StdString_MapIteration)(benchmark::State& state) {
     std::map<std::string, int> map;
     for (size_t i = 0; i < short_strings.size(); ++i) {
@@ -605,6 +1601,16 @@ BENCHMARK_F(BenchmarkFixture, SmallByteString_MapInsertMedium)(benchmark::State&
     }
 }
 
+BENCHMARK_F(BenchmarkFixture, WideSmallString_MapInsertMedium)(benchmark::State& state) {
+    for (auto _ : state) {
+        std::map<small::wide_small_string, int> map;
+        for (size_t i = 0; i < medium_strings.size(); ++i) {
+            map.emplace(small::wide_small_string(medium_strings[i]), static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(map);
+    }
+}
+
 BENCHMARK_F(BenchmarkFixture, StdString_MapLookupMedium)(benchmark::State& state) {
     std::map<std::string, int> map;
     for (size_t i = 0; i < medium_strings.size(); ++i) {
@@ -657,6 +1663,25 @@ BENCHMARK_F(BenchmarkFixture, SmallByteString_MapLookupMedium)(benchmark::State&
     }
 }
 
+BENCHMARK_F(BenchmarkFixture, WideSmallString_MapLookupMedium)(benchmark::State& state) {
+    std::map<small::wide_small_string, int> map;
+    std::vector<small::wide_small_string> keys;
+    keys.reserve(medium_strings.size());
+    
+    for (size_t i = 0; i < medium_strings.size(); ++i) {
+        small::wide_small_string key(medium_strings[i]);
+        map.emplace(key, static_cast<int>(i));
+        keys.push_back(key);
+    }
+    
+    for (auto _ : state) {
+        for (const auto& key : keys) {
+            auto it = map.find(key);
+            benchmark::DoNotOptimize(it);
+        }
+    }
+}
+
 BENCHMARK_F(BenchmarkFixture, StdString_MapIterationMedium)(benchmark::State& state) {
     std::map<std::string, int> map;
     for (size_t i = 0; i < medium_strings.size(); ++i) {
@@ -1192,6 +2217,16 @@ BENCHMARK_F(BenchmarkFixture, SmallByteString_MapInsertMixed)(benchmark::State&
     }
 }
 
+BENCHMARK_F(BenchmarkFixture, WideSmallString_MapInsertMixed)(benchmark::State& state) {
+    for (auto _ : state) {
+        std::map<small::wide_small_string, int> map;
+        for (size_t i = 0; i < mixed_strings.size(); ++i) {
+            map.emplace(small::wide_small_string(mixed_strings[i]), static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(map);
+    }
+}
+
 BENCHMARK_F(BenchmarkFixture, StdString_MapLookupMixed)(benchmark::State& state) {
     std::map<std::string, int> map;
     for (size_t i = 0; i < mixed_strings.size(); ++i) {
@@ -1244,6 +2279,25 @@ BENCHMARK_F(BenchmarkFixture, SmallByteString_MapLookupMixed)(benchmark::State&
     }
 }
 
+BENCHMARK_F(BenchmarkFixture, WideSmallString_MapLookupMixed)(benchmark::State& state) {
+    std::map<small::wide_small_string, int> map;
+    std::vector<small::wide_small_string> keys;
+    keys.reserve(mixed_strings.size());
+    
+    for (size_t i = 0; i < mixed_strings.size(); ++i) {
+        small::wide_small_string key(mixed_strings[i]);
+        map.emplace(key, static_cast<int>(i));
+        keys.push_back(key);
+    }
+    
+    for (auto _ : state) {
+        for (const auto& key : keys) {
+            auto it = map.find(key);
+            benchmark::DoNotOptimize(it);
+        }
+    }
+}
+
 BENCHMARK_F(BenchmarkFixture, StdString_UnorderedMapInsertMixed)(benchmark::State& state) {
     for (auto _ : state) {
         std::unordered_map<std::string, int> map;
@@ -1326,6 +2380,308 @@ BENCHMARK_F(BenchmarkFixture, SmallByteString_UnorderedMapLookupMixed)(benchmark
     }
 }
 
+// keys are interned into the global table, after the first iteration interning is a shared-lock lookup
+BENCHMARK_F(BenchmarkFixture, Atom_UnorderedMapInsertMixed)(benchmark::State& state) {
+    for (auto _ : state) {
+        std::unordered_map<small::atom, int> map;
+        for (size_t i = 0; i < mixed_strings.size(); ++i) {
+            map.emplace(small::atom(mixed_strings[i]), static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(map);
+    }
+}
+
+// hash is the cached one and equality a pointer compare, no key bytes are touched
+BENCHMARK_F(BenchmarkFixture, Atom_UnorderedMapLookupMixed)(benchmark::State& state) {
+    std::unordered_map<small::atom, int> map;
+    std::vector<small::atom> keys;
+    keys.reserve(mixed_strings.size());
+
+    for (size_t i = 0; i < mixed_strings.size(); ++i) {
+        small::atom key(mixed_strings[i]);
+        map.emplace(key, static_cast<int>(i));
+        keys.push_back(key);
+    }
+
+    for (auto _ : state) {
+        for (const auto& key : keys) {
+            auto it = map.find(key);
+            benchmark::DoNotOptimize(it);
+        }
+    }
+}
+
+
+// =============================================================================
+// Short Tier Allocation - pooled_core vs malloc_core
+// =============================================================================
+
+// medium_strings (15-50 chars) are all Short tier buffers, so every string costs one std::malloc with malloc_core,
+// pooled_core only hits the system when a new slab is needed. allocs/op counts system allocations per string.
+
+BENCHMARK_F(BenchmarkFixture, SmallString_ShortAllocChurn)(benchmark::State& state) {
+    size_t heap_allocs = 0;
+    std::vector<small::small_string> strings;
+    strings.reserve(medium_strings.size());
+    for (auto _ : state) {
+        for (const auto& str : medium_strings) {
+            strings.emplace_back(str);
+        }
+        heap_allocs += strings.size();
+        benchmark::DoNotOptimize(strings.data());
+        strings.clear();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * medium_strings.size()));
+    state.counters["allocs/op"] = benchmark::Counter(static_cast<double>(heap_allocs) / medium_strings.size(),
+                                                     benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_F(BenchmarkFixture, PooledSmallString_ShortAllocChurn)(benchmark::State& state) {
+    auto slabs_before = small::short_buffer_pool::slab_count();
+    std::vector<small::pooled_small_string> strings;
+    strings.reserve(medium_strings.size());
+    for (auto _ : state) {
+        for (const auto& str : medium_strings) {
+            strings.emplace_back(str);
+        }
+        benchmark::DoNotOptimize(strings.data());
+        strings.clear();
+    }
+    auto heap_allocs = small::short_buffer_pool::slab_count() - slabs_before;
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * medium_strings.size()));
+    state.counters["allocs/op"] = benchmark::Counter(static_cast<double>(heap_allocs) / medium_strings.size(),
+                                                     benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_F(BenchmarkFixture, SmallString_ShortAllocMapInsert)(benchmark::State& state) {
+    size_t heap_allocs = 0;
+    for (auto _ : state) {
+        std::map<small::small_string, int> map;
+        for (size_t i = 0; i < medium_strings.size(); ++i) {
+            map.emplace(small::small_string(medium_strings[i]), static_cast<int>(i));
+        }
+        heap_allocs += map.size();
+        benchmark::DoNotOptimize(map);
+    }
+    state.counters["allocs/op"] = benchmark::Counter(static_cast<double>(heap_allocs) / medium_strings.size(),
+                                                     benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_F(BenchmarkFixture, PooledSmallString_ShortAllocMapInsert)(benchmark::State& state) {
+    auto slabs_before = small::short_buffer_pool::slab_count();
+    for (auto _ : state) {
+        std::map<small::pooled_small_string, int> map;
+        for (size_t i = 0; i < medium_strings.size(); ++i) {
+            map.emplace(small::pooled_small_string(medium_strings[i]), static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(map);
+    }
+    auto heap_allocs = small::short_buffer_pool::slab_count() - slabs_before;
+    state.counters["allocs/op"] = benchmark::Counter(static_cast<double>(heap_allocs) / medium_strings.size(),
+                                                     benchmark::Counter::kAvgIterations);
+}
+
+// =============================================================================
+// PMR Strings over Pool Resources
+// =============================================================================
+
+BENCHMARK_F(BenchmarkFixture, PmrSmallString_NewDeleteChurnMixed)(benchmark::State& state) {
+    std::pmr::polymorphic_allocator<char> alloc{std::pmr::new_delete_resource()};
+    std::vector<small::pmr::small_string> strings;
+    strings.reserve(mixed_strings.size());
+    for (auto _ : state) {
+        for (const auto& str : mixed_strings) {
+            strings.emplace_back(str, alloc);
+        }
+        benchmark::DoNotOptimize(strings.data());
+        strings.clear();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * mixed_strings.size()));
+}
+
+BENCHMARK_F(BenchmarkFixture, PmrSmallString_UnsyncPoolChurnMixed)(benchmark::State& state) {
+    std::pmr::unsynchronized_pool_resource pool;
+    std::pmr::polymorphic_allocator<char> alloc{&pool};
+    std::vector<small::pmr::small_string> strings;
+    strings.reserve(mixed_strings.size());
+    for (auto _ : state) {
+        for (const auto& str : mixed_strings) {
+            strings.emplace_back(str, alloc);
+        }
+        benchmark::DoNotOptimize(strings.data());
+        strings.clear();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * mixed_strings.size()));
+}
+
+BENCHMARK_F(BenchmarkFixture, PmrSmallString_SyncPoolChurnMixed)(benchmark::State& state) {
+    std::pmr::synchronized_pool_resource pool;
+    std::pmr::polymorphic_allocator<char> alloc{&pool};
+    std::vector<small::pmr::small_string> strings;
+    strings.reserve(mixed_strings.size());
+    for (auto _ : state) {
+        for (const auto& str : mixed_strings) {
+            strings.emplace_back(str, alloc);
+        }
+        benchmark::DoNotOptimize(strings.data());
+        strings.clear();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * mixed_strings.size()));
+}
+
+BENCHMARK_F(BenchmarkFixture, PmrSmallString_UnsyncPoolMapInsertMixed)(benchmark::State& state) {
+    std::pmr::unsynchronized_pool_resource pool;
+    std::pmr::polymorphic_allocator<char> alloc{&pool};
+    for (auto _ : state) {
+        std::map<small::pmr::small_string, int> map;
+        for (size_t i = 0; i < mixed_strings.size(); ++i) {
+            map.emplace(small::pmr::small_string(mixed_strings[i], alloc), static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(map);
+    }
+}
+
+// =============================================================================
+// Arena Teardown - per-request strings on a monotonic_buffer_resource
+// =============================================================================
+
+// one request: the strings are built on a fresh arena, then the vector is destroyed and the arena released
+template <typename String>
+static void arena_request(benchmark::State& state, const std::vector<std::string>& source) {
+    std::vector<std::byte> initial(256 * 1024);
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena{initial.data(), initial.size()};
+        std::vector<String> strings;
+        strings.reserve(source.size());
+        for (const auto& str : source) {
+            strings.emplace_back(str, &arena);
+        }
+        benchmark::DoNotOptimize(strings.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+}
+
+// only the teardown is timed, with a trivial destructor destroying the vector doesn't visit the strings
+template <typename String>
+static void arena_teardown(benchmark::State& state, const std::vector<std::string>& source) {
+    std::vector<std::byte> initial(256 * 1024);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto arena = std::make_unique<std::pmr::monotonic_buffer_resource>(initial.data(), initial.size());
+        auto strings = std::make_unique<std::vector<String>>();
+        strings->reserve(source.size());
+        for (const auto& str : source) {
+            strings->emplace_back(str, arena.get());
+        }
+        state.ResumeTiming();
+        strings.reset();
+        arena.reset();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+}
+
+BENCHMARK_F(BenchmarkFixture, StdPmrString_ArenaRequestMixed)(benchmark::State& state) {
+    arena_request<std::pmr::string>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, PmrSmallString_ArenaRequestMixed)(benchmark::State& state) {
+    arena_request<small::pmr::small_string>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, PmrArenaString_ArenaRequestMixed)(benchmark::State& state) {
+    arena_request<small::pmr::arena_string>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, StdPmrString_ArenaTeardownMixed)(benchmark::State& state) {
+    arena_teardown<std::pmr::string>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, PmrSmallString_ArenaTeardownMixed)(benchmark::State& state) {
+    arena_teardown<small::pmr::small_string>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, PmrArenaString_ArenaTeardownMixed)(benchmark::State& state) {
+    arena_teardown<small::pmr::arena_string>(state, mixed_strings);
+}
+
+// =============================================================================
+// Tagged Core - 8 bytes strings on a registered arena vs the 16 bytes pmr_core
+// =============================================================================
+
+// counts the bytes the strings take from an arena
+class counting_arena_resource : public std::pmr::memory_resource {
+public:
+    size_t allocated = 0;
+
+private:
+    std::pmr::monotonic_buffer_resource arena;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        allocated += bytes;
+        return arena.allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override { arena.deallocate(ptr, bytes, alignment); }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+BENCHMARK_F(BenchmarkFixture, MemoryFootprint_PmrSmallString_ArenaMixed)(benchmark::State& state) {
+    counting_arena_resource arena;
+    std::vector<small::pmr::small_string> vec;
+    vec.reserve(mixed_strings.size());
+    for (const auto& str : mixed_strings) {
+        vec.emplace_back(str, &arena);
+    }
+    size_t memory_usage = vec.capacity() * sizeof(small::pmr::small_string) + arena.allocated;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(memory_usage);
+    }
+    state.counters["MemoryBytes"] = static_cast<double>(memory_usage);
+    state.counters["MemoryPerItem"] = static_cast<double>(memory_usage) / vec.size();
+}
+
+BENCHMARK_F(BenchmarkFixture, MemoryFootprint_TaggedString_ArenaMixed)(benchmark::State& state) {
+    counting_arena_resource arena;
+    auto index = small::resource_registry::add(&arena);
+    size_t memory_usage = 0;
+    size_t count = 0;
+    {
+        small::resource_registry::scope scope(index);
+        std::vector<small::pmr::tagged_string> vec;
+        vec.reserve(mixed_strings.size());
+        for (const auto& str : mixed_strings) {
+            vec.emplace_back(str);
+        }
+        memory_usage = vec.capacity() * sizeof(small::pmr::tagged_string) + arena.allocated;
+        count = vec.size();
+    }
+    small::resource_registry::remove(index);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(memory_usage);
+    }
+    state.counters["MemoryBytes"] = static_cast<double>(memory_usage);
+    state.counters["MemoryPerItem"] = static_cast<double>(memory_usage) / count;
+}
+
+BENCHMARK_F(BenchmarkFixture, TaggedString_ArenaRequestMixed)(benchmark::State& state) {
+    std::vector<std::byte> initial(256 * 1024);
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena{initial.data(), initial.size()};
+        auto index = small::resource_registry::add(&arena);
+        {
+            small::resource_registry::scope scope(index);
+            std::vector<small::pmr::tagged_string> strings;
+            strings.reserve(mixed_strings.size());
+            for (const auto& str : mixed_strings) {
+                strings.emplace_back(str);
+            }
+            benchmark::DoNotOptimize(strings.data());
+        }
+        small::resource_registry::remove(index);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * mixed_strings.size()));
+}
 
 // =============================================================================
 // Memory Footprint Benchmarks
@@ -1922,6 +3278,59 @@ BENCHMARK_F(BenchmarkFixture, MemoryFootprint_SmallByteString_VectorMixed)(bench
     state.counters["MemoryPerItem"] = static_cast<double>(memory_usage) / vec.size();
 }
 
+// Growth-heavy variants: no reserve, 16000 strings pushed one by one, every reallocation relocates all of them
+template<typename Vector>
+void push_without_reserve(benchmark::State& state, const std::vector<std::string>& strings) {
+    constexpr size_t kRounds = 16;
+    size_t memory_usage = 0;
+    size_t item_count = 0;
+    for (auto _ : state) {
+        Vector vec;
+        for (size_t round = 0; round < kRounds; ++round) {
+            for (const auto& str : strings) {
+                vec.emplace_back(str);
+            }
+        }
+        benchmark::DoNotOptimize(vec.data());
+        memory_usage = sizeof(vec) + vec.capacity() * sizeof(typename Vector::value_type);
+        for (const auto& str : vec) {
+            if constexpr (std::is_same_v<typename Vector::value_type, std::string>) {
+                memory_usage += str.capacity() > 15 ? str.capacity() : 0;
+            } else {
+                memory_usage += str.capacity();
+            }
+        }
+        item_count = vec.size();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * item_count));
+    state.counters["MemoryBytes"] = static_cast<double>(memory_usage);
+    state.counters["MemoryPerItem"] = static_cast<double>(memory_usage) / static_cast<double>(item_count);
+}
+
+BENCHMARK_F(BenchmarkFixture, MemoryFootprint_StdString_VectorGrowth)(benchmark::State& state) {
+    push_without_reserve<std::vector<std::string>>(state, short_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, MemoryFootprint_SmallString_VectorGrowth)(benchmark::State& state) {
+    push_without_reserve<std::vector<small::small_string>>(state, short_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, MemoryFootprint_SmallString_StringVectorGrowth)(benchmark::State& state) {
+    push_without_reserve<small::string_vector<small::small_string>>(state, short_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, MemoryFootprint_StdString_VectorGrowthMixed)(benchmark::State& state) {
+    push_without_reserve<std::vector<std::string>>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, MemoryFootprint_SmallString_VectorGrowthMixed)(benchmark::State& state) {
+    push_without_reserve<std::vector<small::small_string>>(state, mixed_strings);
+}
+
+BENCHMARK_F(BenchmarkFixture, MemoryFootprint_SmallString_StringVectorGrowthMixed)(benchmark::State& state) {
+    push_without_reserve<small::string_vector<small::small_string>>(state, mixed_strings);
+}
+
 BENCHMARK_F(BenchmarkFixture, MemoryFootprint_StdString_MapMixed)(benchmark::State& state) {
     std::map<std::string, int> map;
     
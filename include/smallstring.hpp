@@ -14,9 +14,20 @@
 
 #pragma once
 #include <fmt/format.h>
+#if defined(__linux__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+#include <sys/mman.h>
 #include <sys/types.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <compare>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -26,10 +37,21 @@
 #include <limits>
 #include <memory>
 #include <memory_resource>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
 #include <stdexcept>
 #include <string_view>
+#include <thread>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(SMALL_STRING_NO_SIMD)
+#include <immintrin.h>
+#define SMALL_STRING_X86_SIMD
+#endif
 
 namespace small {
 #ifndef Assert
@@ -138,29 +160,147 @@ struct capacity_and_size
 
 static_assert(sizeof(capacity_and_size<uint32_t>) == 8);
 
+/**
+ * @brief Bytes between the inline chars and the metadata byte of an internal_core
+ * @tparam Padding Number of bytes, CoreBytes - 1 is not a multiple of every char size
+ */
+template <std::size_t Padding>
+struct internal_padding
+{
+    uint8_t bytes[Padding];  ///< Unused
+};
+
+template <>
+struct internal_padding<0>
+{};
+
+/**
+ * @brief Where the buffers of a core live and how the core stores their addresses
+ * @note The default keeps raw addresses in the core and takes the buffers from the C heap, offset_core swaps it for
+ * segment_memory so the cores hold offsets into a shared mapping instead.
+ */
+struct process_memory
+{
+    /// @brief Turns the value stored in a core into an address of this process
+    [[nodiscard, gnu::always_inline]] static constexpr auto to_address(int64_t stored) noexcept -> int64_t {
+        return stored;
+    }
+
+    /// @brief Turns an address of this process into the value stored in a core
+    [[nodiscard, gnu::always_inline]] static constexpr auto to_stored(int64_t address) noexcept -> int64_t {
+        return address;
+    }
+
+    [[nodiscard, gnu::always_inline]] static auto allocate(std::size_t size) noexcept -> void* {
+        return std::malloc(size);
+    }
+
+    [[nodiscard, gnu::always_inline]] static auto reallocate(void* block, std::size_t size) noexcept -> void* {
+        return std::realloc(block, size);
+    }
+
+    [[gnu::always_inline]] static auto deallocate(void* block) noexcept -> void { std::free(block); }
+
+    /// @brief Bytes usable in a block of size requested bytes, the requested size where malloc does not tell
+    [[nodiscard, gnu::always_inline]] static auto usable_size([[maybe_unused]] void* block, std::size_t size) noexcept
+      -> std::size_t {
+#if defined(__linux__)
+        return std::max(::malloc_usable_size(block), size);
+#elif defined(__APPLE__)
+        return std::max(::malloc_size(block), size);
+#else
+        return size;
+#endif
+    }
+};  // struct process_memory
+
 /**
  * the struct was wrapped all of status and data / ptr.
+ * @tparam CoreBytes Size of the whole core in bytes, 8 (malloc_core) or 16 (wide_core)
+ * @tparam SizeType Type of the capacity and size in the Median/Long header, uint64_t lifts the 4 GiB limit (huge_core)
+ * @tparam Memory Source of the buffers and encoding of their addresses, see process_memory
+ * @tparam BorrowsViews Whether a Long core may be a view of caller memory without a header, see borrowing_core
+ * @note The last byte always holds the 2-bit storage flag, so the Internal/Short/Median/Long encoding is shared by
+ * both sizes; only the length of the inline buffer changes.
  */
-template <typename Char, bool NullTerminated>
-struct malloc_core
+template <typename Char, bool NullTerminated, std::size_t CoreBytes, typename SizeType = std::uint32_t,
+          typename Memory = process_memory, bool BorrowsViews = false>
+struct basic_malloc_core
 {
-    using size_type = std::uint32_t;
+    static_assert(CoreBytes == 8 or CoreBytes == 16, "the core should be 8 or 16 bytes");
+    static_assert(std::is_same_v<SizeType, std::uint32_t> or std::is_same_v<SizeType, std::uint64_t>,
+                  "the header should hold 32 or 64 bits sizes");
+
+    using size_type = SizeType;
+    using memory = Memory;
     using use_std_allocator = std::true_type;
+    using use_short_pool = std::false_type;  ///< Short buffers come from std::malloc, see pooled_core
+    using share_buffers = std::false_type;   ///< Copies own their buffers, see shared_core
+    using arena_buffers = std::false_type;   ///< Strings release their buffers, see arena_core
+    /// Moving is a bitwise copy leaving an empty core behind, no state points back into the object
+    using trivially_relocatable = std::true_type;
+
+    /// Chars fitting in front of the metadata byte of the internal_core: 7 char, 3 char16_t or 1 char32_t in 8 bytes
+    constexpr static std::size_t kInternalChars = (CoreBytes - 1) / sizeof(Char);
 
     /**
-     * the internal_core will hold the data and the size, for sizeof(Char) == 1, and NullTerminated is true, the
-     * capacity = 6, or if NullTerminated is false, the capacity = 7 will be stored in the core, the buf_ptr ==
-     * c_str_ptr == data
-     *
-     * TODO: if want to support sizeof(Char) != 1, internal_core maybe to be deprecated.
+     * the internal_core will hold the data and the size, kInternalChars chars fit in front of the metadata byte, and
+     * NullTerminated takes one of them for the terminator, so the capacity = kInternalChars - 1, or kInternalChars if
+     * NullTerminated is false, the buf_ptr == c_str_ptr == data
+     * wide chars leave (CoreBytes - 1) % sizeof(Char) bytes of padding, so the flag stays in the last byte
      */
     struct internal_core
     {
-        Char data[7];               ///< Embedded character storage (6 chars + null term or 7 chars)
+        Char data[kInternalChars];  ///< Embedded storage (kInternalChars - 1 chars + null term or kInternalChars)
+        [[no_unique_address]] internal_padding<CoreBytes - 1 - kInternalChars * sizeof(Char)> padding;  ///< Unused
         uint8_t internal_size : 6;  ///< Current string length (0-63, but limited by data array)
         uint8_t flag : 2;           ///< Storage type flag: must be 00 for Internal storage
     };  // struct internal_core
-    static_assert(sizeof(internal_core) == 8);
+    static_assert(sizeof(internal_core) == CoreBytes);
+
+    /**
+     * @brief Compact storage for Short buffer metadata
+     * @note Used when total capacity ≤ 256 characters
+     * @note Fits capacity and size info in the last 16 bits of external_core
+     */
+    struct cap_and_size
+    {
+        uint8_t cap : 5;    ///< Encoded capacity: real_capacity = (cap + 1) * 8 (range: 8-256)
+        uint16_t size : 9;  ///< Current string size (max 256 characters)
+        uint8_t flag : 2;   ///< Storage type flag: must be 01 for Short storage
+    };
+
+    /**
+     * @brief Tracks available space in Median buffers
+     * @note Used when buffer capacity is between 256-16383 characters
+     * @note Capacity and size are stored in buffer header for these sizes
+     */
+    struct idle_cap
+    {
+        uint16_t idle_or_ignore : 14;  ///< Available unused capacity (max 16383 chars)
+        uint8_t flag : 2;              ///< Storage type flag: 10=Median, 11=Long
+    };
+
+    static_assert(sizeof(idle_cap) == 2);
+
+    /**
+     * @brief Returns pointer to start of allocated buffer
+     * @param c_str_ptr Address of the character data
+     * @param flag Storage type flag of the external core
+     * @return Pointer to buffer beginning (before any header data)
+     * @note For Short buffers: returns c_str_ptr directly
+     * @note For Median/Long: returns c_str_ptr minus header size
+     */
+    [[nodiscard, gnu::always_inline]] static auto buffer_ptr_of(int64_t c_str_ptr, uint8_t flag) noexcept -> Char* {
+        Assert(flag > 0, "the flag should be 01 / 10 / 11");
+        if (flag == 1) [[likely]] {
+            return reinterpret_cast<Char*>(c_str_ptr);
+        } else {
+            // the header is measured in bytes, not in chars
+            constexpr auto header_size = static_cast<int64_t>(sizeof(struct capacity_and_size<size_type>));
+            return reinterpret_cast<Char*>(c_str_ptr - header_size);
+        }
+    }
 
     /**
      * the external_core will hold a pointer to the buffer, if the buffer size is less than 4k, the capacity and size
@@ -169,36 +309,11 @@ struct malloc_core
      * the c_str_ptr point to the 8 bytes after the head, the c_str_ptr - 2 is the capacity, the c_str_ptr - 1 is the
      * size (char*)buf_ptr + 8 == c_str_ptr
      */
-    struct external_core
+    struct packed_external_core
     {
         /// Pointer to string data (48-bit addresses on modern 64-bit systems)
         int64_t c_str_ptr : 48;  ///< Address of character data (assumes little-endian)
 
-        /**
-         * @brief Compact storage for Short buffer metadata
-         * @note Used when total capacity ≤ 256 characters
-         * @note Fits capacity and size info in remaining 16 bits of external_core
-         */
-        struct cap_and_size
-        {
-            uint8_t cap : 5;    ///< Encoded capacity: real_capacity = (cap + 1) * 8 (range: 8-256)
-            uint16_t size : 9;  ///< Current string size (max 256 characters)
-            uint8_t flag : 2;   ///< Storage type flag: must be 01 for Short storage
-        };
-
-        /**
-         * @brief Tracks available space in Median buffers
-         * @note Used when buffer capacity is between 256-16383 characters
-         * @note Capacity and size are stored in buffer header for these sizes
-         */
-        struct idle_cap
-        {
-            uint16_t idle_or_ignore : 14;  ///< Available unused capacity (max 16383 chars)
-            uint8_t flag : 2;              ///< Storage type flag: 10=Median, 11=Long
-        };
-
-        static_assert(sizeof(idle_cap) == 2);
-
         /**
          * @brief Union providing different views of the 16-bit metadata field
          * @note Interpretation depends on storage type flag:
@@ -220,27 +335,81 @@ struct malloc_core
          * @note For Median/Long: returns c_str_ptr minus header size
          */
         [[nodiscard, gnu::always_inline]] auto get_buffer_ptr() const noexcept -> Char* {
-            Assert(idle.flag > 0, "the flag should be 01 / 10 / 11");
-            if (cap_size.flag == 1) [[likely]] {
-                return reinterpret_cast<Char*>(c_str_ptr);
-            } else {
-                return reinterpret_cast<Char*>(c_str_ptr) - sizeof(struct capacity_and_size<size_type>);
-            }
+            return buffer_ptr_of(Memory::to_address(c_str_ptr), idle.flag);
+        }
+
+        /// @brief Returns the address of the character data in this process
+        [[nodiscard, gnu::always_inline]] auto c_str() const noexcept -> Char* {
+            return reinterpret_cast<Char*>(Memory::to_address(c_str_ptr));
+        }
+    };  // struct packed_external_core
+
+    /**
+     * the 16 bytes layout of the external_core, the pointer takes the first 8 bytes, the metadata stays in the last 2
+     * bytes, so the flag overlaps internal_core's flag exactly like the 8 bytes layout.
+     * the bytes in between cache the size of Median/Long strings, so size() never reads the buffer header.
+     */
+    struct wide_external_core
+    {
+        int64_t c_str_ptr;             ///< Address of character data
+        uint32_t cached_size = 0;      ///< Size of Median/Long strings, a copy of the header's size
+        uint8_t view = 0;              ///< 1 if the Long text is a view without a header, see BorrowsViews
+        uint8_t reserved = 0;          ///< Unused, keeps the metadata in the last 2 bytes
+
+        /// Same views as packed_external_core's metadata
+        union
+        {
+            idle_cap idle;          ///< Idle capacity info for Median/Long storage
+            cap_and_size cap_size;  ///< Capacity/size info for Short storage
+            uint16_t mask;          ///< Raw metadata bits for atomic operations
+        };
+
+        /// @brief Returns pointer to start of allocated buffer, see packed_external_core::get_buffer_ptr
+        [[nodiscard, gnu::always_inline]] auto get_buffer_ptr() const noexcept -> Char* {
+            return buffer_ptr_of(Memory::to_address(c_str_ptr), idle.flag);
+        }
+
+        /// @brief Returns the address of the character data in this process
+        [[nodiscard, gnu::always_inline]] auto c_str() const noexcept -> Char* {
+            return reinterpret_cast<Char*>(Memory::to_address(c_str_ptr));
         }
-    };  // struct external_core
+    };  // struct wide_external_core
+
+    /// @brief Encodes an address of this process for the c_str_ptr of an external core
+    [[nodiscard, gnu::always_inline]] static auto stored_address_of(const void* address) noexcept -> int64_t {
+        return Memory::to_stored(reinterpret_cast<int64_t>(address));
+    }
+
+    using external_core = std::conditional_t<CoreBytes == 8, packed_external_core, wide_external_core>;
+    static_assert(sizeof(external_core) == CoreBytes);
+
+    /// Whether the core keeps the size of Median/Long strings itself, only the 16 bytes core with 32-bit sizes has room
+    constexpr static bool kCachesSize = CoreBytes == 16 and sizeof(size_type) == sizeof(uint32_t);
+
+    /// Whether a Long core may be a borrowed view, whose size only lives in the core
+    constexpr static bool kBorrowsViews = BorrowsViews;
+    static_assert(not kBorrowsViews or kCachesSize, "a view keeps its size in the core, only wide_core has room");
+
+    /// Raw 128-bit value of the 16 bytes core
+    struct wide_body
+    {
+        int64_t low;   ///< First 8 bytes
+        int64_t high;  ///< Last 8 bytes, holds the flag
+    };
+
+    using body_type = std::conditional_t<CoreBytes == 8, int64_t, wide_body>;
 
-    static_assert(sizeof(external_core) == 8);
     /**
-     * @brief Core storage union - exactly 8 bytes for efficient operations
+     * @brief Core storage union - exactly CoreBytes bytes for efficient operations
      * @note All views represent the same memory location
      * @note Storage type determined by flag bits in lower 2 positions
      */
     union
     {
-        int64_t body;            ///< Raw 64-bit value for atomic operations and fast copying
-        Char init_slice[8];      ///< Initialization helper: init[7]=0 makes empty string
-        internal_core internal;  ///< Small string storage (embedded data + metadata)
-        external_core external;  ///< Large string storage (pointer + metadata)
+        body_type body;              ///< Raw value for fast copying
+        Char init_slice[CoreBytes / sizeof(Char)];  ///< Initialization helper, zeroing it makes the empty string
+        internal_core internal;      ///< Small string storage (embedded data + metadata)
+        external_core external;      ///< Large string storage (pointer + metadata)
     };
 
     /**
@@ -250,20 +419,20 @@ struct malloc_core
      */
     consteval static inline auto internal_buffer_size() noexcept -> size_type {
         if constexpr (NullTerminated) {
-            return sizeof(internal_core) - 2;
+            return kInternalChars - 1;
         } else {
-            return sizeof(internal_core) - 1;
+            return kInternalChars;
         }
     }
 
     /**
      * @brief Calculates header size for median and long external buffers
-     * @return Size of metadata header in bytes
+     * @return Size of metadata header in bytes, null terminator included
      * @note Header stores capacity and size information
      */
     consteval static inline auto median_long_buffer_header_size() noexcept -> size_type {
         if constexpr (NullTerminated) {
-            return sizeof(struct capacity_and_size<size_type>) + 1;
+            return sizeof(struct capacity_and_size<size_type>) + sizeof(Char);
         } else {
             return sizeof(struct capacity_and_size<size_type>);
         }
@@ -275,11 +444,7 @@ struct malloc_core
      * @note Short buffers use compact header encoding
      */
     consteval static inline auto max_short_buffer_size() noexcept -> size_type {
-        if constexpr (NullTerminated) {
-            return 255;
-        } else {
-            return 256;
-        }
+        return short_capacity_of(256);
     }
 
     /**
@@ -298,7 +463,29 @@ struct malloc_core
      * @note Limited by size_type range minus header overhead
      */
     consteval static inline auto max_long_buffer_size() noexcept -> size_type {
-        return std::numeric_limits<size_type>::max() - median_long_buffer_header_size();
+        return (std::numeric_limits<size_type>::max() - median_long_buffer_header_size()) / sizeof(Char);
+    }
+
+    /**
+     * @brief Returns the capacity of a Short buffer
+     * @param buffer_size Buffer size in bytes
+     * @return Chars fitting the buffer, null terminator excluded
+     */
+    [[nodiscard, gnu::always_inline]] constexpr static auto short_capacity_of(size_type buffer_size) noexcept
+      -> size_type {
+        return buffer_size / static_cast<size_type>(sizeof(Char)) - (NullTerminated ? 1U : 0U);
+    }
+
+    /**
+     * @brief Returns the capacity of a Median/Long buffer
+     * @param buffer_size Buffer size in bytes, header included
+     * @return Chars fitting the buffer, header and null terminator excluded
+     */
+    [[nodiscard, gnu::always_inline]] constexpr static auto median_long_capacity_of(size_type buffer_size) noexcept
+      -> size_type {
+        return (buffer_size - static_cast<size_type>(sizeof(struct capacity_and_size<size_type>))) /
+                 static_cast<size_type>(sizeof(Char)) -
+               (NullTerminated ? 1U : 0U);
     }
 
     constexpr static uint8_t kInterCore = static_cast<uint8_t>(CoreType::Internal);
@@ -328,9 +515,29 @@ struct malloc_core
      */
     [[nodiscard, gnu::always_inline]] constexpr auto capacity_from_buffer_header() const noexcept -> size_type {
         Assert(external.idle.flag > 1, "the flag should be 10 / 11");
+        if constexpr (kBorrowsViews) {
+            // a view has no header, it fits its text exactly
+            if (is_view()) [[unlikely]] {
+                return external.cached_size * static_cast<size_type>(sizeof(Char)) + median_long_buffer_header_size();
+            }
+        }
         // the capacity is stored in the buffer header, the capacity is 4 bytes, and it will handle NullTerminated in
         // allocate_new_external_buffer's logic
-        return *(reinterpret_cast<size_type*>(external.c_str_ptr) - 2);
+        return *(reinterpret_cast<size_type*>(external.c_str()) - 2);
+    }
+
+    /**
+     * @brief Returns the size of the allocated external buffer
+     * @return Total bytes requested from the allocator, header and null termination included
+     * @note Only valid for Short, Median and Long buffer types
+     * @note Short size is decoded from cap_size.cap, Median/Long size is read from the buffer header
+     */
+    [[nodiscard, gnu::always_inline]] constexpr auto external_buffer_size() const noexcept -> size_type {
+        Assert(is_external(), "the flag should be 01 / 10 / 11");
+        if (external.idle.flag == kShortCore) [[likely]] {
+            return (external.cap_size.cap + 1U) * 8U;
+        }
+        return capacity_from_buffer_header();
     }
 
     /**
@@ -341,11 +548,7 @@ struct malloc_core
      * @note This is the actual usable space for string data
      */
     [[nodiscard, gnu::always_inline]] constexpr auto max_real_cap_from_buffer_header() const noexcept -> size_type {
-        if constexpr (NullTerminated) {
-            return capacity_from_buffer_header() - 1U - static_cast<size_type>(sizeof(struct capacity_and_size<size_type>));
-        } else {
-            return capacity_from_buffer_header() - static_cast<size_type>(sizeof(struct capacity_and_size<size_type>));
-        }
+        return median_long_capacity_of(capacity_from_buffer_header());
     }
 
     /**
@@ -356,7 +559,42 @@ struct malloc_core
      */
     [[nodiscard, gnu::always_inline]] constexpr auto size_from_buffer_header() const noexcept -> size_type {
         Assert(external.idle.flag > 1, "the flag should be 10 / 11");
-        return *(reinterpret_cast<size_type*>(external.c_str_ptr) - 1);
+        if constexpr (kBorrowsViews) {
+            if (is_view()) [[unlikely]] {
+                return external.cached_size;
+            }
+        }
+        return *(reinterpret_cast<size_type*>(external.c_str()) - 1);
+    }
+
+    /**
+     * @brief Checks whether the core is a borrowed view of caller memory, which has no buffer header
+     * @return Always false unless kBorrowsViews
+     */
+    [[nodiscard, gnu::always_inline]] constexpr auto is_view() const noexcept -> bool {
+        if constexpr (kBorrowsViews) {
+            return external.idle.flag == kLongCore and external.view != 0;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * @brief Builds the external core of a borrowed view
+     * @param text Caller memory, followed by a null terminator for null terminated strings
+     * @param size Length of the text in chars
+     * @return Long external core keeping the pointer and the size, no header is read or written
+     */
+    [[nodiscard]] static auto view_external_of(const Char* text, size_type size) noexcept -> external_core
+        requires(kBorrowsViews)
+    {
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wconversion"
+        external_core core{.c_str_ptr = stored_address_of(text), .idle = {.idle_or_ignore = 0, .flag = kLongCore}};
+        #pragma GCC diagnostic pop
+        core.cached_size = size;
+        core.view = 1;
+        return core;
     }
 
     /**
@@ -367,10 +605,11 @@ struct malloc_core
      */
     [[gnu::always_inline]] constexpr auto set_size_to_buffer_header(size_type new_size) const noexcept -> void {
         Assert(external.idle.flag > 1, "the flag should be 10 / 11");
+        Assert(not is_view(), "a view is copied before it is written");
         // check the new_size is less than the capacity
         Assert(capacity_from_buffer_header() > 256, "the capacity should be more than 256");
         Assert(new_size <= max_real_cap_from_buffer_header(), "the new size should be less than the capacity");
-        *(reinterpret_cast<size_type*>(external.c_str_ptr) - 1) = new_size;
+        *(reinterpret_cast<size_type*>(external.c_str()) - 1) = new_size;
     }
 
     /**
@@ -383,10 +622,11 @@ struct malloc_core
     [[nodiscard, gnu::always_inline]] constexpr auto increase_size_to_buffer_header(size_type size_to_increase) noexcept
       -> size_type {
         Assert(external.idle.flag > 1, "the flag should be 10 / 11");
+        Assert(not is_view(), "a view is copied before it is written");
         Assert(capacity_from_buffer_header() > 256, "the capacity should be no more than 32");
         // Capacity check is done by caller in increase_size_and_idle_and_set_term
         // check the new_size is less than the capacity
-        return *(reinterpret_cast<size_type*>(external.c_str_ptr) - 1) += size_to_increase;
+        return *(reinterpret_cast<size_type*>(external.c_str()) - 1) += size_to_increase;
     }
 
     /**
@@ -399,11 +639,21 @@ struct malloc_core
     [[nodiscard, gnu::always_inline]] constexpr auto decrease_size_to_buffer_header(
       size_type size_to_decrease) const noexcept -> size_type {
         Assert(external.idle.flag > 1, "the flag should be 10 / 11");
+        Assert(not is_view(), "a view is copied before it is written");
         // check the new_size is less than the capacity
         Assert(capacity_from_buffer_header() > 256, "the capacity should be more than 256");
         Assert(size_to_decrease <= size_from_buffer_header(),
                "the size to decrease should be less than the current size");
-        return *(reinterpret_cast<size_type*>(external.c_str_ptr) - 1) -= size_to_decrease;
+        return *(reinterpret_cast<size_type*>(external.c_str()) - 1) -= size_to_decrease;
+    }
+
+    /**
+     * @brief Checks the header of a Median/Long buffer, for the assertions of the read paths
+     * @return true if the buffer is larger than a Short one, or is a view, which fits its text exactly
+     * @note Views are never written in place, the write paths keep asserting the 256 bytes minimum
+     */
+    [[nodiscard]] constexpr auto is_sane_buffer_header() const noexcept -> bool {
+        return capacity_from_buffer_header() > 256 or is_view();
     }
 
     /**
@@ -414,10 +664,15 @@ struct malloc_core
     [[nodiscard, gnu::always_inline]] constexpr auto get_capacity_and_size_from_buffer_header() const noexcept
       -> capacity_and_size<size_type> {
         Assert(external.idle.flag > 1, "the flag should be 10 / 11");
-        Assert(capacity_from_buffer_header() > 256, "the capacity should be more than 256");
+        Assert(is_sane_buffer_header(), "the capacity should be more than 256");
         Assert(size_from_buffer_header() <= max_real_cap_from_buffer_header(),
                "the size should be less than the max real capacity");
-        return *(reinterpret_cast<capacity_and_size<size_type>*>(external.c_str_ptr) - 1);
+        if constexpr (kBorrowsViews) {
+            if (is_view()) [[unlikely]] {
+                return {.capacity = capacity_from_buffer_header(), .size = external.cached_size};
+            }
+        }
+        return *(reinterpret_cast<capacity_and_size<size_type>*>(external.c_str()) - 1);
     }
 
     /**
@@ -430,13 +685,9 @@ struct malloc_core
     [[nodiscard, gnu::always_inline]] constexpr auto get_idle_capacity_from_buffer_header() const noexcept
       -> size_type {
         Assert(external.idle.flag > 1, "the flag should be 10 / 11");
-        Assert(capacity_from_buffer_header() > 256, "the capacity should be more than 256");
+        Assert(is_sane_buffer_header(), "the capacity should be more than 256");
         auto [cap, size] = get_capacity_and_size_from_buffer_header();
-        if constexpr (NullTerminated) {
-            return cap - size - 1U - static_cast<size_type>(sizeof(struct capacity_and_size<size_type>));
-        } else {
-            return cap - size - static_cast<size_type>(sizeof(struct capacity_and_size<size_type>));
-        }
+        return median_long_capacity_of(cap) - size;
     }
 
     /**
@@ -457,11 +708,7 @@ struct malloc_core
                 case 1: {  // short
                     Assert(external.cap_size.cap <= 32, "the cap should be no more than 32");
                     Assert(external.cap_size.size <= 256, "the size should be no more than 256");
-                    if constexpr (NullTerminated) {
-                        return (external.cap_size.cap + 1U) * 8U - external.cap_size.size - 1U;
-                    } else {
-                        return (external.cap_size.cap + 1U) * 8U - external.cap_size.size;
-                    }
+                    return short_capacity_of((external.cap_size.cap + 1U) * 8U) - external.cap_size.size;
                 }
                 default:  // case 2: median - idle is cached in the core
                     return external.idle.idle_or_ignore;
@@ -489,18 +736,10 @@ struct malloc_core
                 return internal_buffer_size();
             }
             // Short storage
-            if constexpr (NullTerminated) {
-                return (external.cap_size.cap + 1U) * 8U - 1U;
-            } else {
-                return (external.cap_size.cap + 1U) * 8U;
-            }
+            return short_capacity_of((external.cap_size.cap + 1U) * 8U);
         }
         // Slow path: Median/Long require memory indirection
-        if constexpr (NullTerminated) {
-            return capacity_from_buffer_header() - 1U - static_cast<size_type>(sizeof(struct capacity_and_size<size_type>));
-        } else {
-            return capacity_from_buffer_header() - static_cast<size_type>(sizeof(struct capacity_and_size<size_type>));
-        }
+        return max_real_cap_from_buffer_header();
     }
 
     /**
@@ -509,7 +748,7 @@ struct malloc_core
      * @note Handles all storage types: Internal (0), Short (1), Median/Long (2+)
      * @note For internal storage: reads from internal_size field
      * @note For short storage: reads from cap_size.size field
-     * @note For median/long storage: reads from buffer header
+     * @note For median/long storage: reads from buffer header, or from the core if kCachesSize
      * @note Size excludes null termination character
      * @note Optimized with fast path for Internal/Short (direct field access)
      */
@@ -521,8 +760,54 @@ struct malloc_core
             // When flag==0: use internal_size, when flag==1: use cap_size.size
             return flag == 0 ? internal.internal_size : external.cap_size.size;
         }
-        // Slow path: Median/Long require memory indirection
-        return size_from_buffer_header();
+        return median_long_size();
+    }
+
+    /**
+     * @brief Gets the size of a Median/Long string
+     * @return The size cached in the core if kCachesSize, otherwise the size in the buffer header
+     */
+    [[nodiscard, gnu::always_inline]] constexpr auto median_long_size() const noexcept -> size_type {
+        Assert(external.idle.flag > 1, "the flag should be 10 / 11");
+        if constexpr (kCachesSize) {
+            Assert(external.cached_size == size_from_buffer_header(), "the cached size should match the buffer header");
+            return external.cached_size;
+        } else {
+            // Slow path: requires memory indirection
+            return size_from_buffer_header();
+        }
+    }
+
+    /**
+     * @brief Caches the size of a Median/Long string in an external core, does nothing unless kCachesSize
+     * @param core External core of a Median/Long buffer
+     * @param new_size Size written to the buffer header
+     */
+    [[gnu::always_inline]] constexpr static auto cache_size([[maybe_unused]] external_core& core,
+                                                            [[maybe_unused]] size_type new_size) noexcept -> void {
+        if constexpr (kCachesSize) {
+            core.cached_size = new_size;
+        }
+    }
+
+    /**
+     * @brief Builds the external core of a Median/Long buffer
+     * @param header Header of the buffer, capacity and size already written
+     * @param flag kMedianCore or kLongCore
+     * @return External core caching the idle capacity of Median buffers, and the size if kCachesSize
+     */
+    [[nodiscard]] static auto median_long_external_of(const capacity_and_size<size_type>* header,
+                                                      uint8_t flag) noexcept -> external_core {
+        Assert(flag > 1, "the flag should be 10 / 11");
+        // the idle capacity of a Long buffer doesn't fit the 14 bits, the Long idle_or_ignore stays 0
+        auto idle = flag == kMedianCore ? median_long_capacity_of(header->capacity) - header->size : 0;
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wconversion"
+        external_core core{.c_str_ptr = stored_address_of(header + 1),
+                           .idle = {.idle_or_ignore = static_cast<uint16_t>(idle), .flag = flag}};
+        #pragma GCC diagnostic pop
+        cache_size(core, header->size);
+        return core;
     }
 
     /**
@@ -546,36 +831,38 @@ struct malloc_core
                 internal.internal_size = static_cast<uint8_t>(new_size);
                 // set the terminator
                 if constexpr (NullTerminated) {
-                    Assert(internal.internal_size < 7, "internal size exceeds limit");
+                    Assert(internal.internal_size < kInternalChars, "internal size exceeds limit");
                     internal.data[internal.internal_size] = '\0';
                 }
                 break;
             }
             case 1: {
                 // Short buffer, the size is stored in the external_core
-                Assert(new_size <= (external.cap_size.cap + 1UL) * 8UL - (NullTerminated ? 1UL : 0UL),
+                Assert(new_size <= short_capacity_of((external.cap_size.cap + 1U) * 8U),
                        "the new size should be less than the max real capacity");
                 external.cap_size.size = static_cast<uint16_t>(new_size);
                 if constexpr (NullTerminated) {
-                    reinterpret_cast<Char*>(external.c_str_ptr)[new_size] = '\0';
+                    external.c_str()[new_size] = '\0';
                 }
                 break;
             }
             case 2: {
                 // Median buffer, the size is stored in the buffer header, the idle_or_ignore is the idle size
                 set_size_to_buffer_header(new_size);
+                cache_size(external, new_size);
                 external.idle.idle_or_ignore = static_cast<uint16_t>(get_idle_capacity_from_buffer_header());
                 if constexpr (NullTerminated) {
                     // set the terminator
-                    reinterpret_cast<Char*>(external.c_str_ptr)[new_size] = '\0';
+                    external.c_str()[new_size] = '\0';
                 }
                 break;
             }
             case 3: {
                 set_size_to_buffer_header(new_size);
+                cache_size(external, new_size);
                 if constexpr (NullTerminated) {
                     // set the terminator
-                    reinterpret_cast<Char*>(external.c_str_ptr)[new_size] = '\0';
+                    external.c_str()[new_size] = '\0';
                 }
             }
         }
@@ -606,23 +893,25 @@ struct malloc_core
                 Assert(size_to_increase <= idle_capacity(), "the size to increase should be less than the idle size");
                 external.cap_size.size += size_to_increase;
                 if constexpr (NullTerminated) {
-                    reinterpret_cast<Char*>(external.c_str_ptr)[external.cap_size.size] = '\0';
+                    external.c_str()[external.cap_size.size] = '\0';
                 }
                 break;
             case 2: {
                 Assert(size_to_increase <= idle_capacity(), "the size to increase should be less than the idle size");
                 external.idle.idle_or_ignore -= size_to_increase;
                 [[maybe_unused]] auto new_str_size = increase_size_to_buffer_header(size_to_increase);
+                cache_size(external, new_str_size);
                 if constexpr (NullTerminated) {
-                    reinterpret_cast<Char*>(external.c_str_ptr)[new_str_size] = '\0';
+                    external.c_str()[new_str_size] = '\0';
                 }
                 break;
             }
             case 3: {
                 Assert(size_to_increase <= idle_capacity(), "the size to increase should be less than the idle size");
                 [[maybe_unused]] auto new_str_size = increase_size_to_buffer_header(size_to_increase);
+                cache_size(external, new_str_size);
                 if constexpr (NullTerminated) {
-                    reinterpret_cast<Char*>(external.c_str_ptr)[new_str_size] = '\0';
+                    external.c_str()[new_str_size] = '\0';
                 }
                 break;
             }
@@ -654,7 +943,7 @@ struct malloc_core
                        "the size to decrease should be less than the current size");
                 external.cap_size.size -= size_to_decrease;
                 if constexpr (NullTerminated) {
-                    reinterpret_cast<Char*>(external.c_str_ptr)[external.cap_size.size] = '\0';
+                    external.c_str()[external.cap_size.size] = '\0';
                 }
                 break;
             case 2: {
@@ -662,8 +951,9 @@ struct malloc_core
                        "the size to decrease should be less than the current size");
                 external.idle.idle_or_ignore += size_to_decrease;
                 [[maybe_unused]] auto new_str_size = decrease_size_to_buffer_header(size_to_decrease);
+                cache_size(external, new_str_size);
                 if constexpr (NullTerminated) {
-                    reinterpret_cast<Char*>(external.c_str_ptr)[new_str_size] = '\0';
+                    external.c_str()[new_str_size] = '\0';
                 }
                 break;
             }
@@ -671,8 +961,9 @@ struct malloc_core
                 Assert(size_to_decrease <= size_from_buffer_header(),
                        "the size to decrease should be less than the idle size");
                 [[maybe_unused]] auto new_str_size = decrease_size_to_buffer_header(size_to_decrease);
+                cache_size(external, new_str_size);
                 if constexpr (NullTerminated) {
-                    reinterpret_cast<Char*>(external.c_str_ptr)[new_str_size] = '\0';
+                    external.c_str()[new_str_size] = '\0';
                 }
                 break;
             }
@@ -685,24 +976,12 @@ struct malloc_core
         switch (flag) {
             case 0:
                 return {.capacity = internal_buffer_size(), .size = internal.internal_size};
-            case 1: {
-                if constexpr (NullTerminated) {
-                    return {.capacity = static_cast<uint32_t>((external.cap_size.cap + 1) * 8UL) - 1,
-                            .size = external.cap_size.size};
-                } else {
-                    return {.capacity = static_cast<uint32_t>((external.cap_size.cap + 1) * 8UL),
-                            .size = external.cap_size.size};
-                }
-            }
+            case 1:
+                return {.capacity = short_capacity_of((external.cap_size.cap + 1U) * 8U),
+                        .size = external.cap_size.size};
             default: {
                 auto [cap, size] = get_capacity_and_size_from_buffer_header();
-                size_type real_cap;
-                if constexpr (NullTerminated) {
-                    real_cap = cap - 1U - static_cast<size_type>(sizeof(struct capacity_and_size<size_type>));
-                } else {
-                    real_cap = cap - static_cast<size_type>(sizeof(struct capacity_and_size<size_type>));
-                }
-                return {.capacity = real_cap, .size = size};
+                return {.capacity = median_long_capacity_of(cap), .size = size};
             }
         }
     }
@@ -719,20 +998,20 @@ struct malloc_core
         auto flag = internal.flag;
         // Branchless select: flag == 0 means internal, otherwise external
         uintptr_t int_addr = reinterpret_cast<uintptr_t>(internal.data);
-        uintptr_t ext_addr = reinterpret_cast<uintptr_t>(reinterpret_cast<Char*>(external.c_str_ptr));
+        uintptr_t ext_addr = reinterpret_cast<uintptr_t>(external.c_str());
         uintptr_t mask = -uintptr_t(flag == 0);  // All 1s if internal, all 0s if external
         return reinterpret_cast<Char*>((int_addr & mask) | (ext_addr & ~mask));
     }
 
-    [[nodiscard, gnu::always_inline]] inline auto get_string_view() const noexcept -> std::string_view {
+    [[nodiscard, gnu::always_inline]] inline auto get_string_view() const noexcept -> std::basic_string_view<Char> {
         auto flag = external.idle.flag;
         switch (flag) {
             case 0:
-                return std::string_view{internal.data, internal.internal_size};
+                return {internal.data, internal.internal_size};
             case 1:
-                return std::string_view{reinterpret_cast<Char*>(external.c_str_ptr), external.cap_size.size};
+                return {external.c_str(), external.cap_size.size};
             default:
-                return std::string_view{reinterpret_cast<Char*>(external.c_str_ptr), size_from_buffer_header()};
+                return {external.c_str(), median_long_size()};
         }
     }
 
@@ -748,12 +1027,12 @@ struct malloc_core
             case 0:
                 return {internal.data, &internal.data[internal.internal_size]};
             case 1: {
-                auto ptr = reinterpret_cast<Char*>(external.c_str_ptr);
+                auto ptr = external.c_str();
                 return {ptr, ptr + external.cap_size.size};
             }
             default: {
-                auto ptr = reinterpret_cast<Char*>(external.c_str_ptr);
-                return {ptr, ptr + size_from_buffer_header()};
+                auto ptr = external.c_str();
+                return {ptr, ptr + median_long_size()};
             }
         }
     }
@@ -771,19 +1050,19 @@ struct malloc_core
             case 0:
                 return &internal.data[internal.internal_size];
             case 1:
-                return reinterpret_cast<Char*>(external.c_str_ptr) + external.cap_size.size;
+                return external.c_str() + external.cap_size.size;
             default:
-                return reinterpret_cast<Char*>(external.c_str_ptr) + size_from_buffer_header();
+                return external.c_str() + median_long_size();
         }
     }
 
     /**
-     * @brief Efficiently swaps two malloc_core instances
+     * @brief Efficiently swaps two core instances
      * @param other The core to swap with
-     * @note Uses simple 64-bit value swap for maximum performance
+     * @note Uses simple raw value swap for maximum performance
      * @note Swaps all storage state atomically
      */
-    auto swap(malloc_core& other) noexcept -> void {
+    auto swap(basic_malloc_core& other) noexcept -> void {
         auto temp_body = other.body;
         other.body = body;
         body = temp_body;
@@ -797,26 +1076,52 @@ struct malloc_core
      * @note Initializes to empty string with internal storage
      */
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
-    constexpr malloc_core([[maybe_unused]] const std::allocator<Char>& unused = std::allocator<Char>{}) noexcept
-        : body{0} {}
+    constexpr basic_malloc_core([[maybe_unused]] const std::allocator<Char>& unused = std::allocator<Char>{}) noexcept
+        : body{} {}
 
     /// Copy constructor - copies entire storage state
-    constexpr malloc_core(const malloc_core& other) noexcept : body(other.body) {}
+    constexpr basic_malloc_core(const basic_malloc_core& other) noexcept : body(other.body) {}
 
     /// Allocator-extended copy constructor (allocator ignored)
-    constexpr malloc_core(const malloc_core& other, [[maybe_unused]] const std::allocator<Char>& unused) noexcept
+    constexpr basic_malloc_core(const basic_malloc_core& other,
+                                [[maybe_unused]] const std::allocator<Char>& unused) noexcept
         : body(other.body) {}
 
     /// Move constructor - transfers ownership and resets source to empty
-    constexpr malloc_core(malloc_core&& gone) noexcept : body{std::exchange(gone.body, 0)} {}
-    ~malloc_core() = default;
+    constexpr basic_malloc_core(basic_malloc_core&& gone) noexcept : body{std::exchange(gone.body, body_type{})} {}
+    ~basic_malloc_core() = default;
     /// Copy assignment deleted - cores should not be reassigned after construction
-    auto operator=(const malloc_core& other) -> malloc_core& = delete;
+    auto operator=(const basic_malloc_core& other) -> basic_malloc_core& = delete;
     /// Move assignment deleted - cores should not be reassigned after construction
-    auto operator=(malloc_core&& other) noexcept -> malloc_core& = delete;
-};  // struct malloc_core
+    auto operator=(basic_malloc_core&& other) noexcept -> basic_malloc_core& = delete;
+};  // struct basic_malloc_core
+
+/**
+ * @brief The default 8 bytes core, inlines up to 6 chars (7 without the terminator)
+ */
+template <typename Char, bool NullTerminated>
+using malloc_core = basic_malloc_core<Char, NullTerminated, 8>;
+
+/**
+ * @brief 16 bytes core, inlines up to 14 chars (15 without the terminator)
+ * @note Keeps the Short/Median/Long external encoding of malloc_core, only the Internal tier grows, so 8-15 bytes keys
+ * don't need a heap allocation at the cost of a doubled object size
+ * @note The spare external bytes cache the size of Median/Long strings, size() and end() don't touch the buffer
+ */
+template <typename Char, bool NullTerminated>
+using wide_core = basic_malloc_core<Char, NullTerminated, 16>;
+
+/**
+ * @brief 8 bytes core with 64-bit capacity and size in the Median/Long header, for strings beyond 4 GiB
+ * @note Internal and Short are the same as malloc_core's, Median and Long share the 16 bytes header so a Median
+ * buffer still grows into a Long one with realloc
+ */
+template <typename Char, bool NullTerminated>
+using huge_core = basic_malloc_core<Char, NullTerminated, 8, std::uint64_t>;
 
 static_assert(sizeof(malloc_core<char, true>) == 8, "malloc_core should be same as a pointer");
+static_assert(sizeof(wide_core<char, true>) == 16, "wide_core should be same as two pointers");
+static_assert(sizeof(huge_core<char, true>) == 8, "huge_core should be same as a pointer");
 
 /**
  * @brief PMR-enabled core extending malloc_core with polymorphic allocation
@@ -878,88 +1183,2765 @@ struct pmr_core : public malloc_core<Char, NullTerminated>
 };  // struct malloc_core_and_pmr_allocator
 
 /**
- * @brief Buffer management class handling memory allocation for small string optimization
- * @tparam Char Character type (char, wchar_t, etc.)
- * @tparam Core Core storage type (malloc_core or pmr_core)
- * @tparam Traits Character traits (std::char_traits)
- * @tparam Allocator Allocator type for memory management
- * @tparam NullTerminated Whether strings maintain null termination
- * @tparam Growth Growth factor for buffer reallocation (default 1.5)
- * @note Manages all memory operations and storage strategy transitions
- * @note Provides interface between string operations and core storage
+ * @brief pmr_core variant for arena resources, the strings never release their buffers
+ * @tparam Char Character type
+ * @tparam NullTerminated Whether strings are null-terminated
+ * @note The resource must reclaim its memory at once, like std::pmr::monotonic_buffer_resource::release(), its
+ * deallocate is never called: buffers left behind by growth stay in the arena until then
+ * @note The destructor of the strings is trivial, so destroying a container of them doesn't walk the elements
  */
-template <typename Char, template <typename, bool> typename Core, class Traits, class Allocator, bool NullTerminated,
-          float Growth = 1.5F>
-class small_string_buffer
+template <typename Char, bool NullTerminated>
+struct arena_core : public pmr_core<Char, NullTerminated>
 {
-   protected:
-    /// Standard STL container type definitions for compatibility
-    using value_type = typename Traits::char_type;  ///< Character type from traits
-    using traits_type = Traits;                     ///< Character traits for operations
-    using allocator_type = Allocator;               ///< Memory allocator type
-    using size_type = std::uint32_t;                ///< Size/index type (32-bit for efficiency)
-    using difference_type = typename std::allocator_traits<Allocator>::difference_type;  ///< Iterator difference type
+    using arena_buffers = std::true_type;  ///< Type trait: buffers belong to the arena, not to the strings
+    using pmr_core<Char, NullTerminated>::pmr_core;
+};
 
-    /// Reference types for element access
-    using reference = typename std::allocator_traits<Allocator>::value_type&;              ///< Mutable reference
-    using const_reference = const typename std::allocator_traits<Allocator>::value_type&;  ///< Immutable reference
-    using pointer = typename std::allocator_traits<Allocator>::pointer;                    ///< Mutable pointer
-    using const_pointer = const typename std::allocator_traits<Allocator>::const_pointer;  ///< Immutable pointer
+static_assert(std::is_trivially_destructible_v<arena_core<char, true>>, "arena_core should be trivially destructible");
 
-    /// Iterator types for STL compatibility
-    using iterator = Char*;                                                ///< Mutable iterator (raw pointer)
-    using const_iterator = const Char*;                                    ///< Immutable iterator (raw pointer)
-    using reverse_iterator = std::reverse_iterator<iterator>;              ///< Reverse mutable iterator
-    using const_reverse_iterator = std::reverse_iterator<const_iterator>;  ///< Reverse immutable iterator
+/**
+ * @brief Per-thread size-class freelists serving the Short tier buffers
+ * @note Short buffers come in exactly 32 size classes, (cap + 1) * 8 bytes, every class owns an intrusive freelist
+ * @note Blocks are carved from slabs aligned to their own size, the slab header records the owner thread cache, so a
+ * block freed by another thread is pushed onto the owner's lock-free remote list and drained by the owner on refill
+ * @note The cache of an exited thread is abandoned and adopted by the next new thread, slabs are never returned
+ * @note A thread without a cache, past its cache_guard (a thread_local destructor allocating) or out of memory for
+ * one, borrows an abandoned cache under the lock for each block, so no cache is ever left unowned and unlisted
+ */
+class short_buffer_pool
+{
+   public:
+    constexpr static std::size_t kSizeClasses = 32;          ///< Number of Short buffer classes (8 to 256 bytes)
+    constexpr static std::size_t kClassGranularity = 8;      ///< Size step between two classes
+    constexpr static std::size_t kSlabSize = 64UL * 1024UL;  ///< Slab size, slabs are aligned to it as well
 
-    /// Standard "not found" position marker (maximum size_type value)
-    constexpr static size_t npos = std::numeric_limits<size_type>::max();
+    /**
+     * @brief Allocates a Short buffer from the calling thread's freelist
+     * @param buffer_size Buffer size, a multiple of 8 in [8, 256]
+     * @return Pointer to the block, nullptr if a new slab can't be allocated
+     */
+    [[nodiscard, gnu::always_inline]] static auto allocate(std::size_t buffer_size) noexcept -> void* {
+        auto size_class = size_class_of(buffer_size);
+        auto* cache = local_cache();
+        if (cache == nullptr) [[unlikely]] {
+            return allocate_detached(size_class, buffer_size);
+        }
+        if (auto* block = cache->free_list[size_class]; block != nullptr) [[likely]] {
+            cache->free_list[size_class] = block->next;
+            return block;
+        }
+        return cache->refill(size_class, buffer_size);
+    }
 
-    using core_type = Core<Char, NullTerminated>;  ///< Storage core (malloc_core or pmr_core)
+    /**
+     * @brief Returns a Short buffer to its size class
+     * @param ptr Block returned by allocate
+     * @param buffer_size Same size as passed to allocate
+     * @note Blocks of other threads go back to the owner's remote list
+     */
+    [[gnu::always_inline]] static auto deallocate(void* ptr, std::size_t buffer_size) noexcept -> void {
+        auto size_class = size_class_of(buffer_size);
+        auto* block = static_cast<free_block*>(ptr);
+        auto* owner = slab_of(ptr)->owner;
+        if (owner == t_cache) [[likely]] {
+            block->next = owner->free_list[size_class];
+            owner->free_list[size_class] = block;
+            return;
+        }
+        auto& remote = owner->remote_free[size_class];
+        block->next = remote.load(std::memory_order_relaxed);
+        while (not remote.compare_exchange_weak(block->next, block, std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+        }
+    }
 
     /**
-     * @brief Enum indicating whether null termination is required
-     * @note Used to optimize operations when null termination isn't needed
+     * @brief Number of slabs allocated by all threads so far
+     * @return Slab count, every slab is one system allocation
      */
-    enum class Need0 : bool
+    [[nodiscard]] static auto slab_count() noexcept -> std::size_t { return slab_counter.load(std::memory_order_relaxed); }
+
+   private:
+    /// Intrusive freelist node, lives in the free block itself
+    struct free_block
     {
-        Yes = true,  ///< Null termination required
-        No = false   ///< Null termination not needed
+        free_block* next;  ///< Next free block of the same class
     };
 
-   private:
-    core_type _core;  ///< The actual storage core containing all string data and metadata
+    struct thread_cache;
 
-    /**
-     * @brief Validates that the allocator is properly initialized
-     * @return true if allocator is valid, false otherwise
-     * @note For standard allocators always returns true, for PMR checks initialization
+    /// Header at the beginning of every slab
+    struct alignas(16) slab_header
+    {
+        thread_cache* owner;  ///< Cache which carved the slab, never changes
+    };
+
+    /// Freelists of one thread, only the remote lists are touched by other threads
+    struct thread_cache
+    {
+        free_block* free_list[kSizeClasses] = {};                 ///< Local freelists, owner only
+        std::atomic<free_block*> remote_free[kSizeClasses] = {};  ///< Blocks freed by other threads
+        char* bump = nullptr;                                     ///< Next unused byte of the current slab
+        char* bump_end = nullptr;                                 ///< End of the current slab
+        thread_cache* next_abandoned = nullptr;                   ///< Link in the abandoned list
+
+        /**
+         * @brief Refills an empty class, from the remote list first, then from the current or a new slab
+         * @param size_class Class index of the request
+         * @param buffer_size Block size of the class
+         * @return One block, the rest of a drained remote list becomes the local freelist
+         */
+        [[gnu::noinline]] auto refill(std::size_t size_class, std::size_t buffer_size) noexcept -> void* {
+            if (auto* list = remote_free[size_class].exchange(nullptr, std::memory_order_acquire); list != nullptr) {
+                free_list[size_class] = list->next;
+                return list;
+            }
+            if (static_cast<std::size_t>(bump_end - bump) < buffer_size) [[unlikely]] {
+                auto* slab = static_cast<slab_header*>(std::aligned_alloc(kSlabSize, kSlabSize));
+                if (slab == nullptr) [[unlikely]] {
+                    return nullptr;
+                }
+                slab->owner = this;
+                slab_counter.fetch_add(1, std::memory_order_relaxed);
+                bump = reinterpret_cast<char*>(slab + 1);
+                bump_end = reinterpret_cast<char*>(slab) + kSlabSize;
+            }
+            auto* block = bump;
+            bump += buffer_size;
+            return block;
+        }
+    };
+
+    /// Hands the cache over to the abandoned list when its thread exits
+    struct cache_guard
+    {
+        ~cache_guard() {
+            t_exited = true;
+            if (t_cache == nullptr) {
+                return;
+            }
+            std::lock_guard lock(abandoned_mutex);
+            t_cache->next_abandoned = abandoned_head;
+            abandoned_head = t_cache;
+            t_cache = nullptr;
+        }
+    };
+
+    static inline thread_local thread_cache* t_cache = nullptr;  ///< Cache of the calling thread
+    static inline thread_local bool t_exited = false;            ///< Whether the cache_guard of the thread is gone
+    static inline std::mutex abandoned_mutex;                    ///< Guards abandoned_head
+    static inline thread_cache* abandoned_head = nullptr;        ///< Caches of exited threads
+    static inline std::atomic<std::size_t> slab_counter = 0;     ///< Slabs allocated so far
+
+    [[nodiscard, gnu::always_inline]] static auto size_class_of(std::size_t buffer_size) noexcept -> std::size_t {
+        Assert(buffer_size % kClassGranularity == 0 and buffer_size >= kClassGranularity and
+                 buffer_size <= kSizeClasses * kClassGranularity,
+               "the buffer size should be one of the Short classes");
+        return buffer_size / kClassGranularity - 1;
+    }
+
+    [[nodiscard, gnu::always_inline]] static auto slab_of(void* ptr) noexcept -> slab_header* {
+        return reinterpret_cast<slab_header*>(reinterpret_cast<uintptr_t>(ptr) & ~(kSlabSize - 1));
+    }
+
+    [[nodiscard, gnu::always_inline]] static auto local_cache() noexcept -> thread_cache* {
+        if (t_cache != nullptr) [[likely]] {
+            return t_cache;
+        }
+        return attach_cache();
+    }
+
+    /// Adopts an abandoned cache or creates a new one for the calling thread, nullptr once the thread is exiting
+    [[gnu::noinline]] static auto attach_cache() noexcept -> thread_cache* {
+        if (t_exited) [[unlikely]] {
+            // a cache attached now would never be handed back
+            return nullptr;
+        }
+        thread_local cache_guard guard;
+        {
+            std::lock_guard lock(abandoned_mutex);
+            if (abandoned_head != nullptr) {
+                t_cache = abandoned_head;
+                abandoned_head = abandoned_head->next_abandoned;
+                return t_cache;
+            }
+        }
+        t_cache = new (std::nothrow) thread_cache{};
+        return t_cache;
+    }
+
+    /// Allocates one block from a cache borrowed off the abandoned list, for the threads without a cache
+    [[gnu::noinline]] static auto allocate_detached(std::size_t size_class, std::size_t buffer_size) noexcept
+      -> void* {
+        std::lock_guard lock(abandoned_mutex);
+        auto* cache = abandoned_head;
+        if (cache == nullptr) {
+            cache = new (std::nothrow) thread_cache{};
+            if (cache == nullptr) [[unlikely]] {
+                return nullptr;
+            }
+        } else {
+            abandoned_head = cache->next_abandoned;
+        }
+        void* block = cache->free_list[size_class];
+        if (block != nullptr) {
+            cache->free_list[size_class] = cache->free_list[size_class]->next;
+        } else {
+            block = cache->refill(size_class, buffer_size);
+        }
+        cache->next_abandoned = abandoned_head;
+        abandoned_head = cache;
+        return block;
+    }
+};  // class short_buffer_pool
+
+/**
+ * @brief malloc_core variant serving the Short tier from short_buffer_pool
+ * @tparam Char Character type
+ * @tparam NullTerminated Whether strings are null-terminated
+ * @note Same 8 bytes layout as malloc_core, Median/Long buffers still use std::malloc
+ * @note Strings may be destroyed on any thread, the block returns to the thread which allocated it
+ */
+template <typename Char, bool NullTerminated>
+struct pooled_core : public basic_malloc_core<Char, NullTerminated, 8>
+{
+    using use_short_pool = std::true_type;  ///< Type trait: Short buffers come from short_buffer_pool
+    using basic_malloc_core<Char, NullTerminated, 8>::basic_malloc_core;
+};
+
+static_assert(sizeof(pooled_core<char, true>) == 8, "pooled_core should be same as a pointer");
+
+/**
+ * @brief malloc_core variant sharing Median/Long buffers between copies, copy-on-write
+ * @tparam Char Character type
+ * @tparam NullTerminated Whether strings are null-terminated
+ * @note A Median/Long buffer carries an atomic reference count in the 8 bytes in front of capacity_and_size, a copy
+ * only bumps it, the first mutation of a shared buffer copies it
+ * @note Short buffers are small enough to be copied, they are never shared
+ * @note Once the non-const data(), operator[], at, front, back, begin or end hand out a pointer, the buffer is
+ * unshareable until it is reallocated, later copies copy it so writes through the pointer do not show in them
+ * @note Like std::shared_ptr, copies of one string may live on different threads, one string object may not
+ */
+template <typename Char, bool NullTerminated>
+struct shared_core : public basic_malloc_core<Char, NullTerminated, 8>
+{
+    using share_buffers = std::true_type;  ///< Type trait: Median/Long buffers are shared between copies
+    using basic_malloc_core<Char, NullTerminated, 8>::basic_malloc_core;
+};
+
+static_assert(sizeof(shared_core<char, true>) == 8, "shared_core should be same as a pointer");
+
+/**
+ * @brief A string literal kept with its length at compile time, strings of a borrowing core wrap it as a view with zero
+ * allocation, see borrowing_core
+ * @tparam Char Character type
+ * @tparam N Length of the literal, null terminator included
+ * @example
+ *   static constexpr small::static_text kGreeting{"hello, borrowed world"};
+ *   small::borrowing_small_string greeting{kGreeting};  // no allocation, no copy until the first write
+ */
+template <typename Char, std::size_t N>
+struct static_text
+{
+    static_assert(N >= 1 and N - 1 <= std::numeric_limits<uint32_t>::max(), "the literal should fit a Long buffer");
+
+    Char text[N];  ///< The literal, null terminator included
+
+    consteval static_text(const Char (&literal)[N]) noexcept : text{} {
+        for (std::size_t i = 0; i < N; ++i) {
+            text[i] = literal[i];
+        }
+    }
+};
+
+/**
+ * @brief wide_core variant sharing Median/Long buffers like shared_core, which also wraps caller memory as a view
+ * @tparam Char Character type
+ * @tparam NullTerminated Whether strings are null-terminated
+ * @note A view keeps the pointer and the size in the 16 bytes of the core, so any (pointer, size) is wrapped with
+ * zero allocation: a string_view that owns its first mutation, a static_text is wrapped the same way
+ * @note A view is a Long core marked in the spare byte of wide_external_core, its capacity is its size, copies copy
+ * the core, and the first mutation copies the text into an owned buffer. The memory must outlive the string and its
+ * copies, and for null terminated strings a null terminator must follow the text
+ * @example
+ *   small::borrowing_small_byte_string field(small::borrow, line.data() + offset, length);  // no allocation
+ */
+template <typename Char, bool NullTerminated>
+struct borrowing_core : public basic_malloc_core<Char, NullTerminated, 16, std::uint32_t, process_memory, true>
+{
+    using share_buffers = std::true_type;  ///< Type trait: Median/Long buffers are shared between copies
+    using basic_malloc_core<Char, NullTerminated, 16, std::uint32_t, process_memory, true>::basic_malloc_core;
+};
+
+static_assert(sizeof(borrowing_core<char, true>) == 16, "borrowing_core should be same as two pointers");
+
+/// Tag of the constructors wrapping caller memory as a view, see borrowing_core
+struct borrow_t
+{
+    explicit borrow_t() = default;
+};
+
+/// Selects the borrowing constructors: small::borrowing_small_string str(small::borrow, data, size)
+inline constexpr borrow_t borrow{};
+
+/**
+ * @brief A heap laid out inside one shared memory region, for strings mapped by several processes
+ * @note The segment header sits at the start of the region and every position kept in the region is an offset from
+ * that start, the c_str_ptr of offset_core strings included, so other processes may map the region at any address,
+ * read-only as well
+ * @note A process registers the segments it maps under their id, which offset_core keeps next to the offset, so up to
+ * kMaxSegments segments can be mapped at once
+ * @note Blocks are powers of two from 16 bytes with their size class in an 8 bytes header, freed blocks go to one
+ * freelist per class. The freelists and the bump offset are guarded by a spin lock inside the region, so the
+ * processes mapping it read-write may allocate at the same time
+ * @example
+ *   auto* segment = small::shared_segment::create(region, region_size, 1);
+ *   small::shared_segment::scope scope(segment);  // offset_core strings of this thread allocate from segment
+ *   auto* name = new (segment->allocate(sizeof(small::offset_small_string))) small::offset_small_string("shared");
+ *   segment->set_root(name);  // consumers find it with attach(region)->root()
+ */
+class shared_segment
+{
+   public:
+    constexpr static std::size_t kMaxSegments = 128;                        ///< Segments one process may register
+    constexpr static int kOffsetBits = 40;                                  ///< Bits of an offset, the id is above them
+    constexpr static std::size_t kMaxSize = std::size_t{1} << kOffsetBits;  ///< Largest region, 1 TiB
+    constexpr static std::size_t kMinBlock = 16;                            ///< Smallest block, header included
+
+    /**
+     * @brief Lays out an empty segment at the start of a region and registers it in this process
+     * @param region Start of a writable region, aligned to 16 bytes
+     * @param size Bytes of the region
+     * @param id Id of the segment, below kMaxSegments and unused in every process mapping the region
+     * @return The segment, nullptr if the region is too small or too large, or the id is taken
+     */
+    [[nodiscard]] static auto create(void* region, std::size_t size, uint32_t id) noexcept -> shared_segment* {
+        if (region == nullptr or reinterpret_cast<uintptr_t>(region) % kMinBlock != 0 or
+            size < first_block() + kMinBlock or size > kMaxSize or id >= kMaxSegments) [[unlikely]] {
+            return nullptr;
+        }
+        auto expected = int64_t{0};
+        if (not bases[id].compare_exchange_strong(expected, reinterpret_cast<int64_t>(region),
+                                                  std::memory_order_acq_rel)) [[unlikely]] {
+            return nullptr;
+        }
+        return ::new (region) shared_segment(size, id);
+    }
+
+    /**
+     * @brief Registers a segment laid out by create, usually by another process
+     * @param region Start of the mapped region, may be read-only
+     * @return The segment, nullptr if the region holds no segment or its id is taken by another region
+     * @note Writes nothing to the region
+     */
+    [[nodiscard]] static auto attach(void* region) noexcept -> shared_segment* {
+        auto* segment = std::launder(static_cast<shared_segment*>(region));
+        if (segment == nullptr or segment->magic != kMagic or segment->id >= kMaxSegments) [[unlikely]] {
+            return nullptr;
+        }
+        auto expected = int64_t{0};
+        if (not bases[segment->id].compare_exchange_strong(expected, reinterpret_cast<int64_t>(region),
+                                                           std::memory_order_acq_rel) and
+            expected != reinterpret_cast<int64_t>(region)) [[unlikely]] {
+            return nullptr;
+        }
+        return segment;
+    }
+
+    /**
+     * @brief Forgets the segment of an id in this process, before its region is unmapped
+     * @note The region is left as is, the strings inside it stay valid for the processes still mapping it
+     */
+    static auto detach(uint32_t id) noexcept -> void {
+        Assert(id < kMaxSegments, "the id should be below kMaxSegments");
+        bases[id].store(0, std::memory_order_release);
+    }
+
+    /// @brief The segment registered under an id in this process, nullptr if none
+    [[nodiscard]] static auto from_id(uint32_t id) noexcept -> shared_segment* {
+        Assert(id < kMaxSegments, "the id should be below kMaxSegments");
+        return reinterpret_cast<shared_segment*>(bases[id].load(std::memory_order_acquire));
+    }
+
+    /// @brief The registered segment whose region contains an address, nullptr if none
+    [[nodiscard]] static auto containing(const void* address) noexcept -> shared_segment* {
+        if (t_current != nullptr and t_current->contains(address)) [[likely]] {
+            return t_current;
+        }
+        for (auto& base : bases) {
+            auto* segment = reinterpret_cast<shared_segment*>(base.load(std::memory_order_acquire));
+            if (segment != nullptr and segment->contains(address)) {
+                return segment;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Turns an offset_core c_str_ptr into an address of this process
+     * @note Branch free, any bits give some address, the Internal tier reads the pointer of its chars too
+     */
+    [[nodiscard, gnu::always_inline]] static auto address_of(int64_t stored) noexcept -> int64_t {
+        auto bits = static_cast<uint64_t>(stored);
+        return bases[(bits >> kOffsetBits) & (kMaxSegments - 1)].load(std::memory_order_relaxed) +
+               static_cast<int64_t>(bits & (kMaxSize - 1));
+    }
+
+    /// @brief Turns an address inside a registered segment into an offset_core c_str_ptr
+    [[nodiscard]] static auto stored_of(int64_t address) noexcept -> int64_t {
+        auto* segment = containing(reinterpret_cast<const void*>(address));
+        Assert(segment != nullptr, "offset_core buffers should live in a registered shared_segment");
+        if (segment == nullptr) [[unlikely]] {
+            return 0;
+        }
+        return static_cast<int64_t>(uint64_t{segment->id} << kOffsetBits) |
+               (address - reinterpret_cast<int64_t>(segment));
+    }
+
+    /**
+     * @brief Makes a segment the one the offset_core strings of this thread allocate from
+     * @note Scopes nest, the previous segment is restored on destruction
+     */
+    class scope
+    {
+       public:
+        explicit scope(shared_segment* segment) noexcept : previous(std::exchange(t_current, segment)) {}
+        ~scope() { t_current = previous; }
+        scope(const scope&) = delete;
+        auto operator=(const scope&) -> scope& = delete;
+
+       private:
+        shared_segment* previous;  ///< Segment of the enclosing scope
+    };
+
+    /// @brief The segment of the innermost scope of this thread, nullptr outside every scope
+    [[nodiscard, gnu::always_inline]] static auto current() noexcept -> shared_segment* { return t_current; }
+
+    /**
+     * @brief Allocates a block
+     * @param bytes Usable bytes wanted
+     * @return Pointer to the block, aligned to 8 bytes, nullptr if the region is exhausted
+     */
+    [[nodiscard]] auto allocate(std::size_t bytes) noexcept -> void* {
+        if (bytes > kMaxSize - kBlockHeader) [[unlikely]] {
+            return nullptr;
+        }
+        auto size_class = class_of(bytes);
+        uint64_t offset = 0;
+        {
+            std::lock_guard guard(lock);
+            if (free_lists[size_class] != 0) {
+                offset = free_lists[size_class];
+                free_lists[size_class] = *reinterpret_cast<uint64_t*>(base() + offset + kBlockHeader);
+            } else if (auto block_size = kMinBlock << size_class; block_size <= size - bump) [[likely]] {
+                offset = bump;
+                bump += block_size;
+            } else {
+                return nullptr;
+            }
+        }
+        *reinterpret_cast<uint64_t*>(base() + offset) = size_class;
+        return base() + offset + kBlockHeader;
+    }
+
+    /// @brief Returns a block of this segment to its freelist, nullptr is ignored
+    auto deallocate(void* block) noexcept -> void {
+        if (block == nullptr) {
+            return;
+        }
+        Assert(contains(block), "the block should belong to the segment");
+        auto* head = static_cast<char*>(block) - kBlockHeader;
+        auto size_class = *reinterpret_cast<uint64_t*>(head);
+        std::lock_guard guard(lock);
+        *static_cast<uint64_t*>(block) = free_lists[size_class];
+        free_lists[size_class] = static_cast<uint64_t>(head - base());
+    }
+
+    /**
+     * @brief Resizes a block, keeping its content
+     * @return The block itself if it is large enough already, a new block otherwise, nullptr if the region is
+     * exhausted (block is still valid then)
+     */
+    [[nodiscard]] auto reallocate(void* block, std::size_t bytes) noexcept -> void* {
+        auto usable = usable_size(block);
+        if (usable >= bytes) {
+            return block;
+        }
+        auto* grown = allocate(bytes);
+        if (grown != nullptr) [[likely]] {
+            std::memcpy(grown, block, usable);
+            deallocate(block);
+        }
+        return grown;
+    }
+
+    /// @brief Usable bytes of a block of any segment, at least the size it was allocated with
+    [[nodiscard, gnu::always_inline]] static auto usable_size(void* block) noexcept -> std::size_t {
+        auto size_class = *reinterpret_cast<const uint64_t*>(static_cast<const char*>(block) - kBlockHeader);
+        return (kMinBlock << size_class) - kBlockHeader;
+    }
+
+    /// @brief Remembers an object inside the segment for the processes attaching it
+    auto set_root(const void* object) noexcept -> void {
+        Assert(contains(object), "the root should live in the segment");
+        root_offset = static_cast<uint64_t>(static_cast<const char*>(object) - base());
+    }
+
+    /// @brief The object passed to set_root, nullptr if none was
+    [[nodiscard]] auto root() const noexcept -> const void* {
+        return root_offset == 0 ? nullptr : base() + root_offset;
+    }
+
+    /// @brief Whether an address lies inside the region of the segment
+    [[nodiscard, gnu::always_inline]] auto contains(const void* address) const noexcept -> bool {
+        auto offset = reinterpret_cast<uintptr_t>(address) - reinterpret_cast<uintptr_t>(this);
+        return offset < size;
+    }
+
+    /// @brief Id the segment was created with
+    [[nodiscard]] auto segment_id() const noexcept -> uint32_t { return id; }
+
+    /// @brief Bytes of the region
+    [[nodiscard]] auto region_size() const noexcept -> std::size_t { return size; }
+
+    /// @brief Bytes carved from the region so far, freed blocks included
+    [[nodiscard]] auto used_size() const noexcept -> std::size_t { return bump; }
+
+    shared_segment(const shared_segment&) = delete;
+    auto operator=(const shared_segment&) -> shared_segment& = delete;
+
+   private:
+    constexpr static uint64_t kMagic = 0x746e656d67657373ULL;     ///< "ssegment", marks a region laid out by create
+    constexpr static std::size_t kBlockHeader = 8;                ///< Size class in front of every block
+    constexpr static std::size_t kSizeClasses = kOffsetBits - 3;  ///< 16 bytes to kMaxSize
+
+    /// Test-and-set lock living in the region, address-free so it works across processes
+    struct spin_lock
+    {
+        std::atomic<uint32_t> locked = 0;  ///< 1 while a process holds the lock
+
+        auto lock() noexcept -> void {
+            while (locked.exchange(1, std::memory_order_acquire) != 0) {
+                while (locked.load(std::memory_order_relaxed) != 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        auto unlock() noexcept -> void { locked.store(0, std::memory_order_release); }
+    };
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "the lock is shared by processes");
+
+    uint64_t magic = kMagic;                 ///< kMagic once the segment is laid out
+    uint32_t id;                             ///< Id stored next to the offsets of offset_core strings
+    spin_lock lock;                          ///< Guards bump and free_lists
+    uint64_t size;                           ///< Bytes of the region
+    uint64_t bump;                           ///< Offset of the first never allocated byte
+    uint64_t root_offset = 0;                ///< Offset of the root object, 0 if none
+    uint64_t free_lists[kSizeClasses] = {};  ///< Offset of the first free block of each class, 0 if none
+
+    /// Region of the registered segments in this process, by id, 0 if none
+    static inline std::atomic<int64_t> bases[kMaxSegments] = {};
+    static inline thread_local shared_segment* t_current = nullptr;  ///< Segment of the innermost scope
+
+    shared_segment(std::size_t region_size, uint32_t segment_id) noexcept
+        : id(segment_id), size(region_size), bump(first_block()) {}
+
+    [[nodiscard, gnu::always_inline]] auto base() noexcept -> char* { return reinterpret_cast<char*>(this); }
+    [[nodiscard, gnu::always_inline]] auto base() const noexcept -> const char* {
+        return reinterpret_cast<const char*>(this);
+    }
+
+    /// Smallest class whose blocks hold bytes after the header
+    [[nodiscard, gnu::always_inline]] static auto class_of(std::size_t bytes) noexcept -> std::size_t {
+        auto needed = bytes + kBlockHeader;
+        return needed <= kMinBlock ? 0 : static_cast<std::size_t>(std::bit_width(needed - 1)) - 4;
+    }
+
+    /// Offset of the first block, past the header
+    [[nodiscard, gnu::always_inline]] constexpr static auto first_block() noexcept -> std::size_t {
+        return (sizeof(shared_segment) + kMinBlock - 1) & ~(kMinBlock - 1);
+    }
+};  // class shared_segment
+
+/**
+ * @brief Memory of offset_core, buffers come from the shared_segment of the current scope and the cores store the
+ * segment id and the offset of their buffer instead of its address
+ * @note Growing or releasing a buffer goes to the segment holding it, whatever the current scope
+ */
+struct segment_memory
+{
+    [[nodiscard, gnu::always_inline]] static auto to_address(int64_t stored) noexcept -> int64_t {
+        return shared_segment::address_of(stored);
+    }
+
+    [[nodiscard, gnu::always_inline]] static auto to_stored(int64_t address) noexcept -> int64_t {
+        return shared_segment::stored_of(address);
+    }
+
+    /// @throws std::bad_alloc if the segment is full, which is routine for a fixed-size region, or there is no scope
+    [[nodiscard]] static auto allocate(std::size_t size) -> void* {
+        auto* segment = shared_segment::current();
+        Assert(segment != nullptr, "offset_core strings allocate inside a shared_segment::scope");
+        void* block = segment == nullptr ? nullptr : segment->allocate(size);
+        if (block == nullptr) [[unlikely]] {
+            throw std::bad_alloc();
+        }
+        return block;
+    }
+
+    [[nodiscard]] static auto reallocate(void* block, std::size_t size) noexcept -> void* {
+        auto* segment = shared_segment::containing(block);
+        Assert(segment != nullptr, "the block should belong to a registered segment");
+        return segment == nullptr ? nullptr : segment->reallocate(block, size);
+    }
+
+    static auto deallocate(void* block) noexcept -> void {
+        auto* segment = shared_segment::containing(block);
+        Assert(segment != nullptr, "the block should belong to a registered segment");
+        if (segment != nullptr) [[likely]] {
+            segment->deallocate(block);
+        }
+    }
+
+    [[nodiscard, gnu::always_inline]] static auto usable_size(void* block, [[maybe_unused]] std::size_t size) noexcept
+      -> std::size_t {
+        return shared_segment::usable_size(block);
+    }
+};  // struct segment_memory
+
+/**
+ * @brief 8 bytes core whose buffers live in a shared_segment, addressed by segment id and offset
+ * @note A table of offset_core strings built in a segment can be mapped by other processes at any address, read-only
+ * too, and read in place without any fixup; mutating strings allocate from shared_segment::current()
+ * @note The offset is taken from the segment base rather than from the string object, cores are copied around as
+ * temporaries while a buffer grows, which a self-relative offset would not survive
+ */
+template <typename Char, bool NullTerminated>
+using offset_core = basic_malloc_core<Char, NullTerminated, 8, std::uint32_t, segment_memory>;
+
+static_assert(sizeof(offset_core<char, true>) == 8, "offset_core should be same as a pointer");
+
+/**
+ * @brief Process wide table of the memory resources tagged_core strings allocate from, indexed by a byte
+ * @note Slot 0 is std::pmr::new_delete_resource(), used outside every scope; the other slots are taken by add and
+ * given back by remove, which the caller may only do once no buffer of the resource is alive
+ * @example
+ *   std::pmr::monotonic_buffer_resource arena;
+ *   auto index = small::resource_registry::add(&arena);
+ *   {
+ *       small::resource_registry::scope scope(index);  // tagged_core strings of this thread allocate from arena
+ *       small::pmr::tagged_string name("allocated in the arena, still 8 bytes");
+ *   }
+ *   small::resource_registry::remove(index);
+ */
+class resource_registry
+{
+   public:
+    constexpr static std::size_t kMaxResources = 256;  ///< Resources registered at once, the index is one byte
+
+    /**
+     * @brief Registers a resource in the first free slot
+     * @return Index of the slot, never 0 which is the default resource
+     * @throws std::length_error if every slot is taken
+     */
+    [[nodiscard]] static auto add(std::pmr::memory_resource* resource) -> uint8_t {
+        Assert(resource != nullptr, "the resource should not be null");
+        for (std::size_t index = 1; index < kMaxResources; ++index) {
+            std::pmr::memory_resource* expected = nullptr;
+            if (slots[index].compare_exchange_strong(expected, resource, std::memory_order_acq_rel)) {
+                return static_cast<uint8_t>(index);
+            }
+        }
+        throw std::length_error("resource_registry: every slot is taken");
+    }
+
+    /// @brief Frees a slot taken by add, no buffer of its resource may be alive
+    static auto remove(uint8_t index) noexcept -> void {
+        Assert(index != 0, "the default resource stays registered");
+        if (index != 0) [[likely]] {
+            slots[index].store(nullptr, std::memory_order_release);
+        }
+    }
+
+    /// @brief The resource registered under an index, nullptr if none
+    [[nodiscard, gnu::always_inline]] static auto resource(uint8_t index) noexcept -> std::pmr::memory_resource* {
+        if (index == 0) [[likely]] {
+            return std::pmr::new_delete_resource();
+        }
+        return slots[index].load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Makes a registered resource the one the tagged_core strings of this thread allocate from
+     * @note Scopes nest, the previous index is restored on destruction
+     */
+    class scope
+    {
+       public:
+        explicit scope(uint8_t index) noexcept : previous(std::exchange(t_current, index)) {}
+        ~scope() { t_current = previous; }
+        scope(const scope&) = delete;
+        auto operator=(const scope&) -> scope& = delete;
+
+       private:
+        uint8_t previous;  ///< Index of the enclosing scope
+    };
+
+    /// @brief The index of the innermost scope of this thread, 0 outside every scope
+    [[nodiscard, gnu::always_inline]] static auto current() noexcept -> uint8_t { return t_current; }
+
+   private:
+    static inline std::atomic<std::pmr::memory_resource*> slots[kMaxResources] = {};  ///< Slot 0 is never read
+    static inline thread_local uint8_t t_current = 0;  ///< Index of the innermost scope
+};  // class resource_registry
+
+/**
+ * @brief Memory of tagged_core, buffers come from the resource of the current resource_registry scope
+ * @note Every block starts with an 8 bytes tag holding the index of its resource and its size, so growing or releasing
+ * a buffer goes back to the resource it came from, whatever the current scope, and the string stays 8 bytes
+ */
+struct tagged_memory
+{
+    /// The tag in front of every block
+    struct tag
+    {
+        uint64_t bytes : 56;  ///< Bytes of the block after the tag
+        uint64_t index : 8;   ///< Index of the resource in resource_registry
+    };
+    static_assert(sizeof(tag) == kMinAlignSize);
+
+    [[nodiscard, gnu::always_inline]] static constexpr auto to_address(int64_t stored) noexcept -> int64_t {
+        return stored;
+    }
+
+    [[nodiscard, gnu::always_inline]] static constexpr auto to_stored(int64_t address) noexcept -> int64_t {
+        return address;
+    }
+
+    /// @throws whatever the resource throws, std::bad_alloc for an exhausted one
+    [[nodiscard]] static auto allocate(std::size_t size) -> void* {
+        return allocate_from(resource_registry::current(), size);
+    }
+
+    /// @brief Moves the block into a new one of the same resource, resources have no realloc
+    /// @throws whatever the resource throws, the block is still valid then
+    [[nodiscard]] static auto reallocate(void* block, std::size_t size) -> void* {
+        auto* old_tag = tag_of(block);
+        if (size == old_tag->bytes) {
+            return block;
+        }
+        auto* new_block = allocate_from(static_cast<uint8_t>(old_tag->index), size);
+        std::memcpy(new_block, block, std::min<std::size_t>(old_tag->bytes, size));
+        deallocate(block);
+        return new_block;
+    }
+
+    static auto deallocate(void* block) noexcept -> void {
+        auto* block_tag = tag_of(block);
+        auto* resource = resource_registry::resource(static_cast<uint8_t>(block_tag->index));
+        Assert(resource != nullptr, "the resource of the block should still be registered");
+        resource->deallocate(block_tag, block_tag->bytes + sizeof(tag), kMinAlignSize);
+    }
+
+    [[nodiscard, gnu::always_inline]] static auto usable_size(void* block, [[maybe_unused]] std::size_t size) noexcept
+      -> std::size_t {
+        return tag_of(block)->bytes;
+    }
+
+   private:
+    [[nodiscard, gnu::always_inline]] static auto tag_of(void* block) noexcept -> tag* {
+        return reinterpret_cast<tag*>(block) - 1;
+    }
+
+    [[nodiscard]] static auto allocate_from(uint8_t index, std::size_t size) -> void* {
+        auto* resource = resource_registry::resource(index);
+        Assert(resource != nullptr, "tagged_core strings allocate from a registered resource");
+        if (resource == nullptr) [[unlikely]] {
+            throw std::bad_alloc();
+        }
+        auto* block_tag = static_cast<tag*>(resource->allocate(size + sizeof(tag), kMinAlignSize));
+        block_tag->bytes = size & ((uint64_t{1} << 56) - 1);
+        block_tag->index = index;
+        return block_tag + 1;
+    }
+};  // struct tagged_memory
+
+/**
+ * @brief 8 bytes core whose buffers come from a registered memory resource, the alternative to the 16 bytes pmr_core
+ * @note The index of the resource lives in the tag in front of the buffer instead of the object, a buffer grows or
+ * shrinks in its own resource, a new buffer (a copy, an Internal or Short string moving to another tier) comes from the
+ * resource of the current scope
+ */
+template <typename Char, bool NullTerminated>
+using tagged_core = basic_malloc_core<Char, NullTerminated, 8, std::uint32_t, tagged_memory>;
+
+static_assert(sizeof(tagged_core<char, true>) == 8, "tagged_core should be same as a pointer");
+
+namespace stats {
+
+/// @brief Whether the library was built with SMALL_STRING_STATS, the counters stay zero otherwise
+#ifdef SMALL_STRING_STATS
+constexpr inline bool enabled = true;
+#else
+constexpr inline bool enabled = false;
+#endif
+
+/**
+ * @brief Buffer counters of one tier
+ */
+struct tier_counters
+{
+    uint64_t allocations = 0;        ///< Buffers allocated in this tier
+    uint64_t deallocations = 0;      ///< Buffers released from this tier
+    uint64_t reallocations = 0;      ///< Buffers grown in place (realloc/mremap) into this tier
+    uint64_t allocated_bytes = 0;    ///< Bytes allocated in this tier, reallocations included
+    uint64_t deallocated_bytes = 0;  ///< Bytes released from this tier, reallocations included
+};
+
+/**
+ * @brief Process wide buffer counters, indexed by CoreType
+ * @note Internal has no buffer, its tier counters stay zero, it only appears in the transitions
+ */
+struct counters
+{
+    tier_counters tiers[4];        ///< Per tier counters
+    uint64_t transitions[4][4]{};  ///< transitions[from][to], buffer changes of growth, reserve and shrinking
+
+    [[nodiscard]] auto tier(CoreType type) const noexcept -> const tier_counters& {
+        return tiers[static_cast<uint8_t>(type)];
+    }
+
+    [[nodiscard]] auto transition(CoreType from, CoreType to) const noexcept -> uint64_t {
+        return transitions[static_cast<uint8_t>(from)][static_cast<uint8_t>(to)];
+    }
+};
+
+namespace detail {
+
+#ifdef SMALL_STRING_STATS
+/// @brief Atomic twin of tier_counters
+struct atomic_tier_counters
+{
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+    std::atomic<uint64_t> reallocations{0};
+    std::atomic<uint64_t> allocated_bytes{0};
+    std::atomic<uint64_t> deallocated_bytes{0};
+};
+
+/// @brief Relaxed atomic storage behind counters, only ordered by the snapshot itself
+struct registry
+{
+    static inline atomic_tier_counters tiers[4];
+    static inline std::atomic<uint64_t> transitions[4][4];
+};
+
+[[gnu::always_inline]] inline auto tier_of(CoreType type) noexcept -> atomic_tier_counters& {
+    return registry::tiers[static_cast<uint8_t>(type)];
+}
+
+[[gnu::always_inline]] inline auto count_allocation(CoreType type, std::size_t bytes) noexcept -> void {
+    tier_of(type).allocations.fetch_add(1, std::memory_order_relaxed);
+    tier_of(type).allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+[[gnu::always_inline]] inline auto count_deallocation(CoreType type, std::size_t bytes) noexcept -> void {
+    tier_of(type).deallocations.fetch_add(1, std::memory_order_relaxed);
+    tier_of(type).deallocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+[[gnu::always_inline]] inline auto count_reallocation(CoreType from, std::size_t old_bytes, CoreType to,
+                                                      std::size_t new_bytes) noexcept -> void {
+    tier_of(from).deallocated_bytes.fetch_add(old_bytes, std::memory_order_relaxed);
+    tier_of(to).reallocations.fetch_add(1, std::memory_order_relaxed);
+    tier_of(to).allocated_bytes.fetch_add(new_bytes, std::memory_order_relaxed);
+}
+
+[[gnu::always_inline]] inline auto count_transition(CoreType from, CoreType to) noexcept -> void {
+    registry::transitions[static_cast<uint8_t>(from)][static_cast<uint8_t>(to)].fetch_add(1,
+                                                                                         std::memory_order_relaxed);
+}
+#else
+[[gnu::always_inline]] inline auto count_allocation(CoreType /*type*/, std::size_t /*bytes*/) noexcept -> void {}
+
+[[gnu::always_inline]] inline auto count_deallocation(CoreType /*type*/, std::size_t /*bytes*/) noexcept -> void {}
+
+[[gnu::always_inline]] inline auto count_reallocation(CoreType /*from*/, std::size_t /*old_bytes*/, CoreType /*to*/,
+                                                      std::size_t /*new_bytes*/) noexcept -> void {}
+
+[[gnu::always_inline]] inline auto count_transition(CoreType /*from*/, CoreType /*to*/) noexcept -> void {}
+#endif
+
+}  // namespace detail
+
+/**
+ * @brief Reads the counters of all small strings of the process
+ * @return Copy of the counters, all zero without SMALL_STRING_STATS
+ * @note Each counter is read atomically, the snapshot as a whole is not, counters may move while it is taken
+ */
+[[nodiscard]] inline auto snapshot() noexcept -> counters {
+    counters result;
+#ifdef SMALL_STRING_STATS
+    for (std::size_t i = 0; i < 4; ++i) {
+        auto& tier = detail::registry::tiers[i];
+        result.tiers[i] = {.allocations = tier.allocations.load(std::memory_order_relaxed),
+                           .deallocations = tier.deallocations.load(std::memory_order_relaxed),
+                           .reallocations = tier.reallocations.load(std::memory_order_relaxed),
+                           .allocated_bytes = tier.allocated_bytes.load(std::memory_order_relaxed),
+                           .deallocated_bytes = tier.deallocated_bytes.load(std::memory_order_relaxed)};
+        for (std::size_t j = 0; j < 4; ++j) {
+            result.transitions[i][j] = detail::registry::transitions[i][j].load(std::memory_order_relaxed);
+        }
+    }
+#endif
+    return result;
+}
+
+/**
+ * @brief Zeroes all counters
+ * @note Meant for tests and benchmarks, strings alive across a reset are released into the new counting period
+ */
+inline auto reset() noexcept -> void {
+#ifdef SMALL_STRING_STATS
+    for (std::size_t i = 0; i < 4; ++i) {
+        auto& tier = detail::registry::tiers[i];
+        tier.allocations.store(0, std::memory_order_relaxed);
+        tier.deallocations.store(0, std::memory_order_relaxed);
+        tier.reallocations.store(0, std::memory_order_relaxed);
+        tier.allocated_bytes.store(0, std::memory_order_relaxed);
+        tier.deallocated_bytes.store(0, std::memory_order_relaxed);
+        for (std::size_t j = 0; j < 4; ++j) {
+            detail::registry::transitions[i][j].store(0, std::memory_order_relaxed);
+        }
+    }
+#endif
+}
+
+}  // namespace stats
+
+/**
+ * @brief What a growth policy is asked when a buffer has to grow
+ * @tparam S Buffer size type of the core, uint32_t unless the core has 64-bit Long headers (huge_core)
+ * @note The fit helpers come from the buffer, so a policy never has to know the tier layout of the core
+ */
+template <typename S>
+struct basic_growth_request
+{
+    std::size_t old_size;             ///< String size before growing
+    CoreType old_tier;                ///< Tier of the current buffer
+    std::size_t new_size;             ///< Size the grown buffer must hold
+    buffer_type_and_size<S> minimum;  ///< Smallest buffer holding new_size, and its tier
+    /// Smallest buffer holding the given number of chars
+    buffer_type_and_size<S> (*fit_size)(std::size_t size) noexcept;
+    /// Largest buffer of at most the given number of bytes
+    buffer_type_and_size<S> (*fit_buffer)(std::size_t buffer_size) noexcept;
+};
+
+using growth_request = basic_growth_request<uint32_t>;
+
+/**
+ * @brief A growth policy maps a growth_request to the buffer size and tier to allocate
+ * @tparam S Buffer size type the policy has to serve, the built-in policies serve any
+ * @note A result smaller than request.minimum is ignored, the buffer falls back to the minimum
+ */
+template <typename Policy, typename S = uint32_t>
+concept GrowthPolicy = requires(const basic_growth_request<S>& request) {
+    { Policy::grow(request) } noexcept -> std::same_as<buffer_type_and_size<S>>;
+};
+
+/**
+ * @brief Grows the size geometrically, the historical behavior
+ * @tparam Factor Growth multiplier of the requested size
+ */
+template <float Factor = 1.5F>
+struct geometric_growth
+{
+    static_assert(Factor >= 1.0F, "the growth factor should be at least 1");
+
+    template <typename S>
+    [[nodiscard, gnu::always_inline]] constexpr static auto grow(const basic_growth_request<S>& request) noexcept
+      -> buffer_type_and_size<S> {
+        return request.fit_size(static_cast<std::size_t>(static_cast<float>(request.new_size) * Factor));
+    }
+};
+
+/**
+ * @brief Rounds the buffer up to the next power of two bytes
+ * @note Matches buddy and power-of-two size class allocators, a full buffer doubles
+ */
+struct power_of_two_growth
+{
+    template <typename S>
+    [[nodiscard, gnu::always_inline]] constexpr static auto grow(const basic_growth_request<S>& request) noexcept
+      -> buffer_type_and_size<S> {
+        return request.fit_buffer(std::bit_ceil(static_cast<std::size_t>(request.minimum.buffer_size)));
+    }
+};
+
+/**
+ * @brief Grows geometrically, then rounds the buffer up to the jemalloc size class holding it
+ * @tparam Factor Growth multiplier of the requested size
+ * @note The bytes jemalloc would round up to anyway become capacity instead of slack
+ */
+template <float Factor = 1.5F>
+struct jemalloc_class_growth
+{
+    /**
+     * @brief Returns the jemalloc size class of a request, 16 bytes spaced up to 128, then 4 classes per doubling
+     * @param size Request in bytes
+     * @return Smallest size class holding size
+     */
+    [[nodiscard]] constexpr static auto size_class(std::size_t size) noexcept -> std::size_t {
+        if (size <= 8) {
+            return 8;
+        }
+        if (size <= 128) {
+            return AlignUpTo<16>(size);
+        }
+        auto spacing = std::size_t{1} << (std::bit_width(size - 1) - 3);
+        return (size + spacing - 1) & ~(spacing - 1);
+    }
+
+    template <typename S>
+    [[nodiscard, gnu::always_inline]] constexpr static auto grow(const basic_growth_request<S>& request) noexcept
+      -> buffer_type_and_size<S> {
+        auto target = geometric_growth<Factor>::grow(request);
+        return request.fit_buffer(size_class(target.buffer_size));
+    }
+};
+
+/**
+ * @brief Grows geometrically but never adds more than MaxStep chars at once
+ * @tparam Factor Growth multiplier of the requested size
+ * @tparam MaxStep Largest extra capacity in chars, bounds the slack of huge strings
+ */
+template <float Factor = 1.5F, std::size_t MaxStep = 16UL * 1024UL * 1024UL>
+struct capped_geometric_growth
+{
+    static_assert(Factor >= 1.0F, "the growth factor should be at least 1");
+
+    template <typename S>
+    [[nodiscard, gnu::always_inline]] constexpr static auto grow(const basic_growth_request<S>& request) noexcept
+      -> buffer_type_and_size<S> {
+        auto step = static_cast<std::size_t>(static_cast<float>(request.new_size) * (Factor - 1.0F));
+        return request.fit_size(request.new_size + std::min(step, MaxStep));
+    }
+};
+
+/// @brief Growth policy used when none is given, 1.5x of the requested size
+using default_growth = geometric_growth<>;
+
+static_assert(GrowthPolicy<default_growth>);
+static_assert(GrowthPolicy<power_of_two_growth>);
+static_assert(GrowthPolicy<jemalloc_class_growth<>>);
+static_assert(GrowthPolicy<capped_geometric_growth<>>);
+
+/**
+ * @brief What a shrinking growth policy is asked when the size of a string dropped
+ * @tparam S Buffer size type of the core, as in basic_growth_request
+ */
+template <typename S>
+struct basic_shrink_request
+{
+    buffer_type_and_size<S> current;  ///< Buffer of the string, Internal when it has none
+    std::size_t new_size;             ///< String size after the erase
+    std::size_t char_size;            ///< Bytes per char, relates new_size to the buffer size
+    /// Smallest buffer holding the given number of chars
+    buffer_type_and_size<S> (*fit_size)(std::size_t size) noexcept;
+};
+
+using shrink_request = basic_shrink_request<uint32_t>;
+
+/**
+ * @brief A growth policy which also gives capacity back when clear, erase or resize drop the size
+ * @note shrink returns the buffer to move to, returning request.current keeps the buffer
+ */
+template <typename Policy, typename S = uint32_t>
+concept ShrinkPolicy = GrowthPolicy<Policy, S> and requires(const basic_shrink_request<S>& request) {
+    { Policy::shrink(request) } noexcept -> std::same_as<buffer_type_and_size<S>>;
+};
+
+/**
+ * @brief Grows like Growth, moves to a smaller buffer once the size falls below Fraction of the buffer
+ * @tparam Growth Growth policy used for growing
+ * @tparam Fraction Occupancy below which the buffer shrinks, at most 0.5
+ * @tparam MinBuffer Buffers of at most this many bytes are never shrunk
+ * @note The new buffer is half full, so it takes halving the size again to shrink or doubling it to grow,
+ *       a size moving around one threshold never reallocates back and forth
+ */
+template <GrowthPolicy Growth = default_growth, float Fraction = 0.25F, std::size_t MinBuffer = 64>
+struct hysteresis_shrink : public Growth
+{
+    static_assert(Fraction > 0.0F and Fraction <= 0.5F, "the shrink fraction should be in (0, 0.5]");
+
+    using Growth::grow;
+
+    template <typename S>
+    [[nodiscard, gnu::always_inline]] constexpr static auto shrink(const basic_shrink_request<S>& request) noexcept
+      -> buffer_type_and_size<S> {
+        auto buffer_size = static_cast<std::size_t>(request.current.buffer_size);
+        if (request.current.core_type == CoreType::Internal or buffer_size <= MinBuffer or
+            static_cast<float>(request.new_size * request.char_size) >= static_cast<float>(buffer_size) * Fraction)
+          [[likely]] {
+            return request.current;
+        }
+        return request.fit_size(request.new_size * 2);
+    }
+};
+
+static_assert(ShrinkPolicy<hysteresis_shrink<>>);
+static_assert(not ShrinkPolicy<default_growth>);
+
+/**
+ * @brief Default Long tier policy, Long buffers come from the core's allocator like the other tiers
+ */
+struct heap_long_tier
+{
+    constexpr static bool enabled = false;  ///< No Long buffer is mapped
+};
+
+/**
+ * @brief Long tier policy backing large Long buffers with anonymous mmap
+ * @tparam Threshold Buffers of at least Threshold bytes are mapped, smaller ones stay on the heap
+ * @tparam HugePages Whether to advise the kernel to back the mapping with transparent huge pages
+ * @note Mapped buffers grow with mremap on Linux, so growth neither copies nor page-faults the old content again
+ * @note Bypasses the allocator, so only the std allocator cores accept it
+ */
+template <std::size_t Threshold = 2UL * 1024UL * 1024UL, bool HugePages = true>
+struct mmap_long_tier
+{
+    constexpr static bool enabled = true;                ///< Long buffers above threshold are mapped
+    constexpr static std::size_t threshold = Threshold;  ///< Minimum mapped buffer size in bytes
+
+    /**
+     * @brief Maps a new buffer
+     * @param buffer_size Buffer size in bytes
+     * @return Pointer to the mapping, nullptr on failure
+     */
+    [[nodiscard]] static auto allocate(std::size_t buffer_size) noexcept -> void* {
+        auto* ptr =
+          ::mmap(nullptr, mapped_size(buffer_size), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) [[unlikely]] {
+            return nullptr;
+        }
+        advise(ptr, buffer_size);
+        return ptr;
+    }
+
+    /**
+     * @brief Grows a mapped buffer, the content is kept
+     * @param ptr Mapping returned by allocate or reallocate
+     * @param old_size Buffer size passed when ptr was mapped
+     * @param new_size New buffer size in bytes
+     * @return Pointer to the grown mapping, nullptr on failure (ptr is still valid then)
+     */
+    [[nodiscard]] static auto reallocate(void* ptr, std::size_t old_size, std::size_t new_size) noexcept -> void* {
+#if defined(__linux__)
+        auto* new_ptr = ::mremap(ptr, mapped_size(old_size), mapped_size(new_size), MREMAP_MAYMOVE);
+        if (new_ptr == MAP_FAILED) [[unlikely]] {
+            return nullptr;
+        }
+        advise(new_ptr, new_size);
+        return new_ptr;
+#else
+        auto* new_ptr = allocate(new_size);
+        if (new_ptr != nullptr) [[likely]] {
+            std::memcpy(new_ptr, ptr, old_size);
+            deallocate(ptr, old_size);
+        }
+        return new_ptr;
+#endif
+    }
+
+    /**
+     * @brief Unmaps a buffer
+     * @param ptr Mapping returned by allocate or reallocate
+     * @param buffer_size Buffer size passed when ptr was mapped
+     */
+    static auto deallocate(void* ptr, std::size_t buffer_size) noexcept -> void {
+        ::munmap(ptr, mapped_size(buffer_size));
+    }
+
+   private:
+    [[nodiscard]] static auto mapped_size(std::size_t buffer_size) noexcept -> std::size_t {
+        static const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return (buffer_size + page_size - 1) & ~(page_size - 1);
+    }
+
+    static auto advise([[maybe_unused]] void* ptr, [[maybe_unused]] std::size_t buffer_size) noexcept -> void {
+#if defined(MADV_HUGEPAGE)
+        if constexpr (HugePages) {
+            ::madvise(ptr, mapped_size(buffer_size), MADV_HUGEPAGE);
+        }
+#endif
+    }
+};
+
+/**
+ * @brief Precompiled set of bytes for the find_first_of family
+ * @note A 256-bit table answers membership with one bit test. The nibble tables let the AVX2 kernels classify 32 bytes
+ * with two shuffles (Langdale and Lemire): a byte belongs to the set when low[byte & 15] & high[byte >> 4] != 0. They
+ * are exact when the high nibbles of the set use at most 8 distinct masks of low nibbles, one bit per mask, which
+ * covers the usual whitespace, punctuation and digit classes; other sets keep the table
+ * @note Build it once and pass it to the char_set overloads of the find_first_of family instead of the chars
+ * @example
+ *   constexpr small::char_set kSeparators(" \t\r\n,;:");
+ *   auto end = line.find_first_of(kSeparators, begin);
+ */
+class char_set
+{
+   public:
+    constexpr char_set() noexcept = default;
+
+    /// @brief The set of count chars from chars, duplicates are fine
+    constexpr char_set(const char* chars, std::size_t count) noexcept : char_set(table_only(chars, count)) {
+        build_nibbles();
+    }
+
+    /// @brief The set of the chars of a view
+    constexpr explicit char_set(std::string_view chars) noexcept : char_set(chars.data(), chars.size()) {}
+
+    /**
+     * @brief The set of count chars from chars with the bit table only
+     * @note Cheaper to build for a one-off search, add_nibble_tables once the haystack turns out long enough
+     */
+    [[nodiscard]] constexpr static auto table_only(const char* chars, std::size_t count) noexcept -> char_set {
+        char_set set;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto byte = static_cast<uint8_t>(chars[i]);
+            set.bits[byte >> 6] |= uint64_t{1} << (byte & 63);
+        }
+        return set;
+    }
+
+    /// @brief Builds the nibble tables of a table_only set, if the set fits them
+    constexpr auto add_nibble_tables() noexcept -> void {
+        if (not nibbles) {
+            build_nibbles();
+        }
+    }
+
+    /// @brief Whether a char belongs to the set
+    [[nodiscard, gnu::always_inline]] constexpr auto contains(char ch) const noexcept -> bool {
+        auto byte = static_cast<uint8_t>(ch);
+        return ((bits[byte >> 6] >> (byte & 63)) & 1) != 0;
+    }
+
+    /// @brief Number of distinct chars in the set
+    [[nodiscard]] constexpr auto size() const noexcept -> std::size_t {
+        return static_cast<std::size_t>(std::popcount(bits[0]) + std::popcount(bits[1]) + std::popcount(bits[2]) +
+                                        std::popcount(bits[3]));
+    }
+
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return (bits[0] | bits[1] | bits[2] | bits[3]) == 0; }
+
+    /// @brief Whether the nibble tables describe the set exactly
+    [[nodiscard]] constexpr auto has_nibble_tables() const noexcept -> bool { return nibbles; }
+
+    /// @brief Classes of the low nibbles, see the class notes
+    [[nodiscard]] constexpr auto low_nibble_table() const noexcept -> const uint8_t* { return low; }
+
+    /// @brief Classes of the high nibbles, see the class notes
+    [[nodiscard]] constexpr auto high_nibble_table() const noexcept -> const uint8_t* { return high; }
+
+   private:
+    uint64_t bits[4] = {};          ///< Bit b of the 256 is set when byte b belongs to the set
+    alignas(16) uint8_t low[16] = {};   ///< Classes each low nibble belongs to
+    alignas(16) uint8_t high[16] = {};  ///< Class of each high nibble, 0 if no byte of the set has it
+    bool nibbles = false;            ///< Whether low and high describe the set
+
+    /// @brief Gives every distinct mask of low nibbles a class bit, up to 8
+    constexpr auto build_nibbles() noexcept -> void {
+        uint16_t masks[8] = {};
+        std::size_t classes = 0;
+        for (std::size_t nibble = 0; nibble < 16; ++nibble) {
+            auto mask = static_cast<uint16_t>(bits[nibble / 4] >> ((nibble % 4) * 16));
+            if (mask == 0) {
+                continue;
+            }
+            std::size_t index = 0;
+            while (index < classes and masks[index] != mask) {
+                ++index;
+            }
+            if (index == classes) {
+                if (classes == 8) {
+                    return;
+                }
+                masks[classes++] = mask;
+            }
+            high[nibble] = static_cast<uint8_t>(1U << index);
+        }
+        for (std::size_t index = 0; index < classes; ++index) {
+            for (std::size_t nibble = 0; nibble < 16; ++nibble) {
+                if (((masks[index] >> nibble) & 1) != 0) {
+                    low[nibble] = static_cast<uint8_t>(low[nibble] | (1U << index));
+                }
+            }
+        }
+        nibbles = true;
+    }
+};  // class char_set
+
+/**
+ * @brief Byte search kernels behind the find family of the char strings
+ * @note The x86 kernels are picked once at runtime, AVX2 when the CPU has it, SSE2 otherwise; define
+ * SMALL_STRING_NO_SIMD to keep the scalar ones
+ */
+namespace search {
+
+/// Returned by the kernels when nothing matches
+inline constexpr std::size_t kNotFound = std::numeric_limits<std::size_t>::max();
+
+/**
+ * @brief Finds a needle with memchr on its first byte and memcmp on the rest
+ * @param haystack Bytes to search
+ * @param size Bytes of the haystack
+ * @param needle Bytes to find
+ * @param count Bytes of the needle, at least 1
+ * @return Offset of the first match, kNotFound if none
+ * @note Every occurrence of the first byte costs a memcmp, so a common first byte degrades it
+ */
+[[nodiscard]] inline auto find_scalar(const char* haystack, std::size_t size, const char* needle,
+                                      std::size_t count) noexcept -> std::size_t {
+    const auto* first = haystack;
+    const auto* const end = haystack + size;
+    while (static_cast<std::size_t>(end - first) >= count) {
+        first =
+          static_cast<const char*>(std::memchr(first, needle[0], static_cast<std::size_t>(end - first) - count + 1));
+        if (first == nullptr) {
+            return kNotFound;
+        }
+        if (std::memcmp(first + 1, needle + 1, count - 1) == 0) {
+            return static_cast<std::size_t>(first - haystack);
+        }
+        ++first;
+    }
+    return kNotFound;
+}
+
+#ifdef SMALL_STRING_X86_SIMD
+/**
+ * @brief Offset of the second byte the vector kernels test, the last byte of the needle unlike its first one
+ * @note A needle like "key" in JSON starts and ends with a quote, testing the quote twice would filter nothing
+ */
+[[nodiscard]] inline auto anchor_of(const char* needle, std::size_t count) noexcept -> std::size_t {
+    auto anchor = count - 1;
+    while (anchor > 1 and needle[anchor] == needle[0]) {
+        --anchor;
+    }
+    return anchor;
+}
+
+/**
+ * @brief Finds a needle of at least 2 bytes 16 positions at a time
+ * @param anchor Offset of the second byte tested, see anchor_of
+ * @note A position is a candidate when both the first byte and the anchor byte of the needle match there, which a
+ * common first byte alone rarely does, only candidates are compared
+ */
+[[nodiscard]] inline auto find_sse2(const char* haystack, std::size_t size, const char* needle, std::size_t count,
+                                    std::size_t anchor) noexcept -> std::size_t {
+    const auto first = _mm_set1_epi8(needle[0]);
+    const auto last = _mm_set1_epi8(needle[anchor]);
+    const auto positions = size - count + 1;
+    std::size_t offset = 0;
+    for (; offset + 16 <= positions; offset += 16) {
+        auto block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + offset));
+        auto block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + offset + anchor));
+        auto mask = static_cast<uint32_t>(
+          _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+        while (mask != 0) {
+            auto candidate = offset + static_cast<std::size_t>(std::countr_zero(mask));
+            if (std::memcmp(haystack + candidate + 1, needle + 1, count - 1) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    auto found = find_scalar(haystack + offset, size - offset, needle, count);
+    return found == kNotFound ? kNotFound : offset + found;
+}
+
+/// @brief find_sse2 32 positions at a time
+[[nodiscard, gnu::target("avx2")]] inline auto find_avx2(const char* haystack, std::size_t size, const char* needle,
+                                                         std::size_t count, std::size_t anchor) noexcept
+  -> std::size_t {
+    const auto first = _mm256_set1_epi8(needle[0]);
+    const auto last = _mm256_set1_epi8(needle[anchor]);
+    const auto positions = size - count + 1;
+    std::size_t offset = 0;
+    for (; offset + 32 <= positions; offset += 32) {
+        auto block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + offset));
+        auto block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + offset + anchor));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+          _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last))));
+        while (mask != 0) {
+            auto candidate = offset + static_cast<std::size_t>(std::countr_zero(mask));
+            if (std::memcmp(haystack + candidate + 1, needle + 1, count - 1) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    auto found = find_sse2(haystack + offset, size - offset, needle, count, anchor);
+    return found == kNotFound ? kNotFound : offset + found;
+}
+
+/// Signature shared by the substring kernels
+using find_kernel = auto (*)(const char*, std::size_t, const char*, std::size_t, std::size_t) noexcept -> std::size_t;
+
+/// @brief The widest substring kernel the CPU runs
+[[nodiscard]] inline auto select_find() noexcept -> find_kernel {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? find_avx2 : find_sse2;
+}
+#endif
+
+/**
+ * @brief Finds the first occurrence of a needle in a haystack
+ * @param haystack Bytes to search
+ * @param size Bytes of the haystack
+ * @param needle Bytes to find
+ * @param count Bytes of the needle, at least 1
+ * @return Offset of the first match, kNotFound if none
+ * @note Haystacks shorter than a vector and 1 byte needles go to memchr directly
+ */
+[[nodiscard, gnu::always_inline]] inline auto find(const char* haystack, std::size_t size, const char* needle,
+                                                   std::size_t count) noexcept -> std::size_t {
+    if (count > size) {
+        return kNotFound;
+    }
+    if (count == 1) {
+        const auto* found = static_cast<const char*>(std::memchr(haystack, needle[0], size));
+        return found == nullptr ? kNotFound : static_cast<std::size_t>(found - haystack);
+    }
+#ifdef SMALL_STRING_X86_SIMD
+    if (size - count >= 64) {
+        static const auto kernel = select_find();
+        return kernel(haystack, size, needle, count, anchor_of(needle, count));
+    }
+    if (size - count >= 16) {
+        // SSE2 is part of x86-64, short haystacks skip the indirect call
+        return find_sse2(haystack, size, needle, count, anchor_of(needle, count));
+    }
+#endif
+    return find_scalar(haystack, size, needle, count);
+}
+
+/**
+ * @brief Finds the last occurrence of a byte, a plain backward loop
+ * @return Offset of the match, kNotFound if none
+ */
+[[nodiscard]] inline auto rfind_char_scalar(const char* haystack, std::size_t size, char ch) noexcept -> std::size_t {
+    while (size-- > 0) {
+        if (haystack[size] == ch) {
+            return size;
+        }
+    }
+    return kNotFound;
+}
+
+/**
+ * @brief Finds the last occurrence of a needle starting at most at size - count, backward memcmp at every position
+ * @param count Bytes of the needle, at least 1
+ */
+[[nodiscard]] inline auto rfind_scalar(const char* haystack, std::size_t size, const char* needle,
+                                       std::size_t count) noexcept -> std::size_t {
+    for (auto positions = size - count + 1; positions-- > 0;) {
+        if (haystack[positions] == needle[0] and std::memcmp(haystack + positions + 1, needle + 1, count - 1) == 0) {
+            return positions;
+        }
+    }
+    return kNotFound;
+}
+
+#ifdef SMALL_STRING_X86_SIMD
+/// @brief Finds the last occurrence of a byte 16 bytes at a time, from the end
+[[nodiscard]] inline auto rfind_char_sse2(const char* haystack, std::size_t size, char ch) noexcept -> std::size_t {
+    const auto wanted = _mm_set1_epi8(ch);
+    for (; size >= 16; size -= 16) {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + size - 16));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, wanted)));
+        if (mask != 0) {
+            return size - 16 + static_cast<std::size_t>(31 - std::countl_zero(mask));
+        }
+    }
+    return rfind_char_scalar(haystack, size, ch);
+}
+
+/// @brief rfind_char_sse2 128 bytes at a time, the 4 vectors are only told apart once one of them matches
+[[nodiscard, gnu::target("avx2")]] inline auto rfind_char_avx2(const char* haystack, std::size_t size,
+                                                               char ch) noexcept -> std::size_t {
+    const auto wanted = _mm256_set1_epi8(ch);
+    for (; size >= 128; size -= 128) {
+        const auto* block = reinterpret_cast<const __m256i*>(haystack + size - 128);
+        auto v0 = _mm256_cmpeq_epi8(_mm256_loadu_si256(block), wanted);
+        auto v1 = _mm256_cmpeq_epi8(_mm256_loadu_si256(block + 1), wanted);
+        auto v2 = _mm256_cmpeq_epi8(_mm256_loadu_si256(block + 2), wanted);
+        auto v3 = _mm256_cmpeq_epi8(_mm256_loadu_si256(block + 3), wanted);
+        auto any = _mm256_or_si256(_mm256_or_si256(v0, v1), _mm256_or_si256(v2, v3));
+        if (not _mm256_testz_si256(any, any)) {
+            auto high = (uint64_t{static_cast<uint32_t>(_mm256_movemask_epi8(v3))} << 32) |
+                        static_cast<uint32_t>(_mm256_movemask_epi8(v2));
+            if (high != 0) {
+                return size - 64 + static_cast<std::size_t>(63 - std::countl_zero(high));
+            }
+            auto low = (uint64_t{static_cast<uint32_t>(_mm256_movemask_epi8(v1))} << 32) |
+                       static_cast<uint32_t>(_mm256_movemask_epi8(v0));
+            return size - 128 + static_cast<std::size_t>(63 - std::countl_zero(low));
+        }
+    }
+    for (; size >= 64; size -= 64) {
+        auto high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + size - 32));
+        auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + size - 64));
+        auto high_mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, wanted)));
+        auto low_mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, wanted)));
+        auto mask = (uint64_t{high_mask} << 32) | low_mask;
+        if (mask != 0) {
+            return size - 64 + static_cast<std::size_t>(63 - std::countl_zero(mask));
+        }
+    }
+    return rfind_char_sse2(haystack, size, ch);
+}
+
+/**
+ * @brief Finds the last occurrence of a needle of at least 2 bytes 16 positions at a time, from the end
+ * @param anchor Offset of the second byte tested, see anchor_of
+ */
+[[nodiscard]] inline auto rfind_sse2(const char* haystack, std::size_t size, const char* needle, std::size_t count,
+                                     std::size_t anchor) noexcept -> std::size_t {
+    const auto first = _mm_set1_epi8(needle[0]);
+    const auto second = _mm_set1_epi8(needle[anchor]);
+    auto positions = size - count + 1;
+    for (; positions >= 16; positions -= 16) {
+        auto offset = positions - 16;
+        auto block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + offset));
+        auto block_second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + offset + anchor));
+        auto mask = static_cast<uint32_t>(
+          _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(second, block_second))));
+        while (mask != 0) {
+            auto bit = 31 - std::countl_zero(mask);
+            auto candidate = offset + static_cast<std::size_t>(bit);
+            if (std::memcmp(haystack + candidate + 1, needle + 1, count - 1) == 0) {
+                return candidate;
+            }
+            mask &= ~(uint32_t{1} << bit);
+        }
+    }
+    return rfind_scalar(haystack, positions + count - 1, needle, count);
+}
+
+/// @brief rfind_sse2 32 positions at a time
+[[nodiscard, gnu::target("avx2")]] inline auto rfind_avx2(const char* haystack, std::size_t size, const char* needle,
+                                                          std::size_t count, std::size_t anchor) noexcept
+  -> std::size_t {
+    const auto first = _mm256_set1_epi8(needle[0]);
+    const auto second = _mm256_set1_epi8(needle[anchor]);
+    auto positions = size - count + 1;
+    for (; positions >= 32; positions -= 32) {
+        auto offset = positions - 32;
+        auto block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + offset));
+        auto block_second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + offset + anchor));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+          _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(second, block_second))));
+        while (mask != 0) {
+            auto bit = 31 - std::countl_zero(mask);
+            auto candidate = offset + static_cast<std::size_t>(bit);
+            if (std::memcmp(haystack + candidate + 1, needle + 1, count - 1) == 0) {
+                return candidate;
+            }
+            mask &= ~(uint32_t{1} << bit);
+        }
+    }
+    return rfind_sse2(haystack, positions + count - 1, needle, count, anchor);
+}
+
+/// Signature of the backward byte kernels
+using rfind_char_kernel = auto (*)(const char*, std::size_t, char) noexcept -> std::size_t;
+
+/// @brief The widest backward byte kernel the CPU runs
+[[nodiscard]] inline auto select_rfind_char() noexcept -> rfind_char_kernel {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? rfind_char_avx2 : rfind_char_sse2;
+}
+
+/// @brief The widest backward substring kernel the CPU runs
+[[nodiscard]] inline auto select_rfind() noexcept -> find_kernel {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? rfind_avx2 : rfind_sse2;
+}
+#endif
+
+/**
+ * @brief Finds the last occurrence of a byte
+ * @param haystack Bytes to search
+ * @param size Bytes of the haystack
+ * @param ch Byte to find
+ * @return Offset of the match, kNotFound if none
+ * @note glibc's memrchr is tuned per CPU and beats the kernels here, the kernels serve the other C libraries
+ */
+[[nodiscard, gnu::always_inline]] inline auto rfind_char(const char* haystack, std::size_t size, char ch) noexcept
+  -> std::size_t {
+#if defined(__GLIBC__)
+    const auto* found = static_cast<const char*>(::memrchr(haystack, ch, size));
+    return found == nullptr ? kNotFound : static_cast<std::size_t>(found - haystack);
+#elif defined(SMALL_STRING_X86_SIMD)
+    if (size >= 128) {
+        static const auto kernel = select_rfind_char();
+        return kernel(haystack, size, ch);
+    }
+    return rfind_char_sse2(haystack, size, ch);
+#else
+    return rfind_char_scalar(haystack, size, ch);
+#endif
+}
+
+/**
+ * @brief Finds the last occurrence of a needle, the match ends within the haystack
+ * @param haystack Bytes to search
+ * @param size Bytes of the haystack
+ * @param needle Bytes to find
+ * @param count Bytes of the needle, at least 1
+ * @return Offset of the last match, kNotFound if none
+ */
+[[nodiscard, gnu::always_inline]] inline auto rfind(const char* haystack, std::size_t size, const char* needle,
+                                                    std::size_t count) noexcept -> std::size_t {
+    if (count > size) {
+        return kNotFound;
+    }
+    if (count == 1) {
+        return rfind_char(haystack, size, needle[0]);
+    }
+#ifdef SMALL_STRING_X86_SIMD
+    if (size - count >= 64) {
+        static const auto kernel = select_rfind();
+        return kernel(haystack, size, needle, count, anchor_of(needle, count));
+    }
+    if (size - count >= 16) {
+        return rfind_sse2(haystack, size, needle, count, anchor_of(needle, count));
+    }
+#endif
+    return rfind_scalar(haystack, size, needle, count);
+}
+
+/**
+ * @brief Finds the first byte whose membership in a set is wanted, one table lookup per byte
+ * @param member true to find a byte of the set, false a byte outside it
+ * @return Offset of the byte, kNotFound if none
+ */
+[[nodiscard]] inline auto find_first_of_scalar(const char* haystack, std::size_t size, const char_set& set,
+                                               bool member) noexcept -> std::size_t {
+    for (std::size_t offset = 0; offset < size; ++offset) {
+        if (set.contains(haystack[offset]) == member) {
+            return offset;
+        }
+    }
+    return kNotFound;
+}
+
+/// @brief find_first_of_scalar from the end
+[[nodiscard]] inline auto find_last_of_scalar(const char* haystack, std::size_t size, const char_set& set,
+                                              bool member) noexcept -> std::size_t {
+    while (size-- > 0) {
+        if (set.contains(haystack[size]) == member) {
+            return size;
+        }
+    }
+    return kNotFound;
+}
+
+#ifdef SMALL_STRING_X86_SIMD
+/// @brief Bit i set when byte i of a 32 bytes block is outside the set, the set should have nibble tables
+[[nodiscard, gnu::target("avx2"), gnu::always_inline]] inline auto outside_mask_avx2(__m256i block, __m256i low_table,
+                                                                                     __m256i high_table) noexcept
+  -> uint32_t {
+    const auto nibble = _mm256_set1_epi8(0x0f);
+    auto low_classes = _mm256_shuffle_epi8(low_table, _mm256_and_si256(block, nibble));
+    auto high_classes = _mm256_shuffle_epi8(high_table, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble));
+    auto classes = _mm256_and_si256(low_classes, high_classes);
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(classes, _mm256_setzero_si256())));
+}
+
+/// @brief find_first_of_scalar 32 bytes at a time, the set should have nibble tables
+[[nodiscard, gnu::target("avx2")]] inline auto find_first_of_avx2(const char* haystack, std::size_t size,
+                                                                  const char_set& set, bool member) noexcept
+  -> std::size_t {
+    const auto low_table =
+      _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.low_nibble_table())));
+    const auto high_table =
+      _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.high_nibble_table())));
+    const uint32_t flip = member ? ~uint32_t{0} : 0;
+    std::size_t offset = 0;
+    for (; offset + 32 <= size; offset += 32) {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + offset));
+        auto mask = outside_mask_avx2(block, low_table, high_table) ^ flip;
+        if (mask != 0) {
+            return offset + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+    auto found = find_first_of_scalar(haystack + offset, size - offset, set, member);
+    return found == kNotFound ? kNotFound : offset + found;
+}
+
+/// @brief find_last_of_scalar 32 bytes at a time, the set should have nibble tables
+[[nodiscard, gnu::target("avx2")]] inline auto find_last_of_avx2(const char* haystack, std::size_t size,
+                                                                 const char_set& set, bool member) noexcept
+  -> std::size_t {
+    const auto low_table =
+      _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.low_nibble_table())));
+    const auto high_table =
+      _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.high_nibble_table())));
+    const uint32_t flip = member ? ~uint32_t{0} : 0;
+    for (; size >= 32; size -= 32) {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + size - 32));
+        auto mask = outside_mask_avx2(block, low_table, high_table) ^ flip;
+        if (mask != 0) {
+            return size - 32 + static_cast<std::size_t>(31 - std::countl_zero(mask));
+        }
+    }
+    return find_last_of_scalar(haystack, size, set, member);
+}
+
+/// @brief Whether the CPU runs the AVX2 kernels, checked once
+[[nodiscard]] inline auto has_avx2() noexcept -> bool {
+    static const bool supported = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return supported;
+}
+#endif
+
+/**
+ * @brief Finds the first byte of a haystack in (member) or outside (not member) a set
+ * @return Offset of the byte, kNotFound if none
+ * @note Haystacks of at least a vector go to the AVX2 classifier when the set has nibble tables
+ */
+[[nodiscard]] inline auto find_first_of(const char* haystack, std::size_t size, const char_set& set,
+                                        bool member) noexcept -> std::size_t {
+#ifdef SMALL_STRING_X86_SIMD
+    if (size >= 32 and set.has_nibble_tables() and has_avx2()) {
+        return find_first_of_avx2(haystack, size, set, member);
+    }
+#endif
+    return find_first_of_scalar(haystack, size, set, member);
+}
+
+/// @brief find_first_of from the end
+[[nodiscard]] inline auto find_last_of(const char* haystack, std::size_t size, const char_set& set,
+                                       bool member) noexcept -> std::size_t {
+#ifdef SMALL_STRING_X86_SIMD
+    if (size >= 32 and set.has_nibble_tables() and has_avx2()) {
+        return find_last_of_avx2(haystack, size, set, member);
+    }
+#endif
+    return find_last_of_scalar(haystack, size, set, member);
+}
+
+/// Bytes a one-off set is probed char by char before its bit table is built
+inline constexpr std::size_t kCharsProbe = 16;
+
+/// Bytes a one-off set is scanned with its bit table before its nibble tables are built
+inline constexpr std::size_t kLazyNibbleBytes = 64;
+
+/**
+ * @brief find_first_of for a table_only set built for this one search
+ * @note Tokenizing mostly finds the next separator within a few bytes, building the nibble tables for them would
+ * cost more than the scan, so they are built only once the first kLazyNibbleBytes bytes missed
+ */
+[[nodiscard]] inline auto find_first_of_once(const char* haystack, std::size_t size, char_set& set,
+                                             bool member) noexcept -> std::size_t {
+    auto head = std::min(size, kLazyNibbleBytes);
+    auto found = find_first_of_scalar(haystack, head, set, member);
+    if (found != kNotFound or head == size) {
+        return found;
+    }
+    set.add_nibble_tables();
+    found = find_first_of(haystack + head, size - head, set, member);
+    return found == kNotFound ? kNotFound : head + found;
+}
+
+/// @brief find_first_of_once from the end
+[[nodiscard]] inline auto find_last_of_once(const char* haystack, std::size_t size, char_set& set,
+                                            bool member) noexcept -> std::size_t {
+    auto tail = std::min(size, kLazyNibbleBytes);
+    auto found = find_last_of_scalar(haystack + size - tail, tail, set, member);
+    if (found != kNotFound) {
+        return size - tail + found;
+    }
+    if (tail == size) {
+        return kNotFound;
+    }
+    set.add_nibble_tables();
+    return find_last_of(haystack, size - tail, set, member);
+}
+
+/**
+ * @brief Fills the skips of the bad byte rule, the distance from the last occurrence of each byte in needle[0, prefix)
+ * to the end of the needle, count for the bytes not in it
+ * @param prefix count - 1 for Horspool, which leaves the last byte out, count for two-way
+ */
+inline auto fill_shifts(const char* needle, std::size_t count, std::size_t prefix, uint32_t* shifts) noexcept -> void {
+    std::fill(shifts, shifts + 256, static_cast<uint32_t>(count));
+    for (std::size_t i = 0; i < prefix; ++i) {
+        shifts[static_cast<uint8_t>(needle[i])] = static_cast<uint32_t>(count - 1 - i);
+    }
+}
+
+/**
+ * @brief Finds a needle with Boyer-Moore-Horspool, skipping on the haystack byte under the last byte of the needle
+ * @param shifts Skips of needle[0, count - 1), see fill_shifts
+ * @return Offset of the first match, kNotFound if none
+ */
+[[nodiscard]] inline auto find_horspool(const char* haystack, std::size_t size, const char* needle, std::size_t count,
+                                        const uint32_t* shifts) noexcept -> std::size_t {
+    const auto last = count - 1;
+    const auto last_byte = needle[last];
+    for (std::size_t offset = 0; offset + count <= size;) {
+        auto byte = haystack[offset + last];
+        if (byte == last_byte and std::memcmp(haystack + offset, needle, last) == 0) {
+            return offset;
+        }
+        offset += shifts[static_cast<uint8_t>(byte)];
+    }
+    return kNotFound;
+}
+
+/**
+ * @brief Splits a needle where the two-way search starts comparing, at its critical factorization
+ * @param period Set to the period of the right half
+ * @return Length of the left half
+ * @note Crochemore and Perrin, the larger of the maximal suffixes for both byte orders
+ */
+[[nodiscard]] inline auto critical_factorization(const char* needle, std::size_t count, std::size_t& period) noexcept
+  -> std::size_t {
+    // the suffix starts at max + 1, max starts at -1 and wraps around
+    auto maximal_suffix = [needle, count](bool reverse, std::size_t& suffix_period) {
+        auto max = std::numeric_limits<std::size_t>::max();
+        std::size_t offset = 0;
+        std::size_t k = 1;
+        suffix_period = 1;
+        while (offset + k < count) {
+            auto a = static_cast<uint8_t>(needle[offset + k]);
+            auto b = static_cast<uint8_t>(needle[max + k]);
+            if (reverse ? b < a : a < b) {
+                offset += k;
+                k = 1;
+                suffix_period = offset - max;
+            } else if (a == b) {
+                if (k != suffix_period) {
+                    ++k;
+                } else {
+                    offset += suffix_period;
+                    k = 1;
+                }
+            } else {
+                max = offset++;
+                k = suffix_period = 1;
+            }
+        }
+        return max + 1;
+    };
+    std::size_t reverse_period = 0;
+    auto suffix = maximal_suffix(false, period);
+    auto reverse_suffix = maximal_suffix(true, reverse_period);
+    if (suffix >= reverse_suffix) {
+        return suffix;
+    }
+    period = reverse_period;
+    return reverse_suffix;
+}
+
+/**
+ * @brief Finds a needle with the two-way algorithm, linear in the haystack whatever the needle
+ * @param shifts Distance from the last occurrence of each byte in the needle to the end of the needle, count for the
+ * bytes not in it, windows whose last byte isn't the last byte of the needle are skipped on it first
+ * @param suffix Length of the left half, see critical_factorization
+ * @param period Period of the needle when periodic, the shift after a full right half match otherwise
+ * @param periodic Whether the left half repeats period bytes later, then matched prefixes are remembered
+ * @return Offset of the first match, kNotFound if none
+ */
+[[nodiscard]] inline auto find_two_way(const char* haystack, std::size_t size, const char* needle, std::size_t count,
+                                       const uint32_t* shifts, std::size_t suffix, std::size_t period,
+                                       bool periodic) noexcept -> std::size_t {
+    std::size_t memory = 0;
+    for (std::size_t offset = 0; offset + count <= size;) {
+        std::size_t shift = shifts[static_cast<uint8_t>(haystack[offset + count - 1])];
+        if (shift > 0) {
+            if (memory != 0 and shift < period) {
+                shift = count - period;
+            }
+            memory = 0;
+            offset += shift;
+            continue;
+        }
+        // the right half, the last byte is known to match
+        auto i = std::max(suffix, memory);
+        while (i < count - 1 and needle[i] == haystack[offset + i]) {
+            ++i;
+        }
+        if (i < count - 1) {
+            offset += i - suffix + 1;
+            memory = 0;
+            continue;
+        }
+        // the left half, down to what the previous window already matched
+        i = suffix;
+        while (i > memory and needle[i - 1] == haystack[offset + i - 1]) {
+            --i;
+        }
+        if (i <= memory) {
+            return offset;
+        }
+        offset += period;
+        memory = periodic ? count - period : 0;
+    }
+    return kNotFound;
+}
+
+}  // namespace search
+
+/**
+ * @brief A needle compiled once for many searches
+ * @note The algorithm follows the length of the needle: memchr for 1 byte, the filter of find up to kFilterMax
+ * bytes, Boyer-Moore-Horspool up to kHorspoolMax bytes and two-way above, which stays linear whatever the needle
+ * @note With the vector kernels the filter beats the scalar Horspool on text and on 4 letter alphabets up to 256
+ * bytes, Horspool only takes over from the memchr filter of the scalar builds, past 8 bytes
+ * @note Pass it to find on byte strings, or to std::search as a searcher
+ * @example
+ *   const small::searcher needle("Content-Length:");
+ *   auto pos = message.find(needle);
+ *   auto it = std::search(text.begin(), text.end(), needle);
+ */
+class searcher
+{
+   public:
+    /// @brief How a searcher finds its needle
+    enum class algorithm : uint8_t
+    {
+        empty,          ///< Found at the start position
+        memchr,         ///< 1 byte needle
+        filter,         ///< The first and anchor bytes tested a vector at a time, see search::find
+        horspool,       ///< Boyer-Moore-Horspool
+        two_way,        ///< Crochemore-Perrin two-way with a bad byte skip
+    };
+
+#ifdef SMALL_STRING_X86_SIMD
+    constexpr static std::size_t kFilterMax = 256;  ///< Longest needle of the filter
+#else
+    constexpr static std::size_t kFilterMax = 8;    ///< Longest needle of the filter
+#endif
+    constexpr static std::size_t kHorspoolMax = 256;  ///< Longest needle of Horspool
+
+    /// @brief Compiles the count bytes of needle, which are copied
+    searcher(const char* needle, std::size_t count) : _needle(needle, needle + count) {
+        Assert(count <= std::numeric_limits<uint32_t>::max(), "searcher: the needle should be shorter than 4 GiB");
+        if (count == 0) {
+            _algorithm = algorithm::empty;
+        } else if (count == 1) {
+            _algorithm = algorithm::memchr;
+        } else if (count <= kFilterMax) {
+            _algorithm = algorithm::filter;
+#ifdef SMALL_STRING_X86_SIMD
+            _anchor = search::anchor_of(needle, count);
+            _kernel = search::select_find();
+#endif
+        } else if (count <= kHorspoolMax) {
+            _algorithm = algorithm::horspool;
+            search::fill_shifts(needle, count, count - 1, _shifts);
+        } else {
+            _algorithm = algorithm::two_way;
+            search::fill_shifts(needle, count, count, _shifts);
+            _suffix = search::critical_factorization(needle, count, _period);
+            _periodic = std::memcmp(needle, needle + _period, _suffix) == 0;
+            if (not _periodic) {
+                _period = std::max(_suffix, count - _suffix) + 1;
+            }
+        }
+    }
+
+    /// @brief Compiles the bytes of a view
+    explicit searcher(std::string_view needle) : searcher(needle.data(), needle.size()) {}
+
+    [[nodiscard]] auto needle() const noexcept -> std::string_view { return {_needle.data(), _needle.size()}; }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return _needle.size(); }
+
+    [[nodiscard]] auto strategy() const noexcept -> algorithm { return _algorithm; }
+
+    /**
+     * @brief Finds the needle in size bytes
+     * @return Offset of the first match, search::kNotFound if none, 0 for an empty needle
+     */
+    [[nodiscard]] auto find(const char* haystack, std::size_t size) const noexcept -> std::size_t {
+        const auto count = _needle.size();
+        if (count > size) {
+            return search::kNotFound;
+        }
+        const auto* needle = _needle.data();
+        switch (_algorithm) {
+            case algorithm::empty:
+                return 0;
+            case algorithm::memchr: {
+                const auto* found = static_cast<const char*>(std::memchr(haystack, needle[0], size));
+                return found == nullptr ? search::kNotFound : static_cast<std::size_t>(found - haystack);
+            }
+            case algorithm::filter:
+#ifdef SMALL_STRING_X86_SIMD
+                if (size - count >= 64) {
+                    return _kernel(haystack, size, needle, count, _anchor);
+                }
+                if (size - count >= 16) {
+                    return search::find_sse2(haystack, size, needle, count, _anchor);
+                }
+#endif
+                return search::find_scalar(haystack, size, needle, count);
+            case algorithm::horspool:
+                return search::find_horspool(haystack, size, needle, count, _shifts);
+            case algorithm::two_way:
+                return search::find_two_way(haystack, size, needle, count, _shifts, _suffix, _period, _periodic);
+        }
+        return search::kNotFound;
+    }
+
+    /**
+     * @brief The std::search searcher interface
+     * @return The range of the first match, {last, last} if none
+     */
+    template <std::contiguous_iterator Iterator>
+        requires(sizeof(std::iter_value_t<Iterator>) == 1)
+    auto operator()(Iterator first, Iterator last) const -> std::pair<Iterator, Iterator> {
+        auto found =
+          find(reinterpret_cast<const char*>(std::to_address(first)), static_cast<std::size_t>(last - first));
+        if (found == search::kNotFound) {
+            return {last, last};
+        }
+        auto match = first + static_cast<std::iter_difference_t<Iterator>>(found);
+        return {match, match + static_cast<std::iter_difference_t<Iterator>>(_needle.size())};
+    }
+
+   private:
+    std::vector<char> _needle;                  ///< Copy of the needle
+    algorithm _algorithm = algorithm::empty;    ///< Picked from the length of the needle
+    bool _periodic = false;                     ///< two_way: whether the needle is periodic
+    std::size_t _suffix = 0;                    ///< two_way: length of the left half
+    std::size_t _period = 0;                    ///< two_way: shift after a full match of the right half
+#ifdef SMALL_STRING_X86_SIMD
+    std::size_t _anchor = 0;                    ///< filter: offset of the second byte tested
+    search::find_kernel _kernel = nullptr;      ///< filter: widest kernel the CPU runs
+#endif
+    uint32_t _shifts[256] = {};                 ///< horspool and two_way: skip on the last byte of a window
+};  // class searcher
+
+/**
+ * @brief A set of needles compiled into an Aho-Corasick automaton, found in one pass over a haystack
+ * @note The automaton is a dense DFA: every byte moves to the next state with one load, no failure link is followed
+ * while scanning. Bytes that appear in no pattern share one column of the table, so its width is the number of
+ * distinct pattern bytes plus one. State ids are premultiplied by that width and the states that end a pattern come
+ * first, so a match is a single compare against _match_limit
+ * @note Each pattern contributes its rarest byte (a heuristic on text frequencies) to a prefilter set. While the
+ * automaton is at the root, the AVX2 classifier of char_set jumps to the next rare byte and the scan restarts
+ * max_rare_offset bytes before it, any match has to contain one of them. The prefilter is kept when no rare byte is
+ * among the ten most common letters and the set fits the nibble tables with at most kRareBytesMax bytes, and dropped
+ * for the rest of a scan when it stops skipping
+ * @note Matches are reported in the order they end; among the matches ending at one byte, the longest comes first
+ * @example
+ *   const small::multi_searcher deny({"password", "secret", "token"});
+ *   if (message.find(deny) != small::small_string::npos) { ... }
+ *   for (auto m : deny.find_all(message)) { ... }
+ */
+class multi_searcher
+{
+   public:
+    /// @brief A pattern found in a haystack
+    struct match
+    {
+        std::size_t pattern;  ///< Index of the pattern in the list the searcher was built from
+        std::size_t offset;   ///< Offset of the first byte of the match
+        std::size_t length;   ///< Bytes of the pattern
+    };
+
+    constexpr static std::size_t kRareBytesMax = 16;  ///< Largest prefilter set
+
+    /**
+     * @brief Compiles the patterns of a range of string_view convertible items, empty patterns never match
+     * @throws std::length_error if there are 2^32 - 1 patterns or more, or the automaton outgrows 32-bit state ids
+     */
+    template <typename Iterator>
+    multi_searcher(Iterator first, Iterator last) {
+        std::vector<std::string_view> patterns;
+        for (; first != last; ++first) {
+            patterns.emplace_back(*first);
+        }
+        build(patterns);
+    }
+
+    /// @brief Compiles a list of patterns, see the range constructor for the limits
+    multi_searcher(std::initializer_list<std::string_view> patterns)
+        : multi_searcher(patterns.begin(), patterns.end()) {}
+
+    /// @brief Number of patterns, empty ones included
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return _lengths.size(); }
+
+    /// @brief Number of states of the automaton
+    [[nodiscard]] auto states() const noexcept -> std::size_t { return _outputs_of.size(); }
+
+    /// @brief Whether scans skip to the rare bytes of the patterns
+    [[nodiscard]] auto has_prefilter() const noexcept -> bool { return _prefilter; }
+
+    /**
+     * @brief Finds the match that ends first
+     * @return The match, its offset is search::kNotFound if there is none
+     */
+    [[nodiscard]] auto find_first(std::string_view haystack) const noexcept -> match {
+        match first{0, search::kNotFound, 0};
+        scan(haystack.data(), haystack.size(), [&first](const match& found) {
+            first = found;
+            return false;
+        });
+        return first;
+    }
+
+    /// @brief Finds every match, overlapping ones included
+    [[nodiscard]] auto find_all(std::string_view haystack) const -> std::vector<match> {
+        std::vector<match> matches;
+        scan(haystack.data(), haystack.size(), [&matches](const match& found) {
+            matches.push_back(found);
+            return true;
+        });
+        return matches;
+    }
+
+    /**
+     * @brief Calls on_match with every match until it returns false
+     * @param on_match Callable taking a const match& and returning bool, true to go on
+     */
+    template <typename OnMatch>
+    auto for_each_match(std::string_view haystack, OnMatch&& on_match) const -> void {
+        scan(haystack.data(), haystack.size(), std::forward<OnMatch>(on_match));
+    }
+
+   private:
+    constexpr static uint32_t kNone = std::numeric_limits<uint32_t>::max();
+    constexpr static int kCommonFrequency = 200;  ///< byte_frequency of the ten most common letters and above
+
+    /// @brief A link of the output lists, the states of a suffix chain share their tails
+    struct output
+    {
+        uint32_t pattern;  ///< Pattern ending here
+        uint32_t next;     ///< Next output of the list, kNone at its end
+    };
+
+    uint8_t _classes[256] = {};             ///< Column of each byte, 0 for the bytes of no pattern
+    uint32_t _stride = 0;                   ///< Columns of the table
+    uint32_t _root = 0;                     ///< Premultiplied id of the root
+    uint32_t _match_limit = 0;              ///< Premultiplied ids below it end a pattern
+    std::vector<uint32_t> _next;            ///< Premultiplied next state of each state and column
+    std::vector<uint32_t> _outputs_of;      ///< Head of the output list of each state
+    std::vector<output> _outputs;           ///< Output lists
+    std::vector<std::size_t> _lengths;      ///< Bytes of each pattern
+    char_set _rare;                         ///< Rarest byte of every pattern
+    std::size_t _max_rare_offset = 0;       ///< Furthest a rare byte is from the start of its pattern
+    bool _prefilter = false;                ///< Whether _rare is worth skipping to
+
+    /**
+     * @brief Rough frequency of a byte in text, higher is more common
+     * @note Space, then lowercase letters in English order, digits and common punctuation, uppercase letters, other
+     * printable bytes, control and non-ASCII bytes last
+     */
+    [[nodiscard]] constexpr static auto byte_frequency(uint8_t byte) noexcept -> int {
+        constexpr std::string_view lower = "etaoinshrdlcumwfgypbvkjxqz";
+        constexpr std::string_view punctuation = ".,-_/:'\"\n\t=()";
+        if (byte == ' ') {
+            return 255;
+        }
+        if (byte >= 'a' and byte <= 'z') {
+            return 250 - 5 * static_cast<int>(lower.find(static_cast<char>(byte)));
+        }
+        if ((byte >= '0' and byte <= '9') or punctuation.find(static_cast<char>(byte)) != std::string_view::npos) {
+            return 120;
+        }
+        if (byte >= 'A' and byte <= 'Z') {
+            return 100 - 2 * static_cast<int>(lower.find(static_cast<char>(byte - 'A' + 'a')));
+        }
+        return byte > 32 and byte < 127 ? 40 : 10;
+    }
+
+    auto build(const std::vector<std::string_view>& patterns) -> void {
+        if (patterns.size() >= kNone) [[unlikely]] {
+            throw std::length_error("multi_searcher: too many patterns");
+        }
+        _lengths.reserve(patterns.size());
+        bool used[256] = {};
+        for (auto pattern : patterns) {
+            _lengths.push_back(pattern.size());
+            for (auto ch : pattern) {
+                used[static_cast<uint8_t>(ch)] = true;
+            }
+        }
+        // a column for the bytes of no pattern, unless there are none
+        _stride = std::find(std::begin(used), std::end(used), false) == std::end(used) ? 0 : 1;
+        for (std::size_t byte = 0; byte < 256; ++byte) {
+            if (used[byte]) {
+                _classes[byte] = static_cast<uint8_t>(_stride++);
+            }
+        }
+
+        // the trie, kNone for the missing children, with the output lists of the patterns ending at each state
+        std::vector<uint32_t> next(_stride, kNone);
+        std::vector<uint32_t> outputs_of(1, kNone);
+        std::vector<char> rare_bytes;
+        for (std::size_t index = 0; index < patterns.size(); ++index) {
+            auto pattern = patterns[index];
+            if (pattern.empty()) {
+                continue;
+            }
+            std::size_t state = 0;
+            std::size_t rare = 0;
+            for (std::size_t i = 0; i < pattern.size(); ++i) {
+                auto byte = static_cast<uint8_t>(pattern[i]);
+                auto edge = state * _stride + _classes[byte];
+                if (next[edge] == kNone) {
+                    if (outputs_of.size() * _stride >= kNone) [[unlikely]] {
+                        throw std::length_error("multi_searcher: the automaton outgrew 32-bit ids");
+                    }
+                    next[edge] = static_cast<uint32_t>(outputs_of.size());
+                    outputs_of.push_back(kNone);
+                    next.resize(next.size() + _stride, kNone);
+                }
+                state = next[edge];
+                if (byte_frequency(byte) < byte_frequency(static_cast<uint8_t>(pattern[rare]))) {
+                    rare = i;
+                }
+            }
+            rare_bytes.push_back(pattern[rare]);
+            _max_rare_offset = std::max(_max_rare_offset, rare);
+            _outputs.push_back({static_cast<uint32_t>(index), outputs_of[state]});
+            outputs_of[state] = static_cast<uint32_t>(_outputs.size() - 1);
+        }
+
+        // breadth first, the failure state of a state is shallower and complete: missing children become the
+        // transitions of the failure state, and the output list continues with the one of the failure state
+        const auto count = outputs_of.size();
+        std::vector<uint32_t> fail(count, 0);
+        std::vector<uint32_t> queue;
+        queue.reserve(count);
+        for (std::size_t column = 0; column < _stride; ++column) {
+            auto& child = next[column];
+            if (child == kNone) {
+                child = 0;
+            } else {
+                queue.push_back(child);
+            }
+        }
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            auto state = queue[head];
+            auto failure = fail[state];
+            append_outputs(outputs_of[state], outputs_of[failure]);
+            if (outputs_of[state] == kNone) {
+                outputs_of[state] = outputs_of[failure];
+            }
+            for (std::size_t column = 0; column < _stride; ++column) {
+                auto& child = next[state * _stride + column];
+                auto fallback = next[failure * _stride + column];
+                if (child == kNone) {
+                    child = fallback;
+                } else {
+                    fail[child] = fallback;
+                    queue.push_back(child);
+                }
+            }
+        }
+
+        // renumbered: the states with outputs, then the root, then the rest, ids premultiplied by the stride
+        std::vector<uint32_t> order;
+        order.reserve(count);
+        for (std::size_t state = 1; state < count; ++state) {
+            if (outputs_of[state] != kNone) {
+                order.push_back(static_cast<uint32_t>(state));
+            }
+        }
+        _match_limit = static_cast<uint32_t>(order.size() * _stride);
+        _root = _match_limit;
+        order.push_back(0);
+        for (std::size_t state = 1; state < count; ++state) {
+            if (outputs_of[state] == kNone) {
+                order.push_back(static_cast<uint32_t>(state));
+            }
+        }
+        std::vector<uint32_t> renamed(count);
+        for (std::size_t id = 0; id < count; ++id) {
+            renamed[order[id]] = static_cast<uint32_t>(id * _stride);
+        }
+        _next.resize(next.size());
+        _outputs_of.resize(count);
+        for (std::size_t id = 0; id < count; ++id) {
+            auto state = order[id];
+            for (std::size_t column = 0; column < _stride; ++column) {
+                _next[id * _stride + column] = renamed[next[state * _stride + column]];
+            }
+            _outputs_of[id] = outputs_of[state];
+        }
+
+        _rare = char_set(rare_bytes.data(), rare_bytes.size());
+        _prefilter = not rare_bytes.empty() and _rare.size() <= kRareBytesMax and _rare.has_nibble_tables() and
+                     std::none_of(rare_bytes.begin(), rare_bytes.end(), [](char ch) {
+                         return byte_frequency(static_cast<uint8_t>(ch)) >= kCommonFrequency;
+                     });
+    }
+
+    /// @brief Links the end of the own outputs of a state to the list of its failure state
+    auto append_outputs(uint32_t own, uint32_t tail) noexcept -> void {
+        if (own == kNone or own == tail) {
+            return;
+        }
+        while (_outputs[own].next != kNone) {
+            own = _outputs[own].next;
+        }
+        _outputs[own].next = tail;
+    }
+
+    template <typename OnMatch>
+    auto scan(const char* haystack, std::size_t size, OnMatch&& on_match) const -> void {
+        auto prefilter = _prefilter;
+        std::size_t candidate = 0;  // the automaton runs from the root up to here before asking the prefilter again
+        std::size_t skips = 0;
+        std::size_t skipped = 0;
+        auto state = _root;
+        for (std::size_t offset = 0; offset < size; ++offset) {
+            if (state == _root and prefilter and offset >= candidate) {
+                auto found = search::find_first_of(haystack + offset, size - offset, _rare, true);
+                if (found == search::kNotFound) {
+                    return;
+                }
+                auto restart = offset + found - std::min(offset + found, _max_rare_offset);
+                candidate = offset + found + 1;
+                if (restart > offset) {
+                    skipped += restart - offset;
+                    offset = restart;
+                }
+                // a prefilter that keeps landing close by costs more than it skips
+                if (++skips == 64) {
+                    prefilter = skipped >= 64 * 8;
+                }
+            }
+            state = _next[state + _classes[static_cast<uint8_t>(haystack[offset])]];
+            if (state < _match_limit) [[unlikely]] {
+                for (auto link = _outputs_of[state / _stride]; link != kNone; link = _outputs[link].next) {
+                    auto pattern = _outputs[link].pattern;
+                    auto length = _lengths[pattern];
+                    if (not on_match(match{pattern, offset + 1 - length, length})) {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+};  // class multi_searcher
+
+/**
+ * @brief Buffer management class handling memory allocation for small string optimization
+ * @tparam Char Character type (char, wchar_t, etc.)
+ * @tparam Core Core storage type (malloc_core, wide_core, pooled_core or pmr_core)
+ * @tparam Traits Character traits (std::char_traits)
+ * @tparam Allocator Allocator type for memory management
+ * @tparam NullTerminated Whether strings maintain null termination
+ * @tparam Growth Growth policy for buffer reallocation (default geometric_growth<1.5F>)
+ * @tparam LongTier Where large Long buffers live (default heap_long_tier, alternative: mmap_long_tier)
+ * @note Manages all memory operations and storage strategy transitions
+ * @note Provides interface between string operations and core storage
+ */
+template <typename Char, template <typename, bool> typename Core, class Traits, class Allocator, bool NullTerminated,
+          class Growth = default_growth, class LongTier = heap_long_tier>
+class small_string_buffer
+{
+   protected:
+    /// Standard STL container type definitions for compatibility
+    using value_type = typename Traits::char_type;  ///< Character type from traits
+    using traits_type = Traits;                     ///< Character traits for operations
+    using allocator_type = Allocator;               ///< Memory allocator type
+    using size_type = typename Core<Char, NullTerminated>::size_type;  ///< Size/index type, 32-bit unless huge_core
+    using difference_type = typename std::allocator_traits<Allocator>::difference_type;  ///< Iterator difference type
+
+    /// Reference types for element access
+    using reference = typename std::allocator_traits<Allocator>::value_type&;              ///< Mutable reference
+    using const_reference = const typename std::allocator_traits<Allocator>::value_type&;  ///< Immutable reference
+    using pointer = typename std::allocator_traits<Allocator>::pointer;                    ///< Mutable pointer
+    using const_pointer = const typename std::allocator_traits<Allocator>::const_pointer;  ///< Immutable pointer
+
+    /// Iterator types for STL compatibility
+    using iterator = Char*;                                                ///< Mutable iterator (raw pointer)
+    using const_iterator = const Char*;                                    ///< Immutable iterator (raw pointer)
+    using reverse_iterator = std::reverse_iterator<iterator>;              ///< Reverse mutable iterator
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;  ///< Reverse immutable iterator
+
+    /// Standard "not found" position marker (maximum size_type value)
+    constexpr static size_t npos = std::numeric_limits<size_type>::max();
+
+    using core_type = Core<Char, NullTerminated>;  ///< Storage core (malloc_core or pmr_core)
+    static_assert(GrowthPolicy<Growth, size_type>, "Growth should be a growth policy, like geometric_growth<1.5F>");
+    static_assert(not LongTier::enabled or core_type::use_std_allocator::value,
+                  "the mapped Long tier bypasses the allocator, use it with the std allocator cores");
+    static_assert(not LongTier::enabled or not core_type::share_buffers::value,
+                  "the mapped Long tier has no room for the reference count of shared buffers");
+    static_assert(not LongTier::enabled or std::is_same_v<typename core_type::memory, process_memory>,
+                  "the mapped Long tier lives outside the memory of the core, like a shared segment");
+
+    /**
+     * @brief Enum indicating whether null termination is required
+     * @note Used to optimize operations when null termination isn't needed
+     */
+    enum class Need0 : bool
+    {
+        Yes = true,  ///< Null termination required
+        No = false   ///< Null termination not needed
+    };
+
+   private:
+    core_type _core;  ///< The actual storage core containing all string data and metadata
+
+    /**
+     * @brief Validates that the allocator is properly initialized
+     * @return true if allocator is valid, false otherwise
+     * @note For standard allocators always returns true, for PMR checks initialization
+     */
+    [[nodiscard]] auto check_the_allocator() const -> bool {
+        if constexpr (core_type::use_std_allocator::value) {
+            return true;
+        } else {
+            return _core.pmr_allocator != std::pmr::polymorphic_allocator<Char>{};
+        }
+    }
+
+    /**
+     * @brief Allocates the raw memory of an external buffer
+     * @param type_and_size Buffer configuration (type and size), buffer_size is raised to the usable size of a
+     * malloc'ed block
+     * @param allocator_ptr PMR allocator pointer, ignored by the std allocator cores
+     * @return Pointer to the beginning of the buffer
+     * @throws std::bad_alloc if the memory of the core or the allocator is exhausted, e.g. a full shared_segment
+     * @note Short buffers of pooled_core come from short_buffer_pool, large Long buffers from LongTier
+     */
+    [[nodiscard, gnu::always_inline]] static auto allocate_buffer(
+      buffer_type_and_size<size_type>& type_and_size,
+      [[maybe_unused]] std::pmr::polymorphic_allocator<Char>* allocator_ptr) -> void* {
+        void* buf = nullptr;
+        if constexpr (core_type::use_std_allocator::value) {
+            buf = allocate_std_buffer(type_and_size);
+        } else {
+            // buffer sizes are in bytes, a multiple of 8, the allocator counts chars
+            buf = allocator_ptr->allocate(type_and_size.buffer_size / sizeof(Char));
+        }
+        if constexpr (stats::enabled) {
+            stats::detail::count_allocation(type_and_size.core_type, type_and_size.buffer_size);
+        }
+        return buf;
+    }
+
+    /// @brief allocate_buffer of the std allocator cores, from the short pool, LongTier or the core's memory
+    [[nodiscard, gnu::always_inline]] static auto allocate_std_buffer(
+      buffer_type_and_size<size_type>& type_and_size) -> void* {
+        if constexpr (core_type::use_short_pool::value) {
+            if (type_and_size.core_type == CoreType::Short) {
+                return short_buffer_pool::allocate(type_and_size.buffer_size);
+            }
+        }
+        if constexpr (LongTier::enabled) {
+            if (is_mapped(type_and_size.core_type, type_and_size.buffer_size)) [[unlikely]] {
+                return LongTier::allocate(type_and_size.buffer_size);
+            }
+        }
+        auto prefix = refcount_prefix_of(type_and_size.core_type);
+        void* buf = core_type::memory::allocate(type_and_size.buffer_size + prefix);
+        if (buf == nullptr) [[unlikely]] {
+            throw std::bad_alloc();
+        }
+        harvest_usable_size(buf, type_and_size, prefix);
+        if constexpr (core_type::share_buffers::value) {
+            if (prefix != 0) {
+                std::construct_at(reinterpret_cast<std::atomic<uint32_t>*>(buf), 1U);
+                buf = reinterpret_cast<char*>(buf) + prefix;
+            }
+        }
+        return buf;
+    }
+
+    /**
+     * @brief Raises a buffer configuration to the usable size of the malloc'ed block behind it
+     * @param buf Block returned by the allocate or reallocate of the core's memory
+     * @param type_and_size Buffer configuration, buffer_size is raised in place
+     * @param prefix Bytes of the block in front of the buffer
+     * @note The allocator rounds up to its size classes anyway, so the slack becomes capacity instead of waste
+     * @note The slack stays within the tier: the 5 bits cap of Short, the 14 bits idle of Median, and below the
+     * LongTier threshold for Long, a buffer above it would be unmapped on release
+     */
+    [[gnu::always_inline]] static auto harvest_usable_size(
+      [[maybe_unused]] void* buf, [[maybe_unused]] buffer_type_and_size<size_type>& type_and_size,
+      [[maybe_unused]] std::size_t prefix = 0) noexcept -> void {
+#if defined(__linux__)
+        size_t limit = 0;
+        switch (type_and_size.core_type) {
+            case CoreType::Short:
+                limit = (core_type::max_short_buffer_size() + (NullTerminated ? 1 : 0)) * sizeof(Char);
+                break;
+            case CoreType::Median:
+                limit =
+                  core_type::max_median_buffer_size() * sizeof(Char) + core_type::median_long_buffer_header_size();
+                break;
+            default:
+                if constexpr (LongTier::enabled) {
+                    limit = LongTier::threshold - 1;
+                } else {
+                    limit = std::numeric_limits<size_type>::max();
+                }
+                break;
+        }
+        auto usable =
+          std::min(core_type::memory::usable_size(buf, type_and_size.buffer_size + prefix) - prefix, limit) & ~size_t{7};
+        if (usable > type_and_size.buffer_size) {
+            type_and_size.buffer_size = static_cast<size_type>(usable);
+        }
+#endif
+    }
+
+    /**
+     * @brief Releases the external buffer of the core
+     * @note The core must be external, the core itself is not reset
+     */
+    [[gnu::always_inline]] auto deallocate_buffer() noexcept -> void {
+        Assert(_core.is_external(), "only the external buffer can be deallocated");
+        if constexpr (core_type::arena_buffers::value) {
+            // the arena reclaims every buffer at once
+            return;
+        }
+        if constexpr (core_type::share_buffers::value) {
+            // the other owners keep the buffer alive, a view has no owner at all
+            if (_core.get_core_type() >= kIsMedian) {
+                if (_core.is_view()) {
+                    return;
+                }
+                auto* count = refcount();
+                if (count->load(std::memory_order_relaxed) != kUnshareable and
+                    count->fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                    return;
+                }
+            }
+        }
+        if constexpr (stats::enabled) {
+            stats::detail::count_deallocation(static_cast<CoreType>(_core.get_core_type()),
+                                              _core.external_buffer_size());
+        }
+        if constexpr (core_type::use_std_allocator::value) {
+            if constexpr (core_type::use_short_pool::value) {
+                if (_core.get_core_type() == kIsShort) [[likely]] {
+                    short_buffer_pool::deallocate(_core.external.get_buffer_ptr(), _core.external_buffer_size());
+                    return;
+                }
+            }
+            if constexpr (LongTier::enabled) {
+                if (_core.get_core_type() == kIsLong) {
+                    auto buffer_size = _core.external_buffer_size();
+                    if (is_mapped(CoreType::Long, buffer_size)) {
+                        LongTier::deallocate(_core.external.get_buffer_ptr(), buffer_size);
+                        return;
+                    }
+                }
+            }
+            auto prefix = refcount_prefix_of(static_cast<CoreType>(_core.get_core_type()));
+            core_type::memory::deallocate(reinterpret_cast<char*>(_core.external.get_buffer_ptr()) - prefix);
+        } else {
+            // the pool resources pick the pool by size, so pass the exact size of the allocation
+            _core.pmr_allocator.deallocate(_core.external.get_buffer_ptr(),
+                                           _core.external_buffer_size() / sizeof(Char));
+        }
+    }
+
+    /**
+     * @brief Checks whether a buffer of this type and size belongs to LongTier
+     * @param type Buffer type
+     * @param buffer_size Buffer size in bytes, header included
+     * @return true if the buffer is (or would be) mapped by LongTier
+     */
+    [[nodiscard, gnu::always_inline]] constexpr static auto is_mapped(CoreType type, std::size_t buffer_size) noexcept
+      -> bool {
+        if constexpr (LongTier::enabled) {
+            return type == CoreType::Long and buffer_size >= LongTier::threshold;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * @brief Returns the bytes in front of a buffer holding its reference count
+     * @param type Buffer type
+     * @return 8 for the Median/Long buffers of a sharing core, 0 otherwise
+     */
+    [[nodiscard, gnu::always_inline]] constexpr static auto refcount_prefix_of(CoreType type) noexcept -> std::size_t {
+        if constexpr (core_type::share_buffers::value) {
+            return type >= CoreType::Median ? 8 : 0;
+        } else {
+            return 0;
+        }
+    }
+
+    /**
+     * @brief Returns the reference count of the Median/Long buffer of a sharing core
+     * @return Pointer to the count, right in front of capacity_and_size
+     */
+    [[nodiscard, gnu::always_inline]] auto refcount() const noexcept -> std::atomic<uint32_t>* {
+        Assert(core_type::share_buffers::value and _core.get_core_type() >= kIsMedian and not _core.is_view(),
+               "only the Median/Long buffers of a sharing core have a reference count");
+        return reinterpret_cast<std::atomic<uint32_t>*>(reinterpret_cast<char*>(_core.external.get_buffer_ptr()) - 8);
+    }
+
+    /// Reference count of a buffer a pointer or reference was handed out for, it has one owner and is never shared
+    constexpr static uint32_t kUnshareable = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief Checks whether the buffer is shared with other strings
+     * @return true if another string refers to the buffer, so it must not be written
+     */
+    [[nodiscard, gnu::always_inline]] auto is_shared() const noexcept -> bool {
+        if constexpr (core_type::share_buffers::value) {
+            if (_core.get_core_type() < kIsMedian) {
+                return false;
+            }
+            // a view is never written
+            if (_core.is_view()) {
+                return true;
+            }
+            auto count = refcount()->load(std::memory_order_acquire);
+            return count != 1 and count != kUnshareable;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * @brief Unshares the buffer and keeps later copies from sharing it, before a pointer into it is handed out
+     * @note A pointer or reference taken from the string must not write into a copy made afterwards
+     */
+    [[gnu::always_inline]] auto prepare_leak() noexcept -> void {
+        if constexpr (core_type::share_buffers::value) {
+            prepare_write();
+            if (_core.get_core_type() >= kIsMedian) {
+                refcount()->store(kUnshareable, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Gives the string its own copy of a shared buffer, the copy-on-write step
+     * @param type_and_size Buffer to copy into, at least as large as the size
+     * @note A view fitting the Internal tier of the core is copied into the core itself
+     */
+    [[gnu::noinline]] auto unshare(buffer_type_and_size<size_type> type_and_size) -> void {
+        auto old_size = size();
+        if (type_and_size.core_type == CoreType::Internal) [[unlikely]] {
+            core_type copy;
+            std::memcpy(copy.internal.data, _core.begin_ptr(), old_size * sizeof(Char));
+            deallocate_buffer();
+            _core.body = copy.body;
+            _core.set_size_and_idle_and_set_term(old_size);
+            return;
+        }
+        auto new_external = allocate_new_external_buffer(type_and_size, old_size);
+        std::memcpy(new_external.c_str(), _core.begin_ptr(), old_size * sizeof(Char));
+        if constexpr (NullTerminated) {
+            new_external.c_str()[old_size] = '\0';
+        }
+        // drops the reference, the other owners keep the buffer
+        deallocate_buffer();
+        _core.external = new_external;
+    }
+
+    /**
+     * @brief Unshares the buffer before it is written, keeping the capacity
+     * @note noexcept as the accessors calling it are, only the sharing cores unshare and they allocate from the process
+     * heap, so a failed copy terminates like any other out-of-memory inside a noexcept accessor
+     */
+    [[gnu::always_inline]] auto prepare_write() noexcept -> void {
+        if constexpr (core_type::share_buffers::value) {
+            if (is_shared()) [[unlikely]] {
+                unshare(calculate_new_buffer_size(capacity()));
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the PMR allocator of the core
+     * @return Pointer to the allocator, nullptr for the std allocator cores
      */
-    [[nodiscard]] auto check_the_allocator() const -> bool {
+    [[nodiscard, gnu::always_inline]] auto pmr_allocator_ptr() noexcept -> std::pmr::polymorphic_allocator<Char>* {
         if constexpr (core_type::use_std_allocator::value) {
-            return true;
+            return nullptr;
         } else {
-            return _core.pmr_allocator != std::pmr::polymorphic_allocator<Char>{};
+            return &_core.pmr_allocator;
         }
     }
 
     /**
-     * @brief Calculates remaining capacity in median/long buffers after accounting for headers
-     * @param buffer_size Total allocated buffer size
-     * @param old_size Current string size
-     * @return Available idle capacity for growth
-     * @note Accounts for buffer headers and null termination if enabled
-     */
-    [[nodiscard, gnu::always_inline]] constexpr static inline auto calculate_median_long_real_idle_capacity(
-      size_type buffer_size, size_type old_size) noexcept -> size_type {
-        if constexpr (NullTerminated) {
-            Assert(buffer_size >= sizeof(struct capacity_and_size<size_type>) + 1 + old_size,
-                   "the buffer_size should be no less than the size of the buffer header and the old size");
-            return buffer_size - static_cast<size_type>(sizeof(struct capacity_and_size<size_type>)) - 1 - old_size;
+     * @brief Grows a Median/Long buffer in place with the reallocate of the core's memory, std::realloc by default
+     * @tparam Term Whether to add null termination
+     * @param type_and_size New buffer configuration, Median or Long
+     * @return true if the buffer was reallocated, false if the caller should allocate and copy itself
+     * @note Only for the std allocator cores, glibc may extend the block in place or mremap a large one
+     * @note Median and Long share the capacity_and_size header, so Median can grow into Long too
+     * @note A LongTier buffer only grows with LongTier::reallocate, crossing the threshold is left to the caller
+     */
+    template <Need0 Term>
+    [[nodiscard]] auto try_reallocate_buffer(buffer_type_and_size<size_type> type_and_size) -> bool {
+        if constexpr (core_type::use_std_allocator::value) {
+            if (_core.get_core_type() < kIsMedian or type_and_size.core_type < CoreType::Median) {
+                return false;
+            }
+            auto old_size = size();
+            auto old_type = static_cast<CoreType>(_core.get_core_type());
+            auto old_buffer_size = _core.external_buffer_size();
+            bool mapped = false;
+            if constexpr (LongTier::enabled) {
+                mapped = old_type == CoreType::Long and is_mapped(CoreType::Long, old_buffer_size);
+                if (mapped != is_mapped(type_and_size.core_type, type_and_size.buffer_size)) {
+                    return false;
+                }
+            }
+            void* buf = nullptr;
+            if (mapped) {
+                if constexpr (LongTier::enabled) {
+                    buf = LongTier::reallocate(_core.external.get_buffer_ptr(), old_buffer_size,
+                                               type_and_size.buffer_size);
+                }
+            } else {
+                // a shared buffer is unshared before it grows, so the reference count moves along with the block
+                auto prefix = refcount_prefix_of(CoreType::Median);
+                buf = core_type::memory::reallocate(reinterpret_cast<char*>(_core.external.get_buffer_ptr()) - prefix,
+                                                    type_and_size.buffer_size + prefix);
+                if (buf != nullptr) [[likely]] {
+                    harvest_usable_size(buf, type_and_size, prefix);
+                    buf = reinterpret_cast<char*>(buf) + prefix;
+                }
+            }
+            if (buf == nullptr) [[unlikely]] {
+                // the old buffer is still valid
+                return false;
+            }
+            if constexpr (stats::enabled) {
+                stats::detail::count_reallocation(old_type, old_buffer_size, type_and_size.core_type,
+                                                  type_and_size.buffer_size);
+            }
+            auto* head = reinterpret_cast<capacity_and_size<size_type>*>(buf);
+            head->capacity = type_and_size.buffer_size;
+            if constexpr (NullTerminated and Term == Need0::Yes) {
+                reinterpret_cast<Char*>(head + 1)[old_size] = '\0';
+            }
+            _core.external = core_type::median_long_external_of(head, static_cast<uint8_t>(type_and_size.core_type));
+            if constexpr (core_type::share_buffers::value) {
+                // growing invalidates the pointers handed out before, so an unshareable buffer can be shared again
+                refcount()->store(1, std::memory_order_relaxed);
+            }
+            return true;
         } else {
-            Assert(buffer_size >= sizeof(struct capacity_and_size<size_type>) + old_size,
-                   "the buffer_size should be no less than the size of the buffer header and the old size");
-            return buffer_size - static_cast<size_type>(sizeof(struct capacity_and_size<size_type>)) - old_size;
+            return false;
         }
     }
 
@@ -973,10 +3955,9 @@ class small_string_buffer
      */
     inline static auto allocate_new_external_buffer(
       struct buffer_type_and_size<size_type> type_and_size, size_type old_str_size,
-      std::pmr::polymorphic_allocator<Char>* allocator_ptr = nullptr) noexcept -> typename core_type::external_core {
+      std::pmr::polymorphic_allocator<Char>* allocator_ptr = nullptr) -> typename core_type::external_core {
         // make sure the old_str_size <= new_buffer_size
         auto type = type_and_size.core_type;
-        auto new_buffer_size = type_and_size.buffer_size;
         #pragma GCC diagnostic push
         #pragma GCC diagnostic ignored "-Wconversion"
 
@@ -988,44 +3969,22 @@ class small_string_buffer
             }
             case CoreType::Short: {
                 Assert(type_and_size.buffer_size % 8 == 0, "the buffer_size should be aligned to 8");
-                void* buf = nullptr;
-                if constexpr (core_type::use_std_allocator::value) {
-                    buf = std::malloc(new_buffer_size);
-                } else {
-                    buf = allocator_ptr->allocate(new_buffer_size);
-                }
-                return {.c_str_ptr = reinterpret_cast<int64_t>(buf),
+                void* buf = allocate_buffer(type_and_size, allocator_ptr);
+                return {.c_str_ptr = core_type::stored_address_of(buf),
                         .cap_size = {.cap = static_cast<uint8_t>(type_and_size.buffer_size / 8 - 1),
                                      .size = static_cast<uint16_t>(old_str_size),
                                      .flag = kIsShort}};
             }
-            case CoreType::Median: {
-                void* buf = nullptr;
-                if constexpr (core_type::use_std_allocator::value) {
-                    buf = std::malloc(new_buffer_size);
-                } else {
-                    buf = allocator_ptr->allocate(new_buffer_size);
-                }
-                auto* head = reinterpret_cast<capacity_and_size<size_type>*>(buf);
-                head->capacity = new_buffer_size;
-                head->size = old_str_size;
-                return {.c_str_ptr = reinterpret_cast<int64_t>(head + 1),
-                        .idle = {.idle_or_ignore = static_cast<uint16_t>(
-                                   calculate_median_long_real_idle_capacity(new_buffer_size, old_str_size)),
-                                 .flag = kIsMedian}};
-            }
+            case CoreType::Median:
             case CoreType::Long: {
-                void* buf = nullptr;
-                if constexpr (core_type::use_std_allocator::value) {
-                    buf = std::malloc(new_buffer_size);
-                } else {
-                    buf = allocator_ptr->allocate(new_buffer_size);
-                }
+                void* buf = allocate_buffer(type_and_size, allocator_ptr);
                 auto* head = reinterpret_cast<capacity_and_size<size_type>*>(buf);
-                head->capacity = new_buffer_size;
+                head->capacity = type_and_size.buffer_size;
                 head->size = old_str_size;
-                return {.c_str_ptr = reinterpret_cast<int64_t>(head + 1),
-                        .idle = {.idle_or_ignore = 0, .flag = kIsLong}};
+                Assert(type_and_size.buffer_size >=
+                         core_type::median_long_buffer_header_size() + old_str_size * sizeof(Char),
+                       "the buffer_size should be no less than the size of the buffer header and the old size");
+                return core_type::median_long_external_of(head, static_cast<uint8_t>(type));
                 #pragma GCC diagnostic pop
             }
             default:
@@ -1045,35 +4004,101 @@ class small_string_buffer
         if (size <= core_type::internal_buffer_size()) [[unlikely]] {
             return {.buffer_size = core_type::internal_buffer_size(), .core_type = CoreType::Internal};
         }
+        // buffer sizes are in bytes, sizes and capacities in chars
         if (size <= core_type::max_short_buffer_size()) [[likely]] {
             if constexpr (NullTerminated) {
-                return {.buffer_size = static_cast<size_type>(AlignUpTo<8>(size + 1)), .core_type = CoreType::Short};
+                return {.buffer_size = static_cast<size_type>(AlignUpTo<8>((size + 1) * sizeof(Char))),
+                        .core_type = CoreType::Short};
             } else {
-                return {.buffer_size = static_cast<size_type>(AlignUpTo<8>(size)), .core_type = CoreType::Short};
+                return {.buffer_size = static_cast<size_type>(AlignUpTo<8>(size * sizeof(Char))),
+                        .core_type = CoreType::Short};
             }
         }
         if (size <= core_type::max_median_buffer_size()) [[likely]] {  // faster than 3-way compare
-            return {
-              .buffer_size = static_cast<size_type>(AlignUpTo<8>(size + core_type::median_long_buffer_header_size())),
-              .core_type = CoreType::Median};
+            return {.buffer_size = static_cast<size_type>(
+                      AlignUpTo<8>(size * sizeof(Char) + core_type::median_long_buffer_header_size())),
+                    .core_type = CoreType::Median};
         }
         Assert(size <= core_type::max_long_buffer_size(),
                "the buffer size should be less than the max value of size_type");
-        return {.buffer_size = static_cast<size_type>(AlignUpTo<8>(size + core_type::median_long_buffer_header_size())),
+        return {.buffer_size = static_cast<size_type>(
+                  AlignUpTo<8>(size * sizeof(Char) + core_type::median_long_buffer_header_size())),
                 .core_type = CoreType::Long};
     }
 
     /**
-     * @brief Calculates buffer size with growth factor applied
-     * @param size Base string size
-     * @param growth Growth multiplier (e.g., 1.5 for 50% growth)
-     * @return Buffer configuration for grown capacity
+     * @brief Smallest buffer holding size chars, clamped to the largest Long buffer
+     * @param size String size
+     * @return Buffer configuration holding size
+     */
+    [[nodiscard]] constexpr static auto fit_size(size_t size) noexcept -> buffer_type_and_size<size_type> {
+        return calculate_new_buffer_size(std::min<size_t>(size, core_type::max_long_buffer_size()));
+    }
+
+    /**
+     * @brief Largest external buffer of at most buffer_size bytes
+     * @param buffer_size Buffer size in bytes, rounded down to 8
+     * @return Buffer configuration, the tier follows from the capacity of the buffer
+     */
+    [[nodiscard]] constexpr static auto fit_buffer(size_t buffer_size) noexcept -> buffer_type_and_size<size_type> {
+        constexpr size_t kMaxShortBufferSize =
+          (core_type::max_short_buffer_size() + (NullTerminated ? 1 : 0)) * sizeof(Char);
+        constexpr size_t kMaxBufferSize = std::numeric_limits<size_type>::max() & ~size_t{7};
+        buffer_size = std::min(buffer_size, kMaxBufferSize) & ~size_t{7};
+        if (buffer_size <= kMaxShortBufferSize) {
+            return {.buffer_size = static_cast<size_type>(buffer_size), .core_type = CoreType::Short};
+        }
+        auto capacity = core_type::median_long_capacity_of(static_cast<size_type>(buffer_size));
+        return {.buffer_size = static_cast<size_type>(buffer_size),
+                .core_type = capacity <= core_type::max_median_buffer_size() ? CoreType::Median : CoreType::Long};
+    }
+
+    /**
+     * @brief Asks a shrinking growth policy for the buffer to move to after the size dropped
+     * @param new_size String size after the erase
+     * @param shrunk Set to the buffer configuration to move to
+     * @return Whether the buffer should move, false keeps the current buffer
+     */
+    [[nodiscard, gnu::always_inline]] auto calculate_shrunk_buffer_size(
+      size_t new_size, buffer_type_and_size<size_type>& shrunk) const noexcept -> bool {
+        static_assert(ShrinkPolicy<Growth, size_type>, "only a shrinking growth policy gives capacity back");
+        auto type = static_cast<CoreType>(_core.get_core_type());
+        if (type == CoreType::Internal) {
+            return false;
+        }
+        buffer_type_and_size<size_type> current{.buffer_size = _core.external_buffer_size(), .core_type = type};
+        shrunk = Growth::shrink(basic_shrink_request<size_type>{
+          .current = current, .new_size = new_size, .char_size = sizeof(Char), .fit_size = &fit_size});
+        // a policy may only shrink the buffer, and never below new_size
+        auto minimum = fit_size(new_size);
+        return (shrunk.core_type < type or (shrunk.core_type == type and shrunk.buffer_size < current.buffer_size)) and
+               (shrunk.core_type > minimum.core_type or
+                (shrunk.core_type == minimum.core_type and shrunk.buffer_size >= minimum.buffer_size));
+    }
+
+    /**
+     * @brief Asks the growth policy for the buffer to grow into
+     * @param old_size String size before growing
+     * @param new_size Size the grown buffer must hold
+     * @return Buffer configuration for grown capacity, never smaller than the one new_size needs
      * @note Used when reallocating for capacity expansion
      */
-    [[nodiscard, gnu::always_inline]] constexpr static inline auto calculate_new_buffer_size(size_t size,
-                                                                                             float growth) noexcept
+    [[nodiscard, gnu::always_inline]] auto calculate_grown_buffer_size(size_t old_size, size_t new_size) const noexcept
       -> buffer_type_and_size<size_type> {
-        return calculate_new_buffer_size(static_cast<size_t>(static_cast<float>(size) * growth));
+        auto minimum = fit_size(new_size);
+        auto grown = Growth::grow(basic_growth_request<size_type>{
+          .old_size = old_size,
+          .old_tier = static_cast<CoreType>(_core.get_core_type()),
+          .new_size = new_size,
+          .minimum = minimum,
+          .fit_size = &fit_size,
+          .fit_buffer = &fit_buffer});
+        // a policy may only grow the buffer, a tier has more capacity than any buffer of a lower tier
+        if (grown.core_type < minimum.core_type or
+            (grown.core_type == minimum.core_type and grown.buffer_size < minimum.buffer_size)) [[unlikely]] {
+            return minimum;
+        }
+        return grown;
     }
 
     /**
@@ -1090,9 +4115,8 @@ class small_string_buffer
      * @note Optimized path - caller must ensure cap_and_type is valid for size
      * @note Handles Internal, Short, Median, and Long buffer allocation strategies
      */
-    constexpr void initial_allocate(buffer_type_and_size<size_type> cap_and_type, size_type size) noexcept {
+    constexpr void initial_allocate(buffer_type_and_size<size_type> cap_and_type, size_type size) {
         auto type = cap_and_type.core_type;
-        auto new_buffer_size = cap_and_type.buffer_size;
         #pragma GCC diagnostic push
         #pragma GCC diagnostic ignored "-Wconversion"
         switch (type) {
@@ -1104,56 +4128,27 @@ class small_string_buffer
                 }
                 break;
             case CoreType::Short: {
-                Assert(new_buffer_size % 8 == 0, "the buffer_size should be aligned to 8");
-                void* buf = nullptr;
-                if constexpr (core_type::use_std_allocator::value) {
-                    buf = std::malloc(new_buffer_size);
-                } else {
-                    buf = _core.pmr_allocator.allocate(new_buffer_size);
-                }
+                Assert(cap_and_type.buffer_size % 8 == 0, "the buffer_size should be aligned to 8");
+                void* buf = allocate_buffer(cap_and_type, pmr_allocator_ptr());
                 if constexpr (NullTerminated) {
                     reinterpret_cast<Char*>(buf)[size] = '\0';
                 }
-                _core.external = {.c_str_ptr = reinterpret_cast<int64_t>(buf),
-                                  .cap_size = {.cap = static_cast<uint8_t>(new_buffer_size / 8 - 1),
+                _core.external = {.c_str_ptr = core_type::stored_address_of(buf),
+                                  .cap_size = {.cap = static_cast<uint8_t>(cap_and_type.buffer_size / 8 - 1),
                                                .size = static_cast<uint16_t>(size),
                                                .flag = kIsShort}};
                 break;
             }
-            case CoreType::Median: {
-                void* buf = nullptr;
-                if constexpr (core_type::use_std_allocator::value) {
-                    buf = std::malloc(new_buffer_size);
-                } else {
-                    buf = _core.pmr_allocator.allocate(new_buffer_size);
-                }
-                auto* head = reinterpret_cast<capacity_and_size<size_type>*>(buf);
-                head->capacity = new_buffer_size;
-                head->size = size;
-                if constexpr (NullTerminated) {
-                    reinterpret_cast<Char*>(buf)[size + sizeof(struct capacity_and_size<size_type>)] = '\0';
-                }
-                _core.external = {.c_str_ptr = reinterpret_cast<int64_t>(head + 1),
-                                  .idle = {.idle_or_ignore = static_cast<uint16_t>(
-                                             calculate_median_long_real_idle_capacity(new_buffer_size, size)),
-                                           .flag = kIsMedian}};
-                break;
-            }
+            case CoreType::Median:
             case CoreType::Long: {
-                void* buf = nullptr;
-                if constexpr (core_type::use_std_allocator::value) {
-                    buf = std::malloc(new_buffer_size);
-                } else {
-                    buf = _core.pmr_allocator.allocate(new_buffer_size);
-                }
+                void* buf = allocate_buffer(cap_and_type, pmr_allocator_ptr());
                 auto* head = reinterpret_cast<capacity_and_size<size_type>*>(buf);
-                head->capacity = new_buffer_size;
+                head->capacity = cap_and_type.buffer_size;
                 head->size = size;
                 if constexpr (NullTerminated) {
-                    reinterpret_cast<Char*>(buf)[size + sizeof(struct capacity_and_size<size_type>)] = '\0';
+                    reinterpret_cast<Char*>(head + 1)[size] = '\0';
                 }
-                _core.external = {.c_str_ptr = reinterpret_cast<int64_t>(head + 1),
-                                  .idle = {.idle_or_ignore = 0, .flag = kIsLong}};
+                _core.external = core_type::median_long_external_of(head, static_cast<uint8_t>(type));
                 break;
                 #pragma GCC diagnostic pop
             }
@@ -1166,7 +4161,7 @@ class small_string_buffer
      * @param new_string_size Size of string to allocate space for
      * @note Automatically determines best buffer type and size for given capacity
      */
-    [[gnu::always_inline]] constexpr inline void initial_allocate(size_t new_string_size) noexcept {
+    [[gnu::always_inline]] constexpr inline void initial_allocate(size_t new_string_size) {
         // Assert(new_string_size <= std::numeric_limits<size_type>::max(),
         Assert(new_string_size < core_type::max_long_buffer_size(),
                "the new_string_size should be less than the max value of size_type");
@@ -1182,7 +4177,16 @@ class small_string_buffer
      * @note Uses growth factor to reduce future reallocations
      */
     template <Need0 Term = Need0::Yes>
-    void allocate_more(size_type new_append_size) noexcept {
+    void allocate_more(size_type new_append_size) {
+        if constexpr (core_type::share_buffers::value) {
+            if (is_shared()) [[unlikely]] {
+                auto [old_cap, old_size] = get_capacity_and_size();
+                unshare(old_cap - old_size >= new_append_size
+                          ? calculate_new_buffer_size(old_cap)
+                          : calculate_grown_buffer_size(old_size, old_size + new_append_size));
+                return;
+            }
+        }
         size_type old_delta = _core.idle_capacity();
 
         // if no need, do nothing, just update the size or delta
@@ -1191,32 +4195,34 @@ class small_string_buffer
             return;
         }
         auto old_size = size();
+        auto new_buffer_type_and_size = calculate_grown_buffer_size(old_size, old_size + new_append_size);
+        if constexpr (stats::enabled) {
+            stats::detail::count_transition(static_cast<CoreType>(_core.get_core_type()),
+                                            new_buffer_type_and_size.core_type);
+        }
+        // Median/Long growth of malloc'ed buffers, let realloc avoid the copy if it can
+        if (try_reallocate_buffer<Term>(new_buffer_type_and_size)) {
+            return;
+        }
         // if need allocate a new buffer, always a external_buffer
         // do the allocation
         typename core_type::external_core new_external;
         if constexpr (core_type::use_std_allocator::value) {
-            new_external =
-              allocate_new_external_buffer(calculate_new_buffer_size(old_size + new_append_size, Growth), old_size);
+            new_external = allocate_new_external_buffer(new_buffer_type_and_size, old_size);
 
         } else {
-            new_external = allocate_new_external_buffer(calculate_new_buffer_size(old_size + new_append_size, Growth),
-                                                        old_size, &_core.pmr_allocator);
+            new_external = allocate_new_external_buffer(new_buffer_type_and_size, old_size, &_core.pmr_allocator);
         }
 
         // copy the old data to the new buffer
-        std::memcpy(reinterpret_cast<Char*>(new_external.c_str_ptr), get_buffer(), old_size);
+        std::memcpy(new_external.c_str(), get_buffer(), old_size * sizeof(Char));
         // set the '\0' at the end of the buffer if needed;
         if constexpr (NullTerminated and Term == Need0::Yes) {
-            reinterpret_cast<Char*>(new_external.c_str_ptr)[old_size] = '\0';
+            new_external.c_str()[old_size] = '\0';
         }
         // deallocate the old buffer
         if (_core.is_external()) [[likely]] {
-            if constexpr (core_type::use_std_allocator::value) {
-                std::free(_core.external.get_buffer_ptr());
-            } else {
-                // the size is not used, so just set it to 0
-                _core.pmr_allocator.deallocate(_core.external.get_buffer_ptr(), 0);
-            }
+            deallocate_buffer();
         }
         // replace the old external with the new one
         _core.external = new_external;
@@ -1232,39 +4238,50 @@ class small_string_buffer
      */
     template <Need0 Term, bool NeedCopy>
     constexpr auto buffer_reserve(size_type new_cap) -> void {
+        if constexpr (core_type::share_buffers::value) {
+            if (is_shared()) [[unlikely]] {
+                unshare(calculate_new_buffer_size(std::max<size_type>(new_cap, capacity())));
+            }
+        }
 #ifndef NDEBUG
         auto origin_core_type = _core.get_core_type();
 #endif
         // check the new_cap is larger than the internal capacity, and larger than current cap
         auto [old_cap, old_size] = get_capacity_and_size();
         if (new_cap > old_cap) [[likely]] {
-            // no growth was needed
-            typename core_type::external_core new_external;
-
             auto new_buffer_type_and_size = calculate_new_buffer_size(new_cap);
-            // allocate a new buffer
-            if constexpr (core_type::use_std_allocator::value) {
-                new_external = allocate_new_external_buffer(new_buffer_type_and_size, old_size);
-            } else {
-                new_external = allocate_new_external_buffer(new_buffer_type_and_size, old_size, &_core.pmr_allocator);
+            if constexpr (stats::enabled) {
+                stats::detail::count_transition(static_cast<CoreType>(_core.get_core_type()),
+                                                new_buffer_type_and_size.core_type);
             }
+            // the content is kept, so Median/Long malloc'ed buffers may grow with realloc
+            bool reallocated = false;
             if constexpr (NeedCopy) {
-                // copy the old data to the new buffer
-                std::memcpy(reinterpret_cast<Char*>(new_external.c_str_ptr), get_buffer(), old_size);
+                reallocated = try_reallocate_buffer<Term>(new_buffer_type_and_size);
             }
-            if constexpr (NullTerminated and Term == Need0::Yes and NeedCopy) {
-                reinterpret_cast<Char*>(new_external.c_str_ptr)[old_size] = '\0';
-            }
-            // deallocate the old buffer
-            if (_core.is_external()) [[likely]] {
+            if (not reallocated) {
+                typename core_type::external_core new_external;
+                // allocate a new buffer
                 if constexpr (core_type::use_std_allocator::value) {
-                    std::free(_core.external.get_buffer_ptr());
+                    new_external = allocate_new_external_buffer(new_buffer_type_and_size, old_size);
                 } else {
-                    _core.pmr_allocator.deallocate(_core.external.get_buffer_ptr(), 0);
+                    new_external =
+                      allocate_new_external_buffer(new_buffer_type_and_size, old_size, &_core.pmr_allocator);
+                }
+                if constexpr (NeedCopy) {
+                    // copy the old data to the new buffer
+                    std::memcpy(new_external.c_str(), get_buffer(), old_size * sizeof(Char));
+                }
+                if constexpr (NullTerminated and Term == Need0::Yes and NeedCopy) {
+                    new_external.c_str()[old_size] = '\0';
+                }
+                // deallocate the old buffer
+                if (_core.is_external()) [[likely]] {
+                    deallocate_buffer();
                 }
+                // replace the old external with the new one
+                _core.external = new_external;
             }
-            // replace the old external with the new one
-            _core.external = new_external;
         }
 #ifndef NDEBUG
         auto new_core_type = _core.get_core_type();
@@ -1281,6 +4298,8 @@ class small_string_buffer
     // increase the size, and won't change the capacity, so the internal/exteral'type or ptr will not change
     // you should always call the allocate_new_external_buffer first, then call this function
     [[gnu::always_inline]] inline void increase_size(size_type delta) noexcept {
+        // a borrowed text may move to another tier when it is copied
+        prepare_write();
 #ifndef NDEBUG
         auto origin_core_type = _core.get_core_type();
 #endif
@@ -1292,6 +4311,8 @@ class small_string_buffer
     }
 
     [[gnu::always_inline]] inline void set_size(size_type new_size) noexcept {
+        // a borrowed text may move to another tier when it is copied
+        prepare_write();
 #ifndef NDEBUG
         auto origin_core_type = _core.get_core_type();
 #endif
@@ -1303,6 +4324,8 @@ class small_string_buffer
     }
 
     [[gnu::always_inline]] inline void decrease_size(size_type delta) noexcept {
+        // a borrowed text may move to another tier when it is copied
+        prepare_write();
 #ifndef NDEBUG
         auto origin_core_type = _core.get_core_type();
 #endif
@@ -1339,19 +4362,19 @@ class small_string_buffer
 #endif
     }
 
-    ~small_string_buffer() noexcept {
-        if constexpr (core_type::use_std_allocator::value) {
-            if (_core.is_external()) [[likely]] {
-                std::free(reinterpret_cast<void*>(_core.external.get_buffer_ptr()));
-            }
-        } else {
-            if (_core.is_external()) [[likely]] {
-                // the size is not used, so just set it to 0
-                _core.pmr_allocator.deallocate(_core.external.get_buffer_ptr(), 0);
-            }
+    ~small_string_buffer() noexcept
+        requires(not core_type::arena_buffers::value)
+    {
+        if (_core.is_external()) [[likely]] {
+            deallocate_buffer();
         }
     }
 
+    /// The buffers of an arena core are released with the arena, the destructor is trivial
+    ~small_string_buffer() noexcept
+        requires(core_type::arena_buffers::value)
+    = default;
+
     /**
      * @brief Swaps buffer contents with another buffer
      * @param other Buffer to swap with
@@ -1360,17 +4383,87 @@ class small_string_buffer
      */
     constexpr auto swap(small_string_buffer& other) noexcept -> void { _core.swap(other._core); }
 
+    /**
+     * @brief Makes this empty buffer refer to the Median/Long buffer of other, for the copies of a sharing core
+     * @param other Buffer to share
+     * @return true if the buffer is shared, false if other has no shareable buffer and the caller should copy
+     */
+    [[nodiscard]] auto share(const small_string_buffer& other) noexcept -> bool {
+        static_assert(core_type::share_buffers::value, "only a sharing core shares buffers");
+        Assert(not _core.is_external(), "only an empty buffer can share another one");
+        if (other._core.get_core_type() < kIsMedian) {
+            return false;
+        }
+        // a view has no count, the copy is another view of the same memory
+        if (other._core.is_view()) {
+            _core.body = other._core.body;
+            return true;
+        }
+        auto* count = other.refcount();
+        auto current = count->load(std::memory_order_relaxed);
+        // a pointer into the buffer was handed out, writes through it must not show in the copy
+        if (current == kUnshareable) {
+            return false;
+        }
+        count->fetch_add(1, std::memory_order_relaxed);
+        _core.body = other._core.body;
+        return true;
+    }
+
+    /**
+     * @brief Makes this empty buffer a view of caller memory, for the cores borrowing views
+     * @param text Caller memory, followed by a null terminator for null terminated strings
+     * @param size Length of the text in chars
+     * @note Nothing is allocated or read, an empty text leaves the buffer empty
+     */
+    auto borrow(const Char* text, size_type size) noexcept -> void {
+        static_assert(core_type::kBorrowsViews, "only a core borrowing views wraps caller memory");
+        Assert(not _core.is_external(), "only an empty buffer can borrow a text");
+        Assert(not NullTerminated or size == 0 or text[size] == Char{}, "a null terminator should follow the text");
+        if (size != 0) {
+            _core.external = core_type::view_external_of(text, size);
+        }
+    }
+
+    /**
+     * @brief Checks whether the buffer is a view of caller memory
+     * @return true if the string refers to memory it does not own
+     */
+    [[nodiscard]] auto is_borrowed() const noexcept -> bool { return _core.is_view(); }
+
     constexpr auto operator=(const small_string_buffer& other) noexcept = delete;
     constexpr auto operator=(small_string_buffer&& other) noexcept = delete;
 
-    [[nodiscard]] constexpr auto get_buffer() noexcept -> Char* { return _core.begin_ptr(); }
+    [[nodiscard]] constexpr auto get_buffer() noexcept -> Char* {
+        prepare_write();
+        return _core.begin_ptr();
+    }
 
     [[nodiscard]] constexpr auto get_buffer() const noexcept -> const Char* {
         return const_cast<small_string_buffer*>(this)->_core.begin_ptr();
     }
 
+    /// get_buffer() for the pointers handed out to the user, the buffer is not shared afterwards
+    [[nodiscard]] constexpr auto leak_buffer() noexcept -> Char* {
+        prepare_leak();
+        return _core.begin_ptr();
+    }
+
+    /// end() for the iterators handed out to the user, the buffer is not shared afterwards
+    [[nodiscard]] constexpr auto leak_end() noexcept -> Char* {
+        prepare_leak();
+        return _core.end_ptr();
+    }
+
     // will be fast than call get_buffer() + size(), it will waste many times for if checking
-    [[nodiscard]] constexpr auto end() noexcept -> Char* { return _core.end_ptr(); }
+    [[nodiscard]] constexpr auto end() noexcept -> Char* {
+        prepare_write();
+        return _core.end_ptr();
+    }
+
+    [[nodiscard]] constexpr auto end() const noexcept -> const Char* {
+        return const_cast<small_string_buffer*>(this)->_core.end_ptr();
+    }
 
     [[nodiscard]] constexpr auto size() const noexcept -> size_type { return _core.size(); }
 
@@ -1390,6 +4483,45 @@ class small_string_buffer
         }
     }
 
+    /**
+     * @brief Moves the external buffer into another memory resource and rebinds the allocator to it
+     * @param resource Resource receiving the buffer
+     * @return Bytes trimmed off the buffer, 0 for Internal strings
+     * @note The buffer is trimmed to the size, which may move it down a tier, only c_str_ptr and the tier fields of
+     * the core are rewritten
+     * @note An Internal string keeps its bytes, only its allocator moves to resource
+     */
+    auto relocate(std::pmr::memory_resource* resource) -> std::size_t
+        requires(not core_type::use_std_allocator::value)
+    {
+        std::pmr::polymorphic_allocator<Char> old_allocator = _core.pmr_allocator;
+        std::destroy_at(&_core.pmr_allocator);
+        std::construct_at(&_core.pmr_allocator, resource);
+        if (not _core.is_external()) {
+            return 0;
+        }
+
+        auto old_type = static_cast<CoreType>(_core.get_core_type());
+        auto old_buffer_size = _core.external_buffer_size();
+        void* old_buffer = _core.external.get_buffer_ptr();
+        const Char* old_data = get_buffer();
+        auto size = _core.size();
+        auto cap_and_type = calculate_new_buffer_size(size);
+        if constexpr (stats::enabled) {
+            stats::detail::count_transition(old_type, cap_and_type.core_type);
+            if constexpr (not core_type::arena_buffers::value) {
+                stats::detail::count_deallocation(old_type, old_buffer_size);
+            }
+        }
+        initial_allocate(cap_and_type, size);
+        std::memcpy(get_buffer(), old_data, size * sizeof(Char));
+        if constexpr (not core_type::arena_buffers::value) {
+            old_allocator.deallocate(reinterpret_cast<Char*>(old_buffer), old_buffer_size / sizeof(Char));
+        }
+        auto new_buffer_size = _core.is_external() ? _core.external_buffer_size() : 0;
+        return old_buffer_size - new_buffer_size;
+    }
+
     /**
      * @brief Assigns a character to fill the string with a compile-time specified size
      * @tparam Size The number of characters to assign (must be > 0 and <= internal buffer size)
@@ -1401,11 +4533,12 @@ class small_string_buffer
     constexpr void static_assign(Char ch) {
         static_assert(Size > 0 and Size <= core_type::internal_buffer_size(), "the size should be greater than 0");
         // TODO(leo): combine the memset and set_size in same switch case
-        memset(get_buffer(), ch, Size);
+        Traits::assign(get_buffer(), Size, ch);
         set_size(Size);
     }
 
-    [[nodiscard, gnu::always_inline]] constexpr inline auto get_string_view() const noexcept -> std::string_view {
+    [[nodiscard, gnu::always_inline]] constexpr inline auto get_string_view() const noexcept
+      -> std::basic_string_view<Char, Traits> {
         return _core.get_string_view();
     }
 
@@ -1417,14 +4550,15 @@ class small_string_buffer
  * @brief High-performance string class with small string optimization
  * @tparam Char Character type (char, wchar_t, etc.)
  * @tparam Buffer Buffer management policy (default: small_string_buffer)
- * @tparam Core Storage core type (default: malloc_core, alternative: pmr_core)
+ * @tparam Core Storage core type (default: malloc_core, alternatives: wide_core, pooled_core, pmr_core)
  * @tparam Traits Character traits for string operations (default: std::char_traits<Char>)
  * @tparam Allocator Memory allocator type (default: std::allocator<Char>)
  * @tparam NullTerminated Whether strings maintain null termination (default: true)
- * @tparam Growth Growth factor for buffer reallocation (default: 1.5)
+ * @tparam Growth Growth policy for buffer reallocation (default: geometric_growth<1.5F>)
+ * @tparam LongTier Where large Long buffers live (default: heap_long_tier, alternative: mmap_long_tier)
  *
  * @note Uses small string optimization with 4 storage strategies:
- *       - Internal: up to 6-7 chars embedded directly in object
+ *       - Internal: up to 6-7 chars embedded directly in object (14-15 with wide_core)
  *       - Short: up to 255 chars with compact metadata
  *       - Median: up to 16383 chars with idle capacity tracking
  *       - Long: unlimited size with full external allocation
@@ -1432,21 +4566,24 @@ class small_string_buffer
  * @note Thread-safe for read operations, requires external synchronization for writes
  */
 template <typename Char,
-          template <typename, template <typename, bool> class, class, class, bool, float> class Buffer =
+          template <typename, template <typename, bool> class, class, class, bool, class, class> class Buffer =
             small_string_buffer,
           template <typename, bool> class Core = malloc_core, class Traits = std::char_traits<Char>,
-          class Allocator = std::allocator<Char>, bool NullTerminated = true, float Growth = 1.5F>
-class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTerminated, Growth>
+          class Allocator = std::allocator<Char>, bool NullTerminated = true, class Growth = default_growth,
+          class LongTier = heap_long_tier>
+class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTerminated, Growth, LongTier>
 {
    public:
     /// STL-compatible type definitions for template specialization and trait access
     using buffer_type =
-      Buffer<Char, Core, Traits, Allocator, NullTerminated, Growth>;  ///< Underlying buffer management type
-    using value_type = typename Traits::char_type;                    ///< Character type (same as Char)
-    using traits_type = Traits;                                       ///< Character traits class
-    using allocator_type = Allocator;                                 ///< Memory allocator type
-    using size_type = std::uint32_t;                                  ///< Size/index type (32-bit for space efficiency)
+      Buffer<Char, Core, Traits, Allocator, NullTerminated, Growth, LongTier>;  ///< Underlying buffer management type
+    using value_type = typename Traits::char_type;  ///< Character type (same as Char)
+    using traits_type = Traits;                     ///< Character traits class
+    using allocator_type = Allocator;               ///< Memory allocator type
+    using size_type = typename Core<Char, NullTerminated>::size_type;  ///< Size/index type, 32-bit unless huge_core
     using difference_type = typename std::allocator_traits<Allocator>::difference_type;  ///< Signed difference type
+    /// A move plus the destruction of the source is a memcpy, see is_trivially_relocatable
+    using trivially_relocatable = typename Core<Char, NullTerminated>::trivially_relocatable;
 
     /// Reference and pointer types for STL compatibility
     using reference = typename std::allocator_traits<Allocator>::value_type&;  ///< Mutable element reference
@@ -1465,6 +4602,9 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
     /// Standard "not found" sentinel value (maximum representable index)
     constexpr static size_type npos = std::numeric_limits<size_type>::max();
 
+    /// Whether the find family runs the byte kernels of small::search, custom traits may tell chars apart otherwise
+    constexpr static bool kByteSearch = sizeof(Char) == 1 and std::is_same_v<Traits, std::char_traits<Char>>;
+
     /**
      * @brief Tag type for constructors that defer initialization
      * @note Used to create string objects that will be initialized later
@@ -1532,18 +4672,16 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      */
     constexpr basic_small_string(size_t count, Char ch, [[maybe_unused]] const Allocator& allocator = Allocator())
         : basic_small_string(initialized_later{}, count, allocator) {
-        memset(data(), ch, count);
+        Traits::assign(buffer_type::get_buffer(), count, ch);
     }
 
     /**
      * @brief Copy constructor creates deep copy of another string
      * @param other String to copy from
-     * @note Allocates new memory and copies all data
+     * @note Allocates new memory and copies all data, a sharing core shares Median/Long buffers instead
      */
     constexpr basic_small_string(const basic_small_string& other)
-        : basic_small_string(initialized_later{}, other.size(), other.get_allocator()) {
-        std::memcpy(data(), other.data(), other.size());
-    }
+        : basic_small_string(other, other.get_allocator()) {}
 
     /**
      * @brief Copy constructor with different allocator
@@ -1552,10 +4690,54 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @note Creates copy using specified allocator instead of other's allocator
      */
     constexpr basic_small_string(const basic_small_string& other, [[maybe_unused]] const Allocator& allocator)
-        : basic_small_string(initialized_later{}, other.size(), other.get_allocator()) {
-        std::memcpy(data(), other.data(), other.size());
+        : buffer_type(other.get_allocator()) {
+        if constexpr (Core<Char, NullTerminated>::share_buffers::value) {
+            if (buffer_type::share(other)) {
+                return;
+            }
+        }
+        buffer_type::initial_allocate(other.size());
+        Traits::copy(buffer_type::get_buffer(), other.data(), other.size());
+    }
+
+    /**
+     * @brief Wraps a static_text as a view, without allocating or copying
+     * @param text Literal that must outlive the string and its copies, usually a static constexpr
+     * @param allocator Allocator instance to use
+     * @note Only for the cores borrowing views, see borrowing_core, the first mutation copies the text
+     */
+    template <std::size_t N>
+    basic_small_string(const static_text<Char, N>& text, const Allocator& allocator = Allocator())
+      requires(Core<Char, NullTerminated>::kBorrowsViews)
+        : basic_small_string(borrow_t{}, text.text, N - 1, allocator) {}
+
+    /**
+     * @brief Wraps caller memory as a view, without allocating or copying
+     * @param text Memory that must outlive the string and its copies, followed by a null terminator for null
+     * terminated strings
+     * @param count Length of the text in chars
+     * @param allocator Allocator instance to use
+     * @throws std::length_error if count exceeds max_size()
+     * @note Only for the cores borrowing views, see borrowing_core, the first mutation copies the text
+     */
+    basic_small_string(borrow_t, const Char* text, size_t count, const Allocator& allocator = Allocator())
+      requires(Core<Char, NullTerminated>::kBorrowsViews)
+        : buffer_type(allocator) {
+        if (count > max_size()) [[unlikely]] {
+            throw std::length_error("borrow: the text exceeds max_size()");
+        }
+        buffer_type::borrow(text, static_cast<size_type>(count));
     }
 
+    /**
+     * @brief Wraps the memory of a view, without allocating or copying
+     * @param view Characters that must outlive the string and its copies
+     * @param allocator Allocator instance to use
+     */
+    basic_small_string(borrow_t tag, std::basic_string_view<Char, Traits> view, const Allocator& allocator = Allocator())
+      requires(Core<Char, NullTerminated>::kBorrowsViews)
+        : basic_small_string(tag, view.data(), view.size(), allocator) {}
+
     /**
      * @brief Copy constructor from substring starting at position
      * @param other String to copy from
@@ -1621,7 +4803,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      */
     constexpr basic_small_string(const Char* s, size_t count, [[maybe_unused]] const Allocator& allocator = Allocator())
         : basic_small_string(initialized_later{}, count, allocator) {
-        std::memcpy(data(), s, count);
+        Traits::copy(buffer_type::get_buffer(), s, count);
     }
 
     /**
@@ -1644,7 +4826,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
     template <class InputIt>
     constexpr basic_small_string(InputIt first, InputIt last, [[maybe_unused]] const Allocator& allocator = Allocator())
         : basic_small_string(initialized_later{}, static_cast<size_type>(std::distance(first, last)), allocator) {
-        std::copy(first, last, begin());
+        std::copy(first, last, buffer_type::get_buffer());
     }
 
     /**
@@ -1656,7 +4838,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
     constexpr basic_small_string(std::initializer_list<Char> ilist,
                                  [[maybe_unused]] const Allocator& allocator = Allocator())
         : basic_small_string(initialized_later{}, ilist.size(), allocator) {
-        std::copy(ilist.begin(), ilist.end(), begin());
+        std::copy(ilist.begin(), ilist.end(), buffer_type::get_buffer());
     }
 
     /**
@@ -1671,7 +4853,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
                  not std::is_convertible_v<const StringViewLike&, const Char*>)
     constexpr basic_small_string(const StringViewLike& s, [[maybe_unused]] const Allocator& allocator = Allocator())
         : basic_small_string(initialized_later{}, s.size(), allocator) {
-        std::copy(s.begin(), s.end(), begin());
+        std::copy(s.begin(), s.end(), buffer_type::get_buffer());
     }
 
     /**
@@ -1689,7 +4871,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
     constexpr basic_small_string(const StringViewLike& s, size_type pos, size_type n,
                                  [[maybe_unused]] const Allocator& allocator = Allocator())
         : basic_small_string(initialized_later{}, n, allocator) {
-        std::copy(s.begin() + pos, s.begin() + pos + n, begin());
+        std::copy(s.begin() + pos, s.begin() + pos + n, buffer_type::get_buffer());
     }
 
     /**
@@ -1715,6 +4897,18 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      */
     [[nodiscard]] constexpr auto get_allocator() const -> Allocator { return buffer_type::get_allocator(); }
 
+    /**
+     * @brief Moves the buffer into another memory resource, trimmed to the size
+     * @param resource Resource receiving the buffer, becomes the resource of the string
+     * @return Bytes trimmed off the buffer
+     * @note Only for the pmr cores, see small::pmr::compact
+     */
+    auto relocate(std::pmr::memory_resource* resource) -> std::size_t
+        requires(not Core<Char, NullTerminated>::use_std_allocator::value)
+    {
+        return buffer_type::relocate(resource);
+    }
+
     /**
      * @brief Returns the current storage type of the string
      * @return Core type as size_type (0=Internal, 1=Short, 2=Median, 3=Long)
@@ -1722,6 +4916,12 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      */
     [[nodiscard]] constexpr auto get_core_type() const -> size_type { return buffer_type::get_core_type(); }
 
+    /**
+     * @brief Checks whether the string is a view of memory it does not own, see borrowing_core
+     * @return true until the first mutation copies the text, always false for the cores not borrowing views
+     */
+    [[nodiscard]] auto is_borrowed() const noexcept -> bool { return buffer_type::is_borrowed(); }
+
     /**
      * @brief Copy assignment operator
      * @param other String to copy from
@@ -1732,6 +4932,13 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         if (this == &other) [[unlikely]] {
             return *this;
         }
+        if constexpr (Core<Char, NullTerminated>::share_buffers::value) {
+            if (other.get_core_type() >= kIsMedian) {
+                this->~basic_small_string();
+                new (this) basic_small_string(other);
+                return *this;
+            }
+        }
         // assign the other to this
         return assign(other.data(), other.size());
     }
@@ -1816,7 +5023,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
             this->template buffer_reserve<buffer_type::Need0::No, false>(size_type_count);
         }
         auto* buffer = buffer_type::get_buffer();
-        memset(buffer, ch, count);
+        Traits::assign(buffer, count, ch);
         // do not use resize, to avoid the if checking
         buffer_type::set_size(size_type_count);
 
@@ -1858,7 +5065,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
             // erase the other part
             count = std::min<size_t>(count, other_size - pos);
             auto* buffer = buffer_type::get_buffer();
-            std::memmove(buffer, buffer + pos, count);
+            Traits::move(buffer, buffer + pos, count);
             buffer_type::set_size(static_cast<size_type>(count));
             return *this;
         }
@@ -1897,7 +5104,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         }
         auto* buffer = buffer_type::get_buffer();
         // use memmove to handle the overlap
-        std::memmove(buffer, s, count);
+        Traits::move(buffer, s, count);
         buffer_type::set_size(count);
         return *this;
     }
@@ -1911,6 +5118,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @note Converts size_t to size_type with bounds checking
      */
     template <bool Safe = true>
+        requires(not std::is_same_v<size_type, size_t>)  // huge_core sizes are size_t already
     auto assign(const Char* s, size_t count) -> basic_small_string& {
         Assert((count <= Core<Char, NullTerminated>::max_long_buffer_size()),
                "assign: count should be less than the max value of size_type");
@@ -1948,7 +5156,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
             this->template buffer_reserve<buffer_type::Need0::No, false>(size_type_count);
         }
         if (size_type_count > 0) {
-            std::copy(first, last, begin());
+            std::copy(first, last, buffer_type::get_buffer());
         }
         buffer_type::set_size(size_type_count);
         return *this;
@@ -2013,7 +5221,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
                 throw std::out_of_range("at: pos is out of range");
             }
         }
-        return *(buffer_type::get_buffer() + pos);
+        return *(buffer_type::leak_buffer() + pos);
     }
 
     /**
@@ -2049,7 +5257,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
                 throw std::out_of_range("operator []: pos is out of range");
             }
         }
-        return *(buffer_type::get_buffer() + pos);
+        return *(buffer_type::leak_buffer() + pos);
     }
 
     /**
@@ -2091,7 +5299,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      */
     [[nodiscard]] constexpr auto back() noexcept -> reference {
         auto size = buffer_type::size();
-        auto buffer = buffer_type::get_buffer();
+        auto buffer = buffer_type::leak_buffer();
         return buffer[size - 1];
     }
 
@@ -2129,7 +5337,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @return Mutable pointer to character array
      * @note May or may not be null-terminated depending on NullTerminated template parameter
      */
-    [[nodiscard, gnu::always_inline]] auto data() noexcept -> Char* { return buffer_type::get_buffer(); }
+    [[nodiscard, gnu::always_inline]] auto data() noexcept -> Char* { return buffer_type::leak_buffer(); }
 
     /**
      * @brief Returns iterator to beginning of string
@@ -2157,7 +5365,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @return Mutable iterator pointing past the end
      * @note Standard STL end iterator for range operations
      */
-    [[nodiscard]] constexpr auto end() noexcept -> iterator { return buffer_type::end(); }
+    [[nodiscard]] constexpr auto end() noexcept -> iterator { return buffer_type::leak_end(); }
 
     /**
      * @brief Returns const iterator to one past last character
@@ -2165,7 +5373,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @note Read-only end iterator for const strings
      */
     [[nodiscard]] constexpr auto end() const noexcept -> const_iterator {
-        return const_cast<basic_small_string*>(this)->end();
+        return buffer_type::end();
     }
 
     /**
@@ -2174,7 +5382,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @note Explicitly const version, same as const end()
      */
     [[nodiscard]] constexpr auto cend() const noexcept -> const_iterator {
-        return const_cast<basic_small_string*>(this)->end();
+        return buffer_type::end();
     }
 
     /**
@@ -2310,9 +5518,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         Assert(cap >= size, "cap should always be greater or equal to size");
         auto cap_and_type = buffer_type::calculate_new_buffer_size(size);
         if (cap > cap_and_type.buffer_size) {  // the cap is larger than the best cap, so need to shrink
-            basic_small_string new_str{initialized_later{}, cap_and_type, size, buffer_type::get_allocator()};
-            std::memcpy(new_str.data(), data(), size);
-            swap(new_str);
+            move_to_buffer(cap_and_type, size);
         }
 
 #ifndef NDEBUG
@@ -2325,9 +5531,12 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
     /**
      * @brief Clears string content without deallocating memory
      * @note Sets size to 0 and null terminates if NullTerminated=true
-     * @note Capacity remains unchanged for performance
+     * @note Capacity remains unchanged for performance, unless the growth policy is a ShrinkPolicy
      */
-    constexpr auto clear() noexcept -> void { buffer_type::set_size(0); }
+    constexpr auto clear() noexcept -> void {
+        buffer_type::set_size(0);
+        shrink_after_erase(0);
+    }
 
     /**
      * @brief Inserts count copies of character at specified position
@@ -2359,9 +5568,9 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         auto* buffer = buffer_type::get_buffer();
         if (index < old_size) [[likely]] {
             // if index == old_size, do not need memmove
-            std::memmove(buffer + index + count, buffer + index, old_size - index);
+            Traits::move(buffer + index + count, buffer + index, old_size - index);
         }
-        std::memset(buffer + index, ch, count);
+        Traits::assign(buffer + index, count, ch);
         buffer_type::increase_size(size_type_count);
         return *this;
     }
@@ -2376,7 +5585,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      */
     template <bool Safe = true>
     constexpr auto insert(size_t index, const Char* str) -> basic_small_string& {
-        return insert<Safe>(index, str, std::strlen(str));
+        return insert<Safe>(index, str, Traits::length(str));
     }
 
     /**
@@ -2407,10 +5616,10 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         // memmove the data to the new position
         auto* buffer = buffer_type::get_buffer();
         if (index < old_size) [[likely]] {
-            std::memmove(buffer + index + count, buffer + index, old_size - index);
+            Traits::move(buffer + index + count, buffer + index, old_size - index);
         }
         // set the new data
-        std::memcpy(buffer + index, str, count);
+        Traits::copy(buffer + index, str, count);
         buffer_type::increase_size(static_cast<size_type>(count));
         return *this;
     }
@@ -2464,7 +5673,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      */
     template <bool Safe = true>
     constexpr auto insert(const_iterator pos, size_t count, Char ch) -> iterator {
-        auto index = static_cast<size_t>(pos - begin());
+        auto index = static_cast<size_t>(pos - cbegin());
         insert(index, count, ch);
         return begin() + index;
     }
@@ -2489,7 +5698,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
             // do nothing
             return const_cast<iterator>(pos);
         }
-        auto index = static_cast<size_t>(pos - begin());
+        auto index = static_cast<size_t>(pos - cbegin());
         auto size_type_count = static_cast<size_type>(count);
         if constexpr (Safe) {
             Assert(size_type_count <= std::numeric_limits<size_type>::max(), "count exceeds size_type maximum");
@@ -2498,10 +5707,10 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         // by now, the capacity is enough
         if (index < size()) [[likely]] {
             // move the data to the new position
-            std::memmove(data() + index + count, data() + index, size() - index);
+            Traits::move(buffer_type::get_buffer() + index + count, buffer_type::get_buffer() + index, size() - index);
         }
         // copy the new data
-        std::copy(first, last, data() + index);
+        std::copy(first, last, buffer_type::get_buffer() + index);
         buffer_type::increase_size(size_type_count);
         return const_cast<iterator>(pos);
     }
@@ -2530,7 +5739,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         requires(std::is_convertible_v<const StringViewLike&, std::basic_string_view<Char>> &&
                  !std::is_convertible_v<const StringViewLike&, const Char*>)
     constexpr auto insert(const_iterator pos, const StringViewLike& t) -> iterator {
-        auto index = pos - begin();
+        auto index = pos - cbegin();
         insert<Safe>(static_cast<size_t>(index), t.data(), static_cast<size_type>(t.size()));
         return begin() + index;
     }
@@ -2550,7 +5759,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
                  !std::is_convertible_v<const StringViewLike&, const Char*>)
     constexpr auto insert(const_iterator pos, const StringViewLike& t, size_t pos2, size_t count = npos) -> iterator {
         auto sub = t.substr(pos2, count);
-        auto index = pos - begin();
+        auto index = pos - cbegin();
         insert<Safe>(static_cast<size_t>(index), sub.data(), sub.size());
         return begin() + index;
     }
@@ -2578,13 +5787,14 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         Assert(old_size >= index + real_count, "old size should be greater or equal than the index + real count");
         auto right_size = old_size - index - real_count;
         // if the count is greater than 0, then move right part of  the data to the new position
-        char* buffer_ptr = buffer_type::get_buffer();
+        Char* buffer_ptr = buffer_type::get_buffer();
         if (right_size > 0) {
             // memmove the data to the new position
-            std::memmove(buffer_ptr + index, buffer_ptr + index + real_count, right_size);
+            Traits::move(buffer_ptr + index, buffer_ptr + index + real_count, right_size);
         }
         // set the new size
         buffer_type::set_size(static_cast<size_type>(new_size));
+        shrink_after_erase(new_size);
         return *this;
     }
 
@@ -2595,7 +5805,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      */
     constexpr auto erase(const_iterator first) -> iterator {
         // the first must be valid, and of the string.
-        auto index = static_cast<size_t>(first - begin());
+        auto index = static_cast<size_t>(first - cbegin());
         return erase(index, 1).begin() + index;
     }
 
@@ -2606,7 +5816,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @return Iterator to character following the erased range
      */
     constexpr auto erase(const_iterator first, const_iterator last) -> iterator {
-        auto index = static_cast<size_t>(first - begin());
+        auto index = static_cast<size_t>(first - cbegin());
         return erase(index, static_cast<size_t>(last - first)).begin() + index;
     }
 
@@ -2621,7 +5831,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         if constexpr (Safe) {
             this->template allocate_more<buffer_type::Need0::No>(1UL);
         }
-        data()[size()] = c;
+        buffer_type::get_buffer()[size()] = c;
         buffer_type::increase_size(1);
     }
 
@@ -2649,7 +5859,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
             this->template allocate_more<buffer_type::Need0::No>(static_cast<size_type>(count));
         }
         // by now, the capacity is enough
-        std::memset(end(), c, count);
+        Traits::assign(buffer_type::end(), count, c);
         buffer_type::increase_size(static_cast<size_type>(count));
         return *this;
     }
@@ -2672,7 +5882,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         // by now, the capacity is enough
         // size() function maybe slower than while the size is larger than 4k, so store it.
         auto other_size = other.buffer_type::size();
-        std::memcpy(end(), other.data(), other_size);
+        Traits::copy(buffer_type::end(), other.data(), other_size);
         buffer_type::increase_size(other_size);
         return *this;
     }
@@ -2718,7 +5928,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
             this->template allocate_more<buffer_type::Need0::No>(static_cast<size_type>(count));
         }
 
-        std::memcpy(end(), s, count);
+        Traits::copy(buffer_type::end(), s, count);
         Assert(count <= std::numeric_limits<size_type>::max(), "count exceeds size_type maximum");
         buffer_type::increase_size(static_cast<size_type>(count));
         return *this;
@@ -2733,7 +5943,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      */
     template <bool Safe = true>
     constexpr auto append(const Char* s) -> basic_small_string& {
-        return append<Safe>(s, std::strlen(s));
+        return append<Safe>(s, Traits::length(s));
     }
 
     /**
@@ -2759,7 +5969,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         if constexpr (Safe) {
             this->template allocate_more<buffer_type::Need0::No>(size_type_count);
         }
-        std::copy(first, last, end());
+        std::copy(first, last, buffer_type::end());
         buffer_type::increase_size(size_type_count);
         return *this;
     }
@@ -2898,7 +6108,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
 
         if ((count >= old_size - pos) and count2 <= (cap - pos)) {
             // copy the data to pos, and no need to move the right part
-            std::memset(buffer_type::get_buffer() + pos, ch, count2);
+            Traits::assign(buffer_type::get_buffer() + pos, count2, ch);
             auto new_size = pos + count2;
             Assert(new_size <= std::numeric_limits<size_type>::max(), "new size exceeds size_type maximum");
             buffer_type::set_size(static_cast<size_type>(new_size));
@@ -2907,7 +6117,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
 
         if (count == count2) {
             // just replace
-            std::memset(buffer_type::get_buffer() + pos, ch, count2);
+            Traits::assign(buffer_type::get_buffer() + pos, count2, ch);
             return *this;
         }
 
@@ -2915,13 +6125,13 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         // init a new string
         basic_small_string ret{initialized_later{}, static_cast<size_type>(old_size - count + count2),
                                buffer_type::get_allocator()};
-        Char* p = ret.data();
+        Char* p = ret.buffer_type::get_buffer();
         // copy the left party
-        std::memcpy(p, data(), pos);
+        Traits::copy(p, cbegin(), pos);
         p += pos;
-        std::memset(p, ch, count2);
+        Traits::assign(p, count2, ch);
         p += count2;
-        std::copy(begin() + pos + count, end(), p);
+        std::copy(cbegin() + pos + count, cend(), p);
         *this = std::move(ret);
         return *this;
     }
@@ -2950,7 +6160,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
 
         if ((count >= old_size - pos) and count2 <= (cap - pos)) {  // count == npos still >= old_size - pos.
             // copy the data to pos, and no need to move the right part
-            std::memcpy(buffer_type::get_buffer() + pos, str, count2);
+            Traits::copy(buffer_type::get_buffer() + pos, str, count2);
             auto new_size = pos + count2;
             Assert(new_size <= std::numeric_limits<size_type>::max(), "new size exceeds size_type maximum");
             buffer_type::set_size(static_cast<size_type>(new_size));
@@ -2958,21 +6168,21 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         }
         if (count == count2) {
             // just replace
-            std::memcpy(buffer_type::get_buffer() + pos, str, count2);
+            Traits::copy(buffer_type::get_buffer() + pos, str, count2);
             return *this;
         }
         // else, the count != count2, need to move the right part
         // init a new string
         basic_small_string ret{initialized_later{}, static_cast<size_type>(old_size - count + count2),
                                buffer_type::get_allocator()};
-        Char* p = ret.data();
+        Char* p = ret.buffer_type::get_buffer();
         // copy the left party
-        std::memcpy(p, data(), pos);
+        Traits::copy(p, cbegin(), pos);
         p += pos;
         // copy the new data
-        std::memcpy(p, str, count2);
+        Traits::copy(p, str, count2);
         p += count2;
-        std::copy(begin() + pos + count, end(), p);
+        std::copy(cbegin() + pos + count, cend(), p);
         *this = std::move(ret);
         return *this;
     }
@@ -2998,7 +6208,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @note Converts iterators to position and count, then delegates
      */
     auto replace(const_iterator first, const_iterator last, const basic_small_string& other) -> basic_small_string& {
-        return replace(static_cast<size_t>(first - begin()), static_cast<size_t>(last - first), other.data(),
+        return replace(static_cast<size_t>(first - cbegin()), static_cast<size_t>(last - first), other.data(),
                        other.size());
     }
 
@@ -3030,7 +6240,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @note Converts iterators to position and count, then delegates
      */
     auto replace(const_iterator first, const_iterator last, const Char* cstr, size_t count2) -> basic_small_string& {
-        return replace(static_cast<size_t>(first - begin()), static_cast<size_t>(last - first), cstr, count2);
+        return replace(static_cast<size_t>(first - cbegin()), static_cast<size_t>(last - first), cstr, count2);
     }
 
     /**
@@ -3056,7 +6266,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @note Length calculated automatically using traits_type::length()
      */
     auto replace(const_iterator first, const_iterator last, const Char* cstr) -> basic_small_string& {
-        return replace(static_cast<size_t>(first - begin()), static_cast<size_t>(last - first), cstr,
+        return replace(static_cast<size_t>(first - cbegin()), static_cast<size_t>(last - first), cstr,
                        traits_type::length(cstr));
     }
 
@@ -3070,7 +6280,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @note Converts iterators to position and count, then delegates
      */
     auto replace(const_iterator first, const_iterator last, size_t count, Char ch) -> basic_small_string& {
-        return replace(static_cast<size_t>(first - begin()), static_cast<size_t>(last - first), count, ch);
+        return replace(static_cast<size_t>(first - cbegin()), static_cast<size_t>(last - first), count, ch);
     }
 
     /**
@@ -3103,9 +6313,9 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
 
         auto [cap, old_size] = buffer_type::get_capacity_and_size();
 
-        if (last == end() and count2 <= (cap - pos)) {
+        if (last == cend() and count2 <= (cap - pos)) {
             // copy the data to pos, and no need to move the right part
-            std::copy(first2, last2, data() + pos);
+            std::copy(first2, last2, buffer_type::get_buffer() + pos);
             auto new_size = pos + count2;
             Assert(new_size <= std::numeric_limits<size_type>::max(), "new size exceeds size_type maximum");
             buffer_type::set_size(static_cast<size_type>(new_size));
@@ -3114,7 +6324,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
 
         if (count == count2) {
             // just replace
-            std::copy(first2, last2, data() + pos);
+            std::copy(first2, last2, buffer_type::get_buffer() + pos);
             return *this;
         }
 
@@ -3122,9 +6332,9 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         // init a new string
         basic_small_string ret{initialized_later{}, static_cast<size_type>(old_size - count + count2),
                                buffer_type::get_allocator()};
-        Char* p = ret.data();
+        Char* p = ret.buffer_type::get_buffer();
         // copy the left party
-        std::copy(cbegin(), first, ret.begin());
+        std::copy(cbegin(), first, p);
         p += pos;
         // copy the new data
         std::copy(first2, last2, p);
@@ -3203,7 +6413,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         if ((count == npos) or (pos + count > current_size)) {
             count = current_size - pos;
         }
-        std::memcpy(dest, data() + pos, count);
+        Traits::copy(dest, data() + pos, count);
         return count;
     }
 
@@ -3223,12 +6433,13 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         if (count <= old_size) [[likely]] {
             // if count == old_size, just set the size
             buffer_type::set_size(static_cast<size_type>(count));
+            shrink_after_erase(count);
             return;
         }
         if (count > cap) {
             this->template buffer_reserve<buffer_type::Need0::No, true>(static_cast<size_type>(count));
         }
-        std::memset(data() + old_size, '\0', count - old_size);
+        Traits::assign(buffer_type::get_buffer() + old_size, count - old_size, Char());
         buffer_type::set_size(static_cast<size_type>(count));
         return;
     }
@@ -3250,6 +6461,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         if (count <= old_size) [[likely]] {
             // if count == old_size, just set the size
             buffer_type::set_size(static_cast<size_type>(count));
+            shrink_after_erase(count);
             return;
         }
         if (count > cap) {
@@ -3257,7 +6469,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
             this->template buffer_reserve<buffer_type::Need0::No, true>(static_cast<size_type>(count));
         }
         // by now, the capacity is enough
-        std::memset(data() + old_size, ch, count - old_size);
+        Traits::assign(buffer_type::get_buffer() + old_size, count - old_size, ch);
         buffer_type::set_size(static_cast<size_type>(count));
         return;
     }
@@ -3280,7 +6492,8 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @param pos Starting position for search (default: 0)
      * @param count Length of substring to find
      * @return Position of first match, or npos if not found
-     * @note Uses optimized Boyer-Moore-like algorithm for performance
+     * @note Strings of bytes with std::char_traits go to search::find, the vector kernels test the first and the last
+     * char of the needle together, so a common first char doesn't degrade the search
      */
     constexpr auto find(const Char* str, size_t pos, size_t count) const -> size_t {
         auto current_size = buffer_type::size();
@@ -3291,8 +6504,15 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
             return npos;
         }
 
-        const auto elem0 = str[0];
         const auto* data_ptr = buffer_type::get_buffer();
+        if constexpr (kByteSearch) {
+            if (not std::is_constant_evaluated()) {
+                auto found = search::find(reinterpret_cast<const char*>(data_ptr + pos), current_size - pos,
+                                          reinterpret_cast<const char*>(str), count);
+                return found == search::kNotFound ? npos : pos + found;
+            }
+        }
+        const auto elem0 = str[0];
         const auto* first_ptr = data_ptr + pos;
         const auto* const last_ptr = data_ptr + current_size;
         auto len = current_size - pos;
@@ -3310,6 +6530,41 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         return npos;
     }
 
+    /**
+     * @brief Finds the first occurrence of a precompiled needle
+     * @param needle Needle to search for, see searcher
+     * @param pos Starting position for search (default: 0)
+     * @return Position of first match, or npos if not found
+     */
+    [[nodiscard]] auto find(const searcher& needle, size_t pos = 0) const noexcept -> size_t
+        requires(sizeof(Char) == 1)
+    {
+        auto current_size = buffer_type::size();
+        if (pos > current_size) [[unlikely]] {
+            return npos;
+        }
+        auto found = needle.find(reinterpret_cast<const char*>(buffer_type::get_buffer()) + pos, current_size - pos);
+        return found == search::kNotFound ? npos : pos + found;
+    }
+
+    /**
+     * @brief Finds the first match of a set of patterns
+     * @param patterns Patterns to search for, see multi_searcher
+     * @param pos Starting position for search (default: 0)
+     * @return Position of the match that ends first, or npos if none matches
+     */
+    [[nodiscard]] auto find(const multi_searcher& patterns, size_t pos = 0) const noexcept -> size_t
+        requires(sizeof(Char) == 1)
+    {
+        auto current_size = buffer_type::size();
+        if (pos > current_size) [[unlikely]] {
+            return npos;
+        }
+        auto found = patterns.find_first(
+          std::string_view(reinterpret_cast<const char*>(buffer_type::get_buffer()) + pos, current_size - pos));
+        return found.offset == search::kNotFound ? npos : pos + found.offset;
+    }
+
     /**
      * @brief Finds first occurrence of null-terminated substring
      * @param needle Null-terminated string to search for
@@ -3362,13 +6617,20 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @param pos Starting position for reverse search
      * @param str_length Length of substring to find
      * @return Position of last match, or npos if not found
-     * @note Searches backwards from pos
+     * @note Searches backwards from pos, strings of bytes with std::char_traits go to search::rfind
      */
     [[nodiscard]] constexpr auto rfind(const Char* str, size_t pos, size_t str_length) const -> size_t {
         auto current_size = buffer_type::size();
         if (str_length <= current_size) [[likely]] {
             pos = std::min(pos, current_size - str_length);
             const auto* buffer_ptr = buffer_type::get_buffer();
+            if constexpr (kByteSearch) {
+                if (not std::is_constant_evaluated() and str_length > 0) {
+                    auto found = search::rfind(reinterpret_cast<const char*>(buffer_ptr), pos + str_length,
+                                               reinterpret_cast<const char*>(str), str_length);
+                    return found == search::kNotFound ? npos : found;
+                }
+            }
             do {
                 if (traits_type::compare(buffer_ptr + pos, str, str_length) == 0) {
                     return pos;
@@ -3417,7 +6679,7 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @param ch Character to search for
      * @param pos Starting position for reverse search (default: npos = from end)
      * @return Position of last match, or npos if not found
-     * @note Optimized single-character reverse search
+     * @note Strings of bytes with std::char_traits scan backwards a vector at a time, see search::rfind_char
      */
     [[nodiscard]] constexpr auto rfind(Char ch, size_t pos = npos) const -> size_t {
         auto current_size = size();
@@ -3426,6 +6688,13 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
             if (--current_size > pos) {
                 current_size = pos;
             }
+            if constexpr (kByteSearch) {
+                if (not std::is_constant_evaluated()) {
+                    auto found = search::rfind_char(reinterpret_cast<const char*>(buffer_ptr), current_size + 1,
+                                                    static_cast<char>(ch));
+                    return found == search::kNotFound ? npos : found;
+                }
+            }
             for (++current_size; current_size-- > 0;) {
                 if (traits_type::eq(buffer_ptr[current_size], ch)) {
                     return current_size;
@@ -3435,6 +6704,55 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         return npos;
     }
 
+    /**
+     * @brief Finds the first char of a precompiled set
+     * @param set Chars to match, see char_set
+     * @param pos Starting position for search (default: 0)
+     * @return Position of the first char of the set, or npos if not found
+     * @note 32 chars per step with AVX2 when the set has nibble tables, one table lookup per char otherwise
+     */
+    [[nodiscard]] auto find_first_of(const char_set& set, size_t pos = 0) const noexcept -> size_t
+        requires(sizeof(Char) == 1)
+    {
+        return find_in_set(set, pos, true);
+    }
+
+    /**
+     * @brief Finds the first char outside a precompiled set
+     * @param set Chars to skip, see char_set
+     * @param pos Starting position for search (default: 0)
+     * @return Position of the first char outside the set, or npos if not found
+     */
+    [[nodiscard]] auto find_first_not_of(const char_set& set, size_t pos = 0) const noexcept -> size_t
+        requires(sizeof(Char) == 1)
+    {
+        return find_in_set(set, pos, false);
+    }
+
+    /**
+     * @brief Finds the last char of a precompiled set
+     * @param set Chars to match, see char_set
+     * @param pos Position to start the search from (searches backwards), defaults to end of string
+     * @return Position of the last char of the set, or npos if not found
+     */
+    [[nodiscard]] auto find_last_of(const char_set& set, size_t pos = npos) const noexcept -> size_t
+        requires(sizeof(Char) == 1)
+    {
+        return rfind_in_set(set, pos, true);
+    }
+
+    /**
+     * @brief Finds the last char outside a precompiled set
+     * @param set Chars to skip, see char_set
+     * @param pos Position to start the search from (searches backwards), defaults to end of string
+     * @return Position of the last char outside the set, or npos if not found
+     */
+    [[nodiscard]] auto find_last_not_of(const char_set& set, size_t pos = npos) const noexcept -> size_t
+        requires(sizeof(Char) == 1)
+    {
+        return rfind_in_set(set, pos, false);
+    }
+
     /**
      * @brief Finds first character that matches any character in given set
      * @param str Character set to match against
@@ -3444,6 +6762,11 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @note Useful for finding characters from a specific set
      */
     [[nodiscard]] constexpr auto find_first_of(const Char* str, size_t pos, size_t count) const -> size_t {
+        if constexpr (kByteSearch) {
+            if (not std::is_constant_evaluated()) {
+                return count == 0 ? npos : find_in_chars(reinterpret_cast<const char*>(str), count, pos, true);
+            }
+        }
         auto current_size = this->size();
         auto buffer_ptr = buffer_type::get_buffer();
         for (; count > 0 && pos < current_size; ++pos) {
@@ -3508,6 +6831,11 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @note Inverse of find_first_of - finds characters NOT in the set
      */
     [[nodiscard]] constexpr auto find_first_not_of(const Char* str, size_t pos, size_t count) const -> size_t {
+        if constexpr (kByteSearch) {
+            if (not std::is_constant_evaluated()) {
+                return find_in_chars(reinterpret_cast<const char*>(str), count, pos, false);
+            }
+        }
         auto current_size = this->size();
         const auto* buffer_ptr = buffer_type::get_buffer();
         for (; pos < current_size; ++pos) {
@@ -3571,6 +6899,11 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @return Position of the last occurrence of any character from str, or npos if not found
      */
     [[nodiscard]] constexpr auto find_last_of(const Char* str, size_t pos, size_t count) const -> size_t {
+        if constexpr (kByteSearch) {
+            if (not std::is_constant_evaluated()) {
+                return count == 0 ? npos : rfind_in_chars(reinterpret_cast<const char*>(str), count, pos, true);
+            }
+        }
         auto current_size = this->size();
         const auto* buffer_ptr = buffer_type::get_buffer();
         if (current_size && count) [[likely]] {
@@ -3638,6 +6971,11 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
      * @return Position of the last character not in str, or npos if not found
      */
     [[nodiscard]] constexpr auto find_last_not_of(const Char* str, size_t pos, size_t count) const -> size_t {
+        if constexpr (kByteSearch) {
+            if (not std::is_constant_evaluated()) {
+                return rfind_in_chars(reinterpret_cast<const char*>(str), count, pos, false);
+            }
+        }
         size_t current_size = buffer_type::size();
         if (current_size > 0) {
             if (--current_size > pos) {
@@ -3930,15 +7268,117 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
         if (count < current_size - pos) {
             resize(count);
         }
-        // or just return *this
-        return std::move(*this);
+        // or just return *this
+        return std::move(*this);
+    }
+
+    // convert to std::basic_string_view, to support C++11 compatibility. and it's noexcept.
+    // and small_string can be converted to std::basic_string_view implicity, so third party String can be converted
+    // from small_string.
+    [[nodiscard, gnu::always_inline]] inline operator std::basic_string_view<Char, Traits>() const noexcept {
+        return buffer_type::get_string_view();
+    }
+
+   private:
+    /**
+     * @brief Moves the content into a new, smaller buffer
+     * @param cap_and_type Buffer configuration to move to
+     * @param size Current string size, must fit the new buffer
+     */
+    auto move_to_buffer(buffer_type_and_size<size_type> cap_and_type, size_t size) -> void {
+        if constexpr (stats::enabled) {
+            stats::detail::count_transition(static_cast<CoreType>(buffer_type::get_core_type()),
+                                            cap_and_type.core_type);
+        }
+        basic_small_string new_str{initialized_later{}, cap_and_type, size, buffer_type::get_allocator()};
+        Traits::copy(new_str.buffer_type::get_buffer(), cbegin(), size);
+        swap(new_str);
+    }
+
+    /**
+     * @brief Gives capacity back after clear, erase or resize dropped the size, if the growth policy shrinks
+     * @param new_size String size after the erase
+     * @note Compiles to nothing unless Growth is a ShrinkPolicy
+     */
+    [[gnu::always_inline]] auto shrink_after_erase([[maybe_unused]] size_t new_size) -> void {
+        if constexpr (ShrinkPolicy<Growth, size_type>) {
+            buffer_type_and_size<size_type> cap_and_type{};
+            if (buffer_type::calculate_shrunk_buffer_size(new_size, cap_and_type)) [[unlikely]] {
+                move_to_buffer(cap_and_type, new_size);
+            }
+        }
+    }
+
+    /**
+     * @brief Finds the first char from pos whose membership in a set is wanted
+     * @param member true for find_first_of, false for find_first_not_of
+     */
+    [[nodiscard]] auto find_in_set(const char_set& set, size_t pos, bool member) const noexcept -> size_t {
+        auto current_size = this->size();
+        if (pos >= current_size) {
+            return npos;
+        }
+        auto found = search::find_first_of(reinterpret_cast<const char*>(buffer_type::get_buffer()) + pos,
+                                           current_size - pos, set, member);
+        return found == search::kNotFound ? npos : pos + found;
+    }
+
+    /**
+     * @brief Finds the last char up to pos whose membership in a set is wanted
+     * @param member true for find_last_of, false for find_last_not_of
+     */
+    [[nodiscard]] auto rfind_in_set(const char_set& set, size_t pos, bool member) const noexcept -> size_t {
+        auto current_size = this->size();
+        if (current_size == 0) {
+            return npos;
+        }
+        auto found = search::find_last_of(reinterpret_cast<const char*>(buffer_type::get_buffer()),
+                                          std::min<size_t>(pos, current_size - 1) + 1, set, member);
+        return found == search::kNotFound ? npos : found;
+    }
+
+    /// @brief find_in_set for count chars given as such, see search::find_first_of_once
+    [[nodiscard, gnu::always_inline]] auto find_in_chars(const char* chars, size_t count, size_t pos,
+                                                         bool member) const noexcept -> size_t {
+        auto current_size = this->size();
+        if (pos >= current_size) {
+            return npos;
+        }
+        const auto* haystack = reinterpret_cast<const char*>(buffer_type::get_buffer());
+        // the next token or separator is usually this close, not worth a table
+        for (auto probe_end = std::min<size_t>(current_size, pos + search::kCharsProbe); pos < probe_end; ++pos) {
+            if ((std::char_traits<char>::find(chars, count, haystack[pos]) != nullptr) == member) {
+                return pos;
+            }
+        }
+        if (pos == current_size) {
+            return npos;
+        }
+        auto set = char_set::table_only(chars, count);
+        auto found = search::find_first_of_once(haystack + pos, current_size - pos, set, member);
+        return found == search::kNotFound ? npos : pos + found;
     }
 
-    // convert to std::basic_string_view, to support C++11 compatibility. and it's noexcept.
-    // and small_string can be converted to std::basic_string_view implicity, so third party String can be converted
-    // from small_string.
-    [[nodiscard, gnu::always_inline]] inline operator std::basic_string_view<Char, Traits>() const noexcept {
-        return buffer_type::get_string_view();
+    /// @brief rfind_in_set for count chars given as such, see search::find_last_of_once
+    [[nodiscard, gnu::always_inline]] auto rfind_in_chars(const char* chars, size_t count, size_t pos,
+                                                          bool member) const noexcept -> size_t {
+        auto current_size = this->size();
+        if (current_size == 0) {
+            return npos;
+        }
+        const auto* haystack = reinterpret_cast<const char*>(buffer_type::get_buffer());
+        auto end = std::min<size_t>(pos, current_size - 1) + 1;
+        for (auto probe_end = end - std::min<size_t>(end, search::kCharsProbe); end > probe_end; --end) {
+            if ((std::char_traits<char>::find(chars, count, haystack[end - 1]) != nullptr) == member) {
+                return end - 1;
+            }
+        }
+        if (end == 0) {
+            return npos;
+        }
+        auto set = char_set::table_only(chars, count);
+        auto found = search::find_last_of_once(haystack, end, set, member);
+        return found == search::kNotFound ? npos : found;
     }
 };  // class basic_small_string
 
@@ -3951,7 +7391,8 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
  * @tparam Traits Character traits type
  * @tparam Allocator Allocator type
  * @tparam NullTerminated Whether the string maintains null termination
- * @tparam Growth Growth factor for buffer expansion
+ * @tparam Growth Growth policy for buffer expansion
+ * @tparam LongTier Long tier policy
  * @param os Output stream to write to
  * @param str String to write to the stream
  * @return Reference to the output stream for chaining operations
@@ -3972,10 +7413,12 @@ class basic_small_string : private Buffer<Char, Core, Traits, Allocator, NullTer
  *       which is more efficient than character-by-character insertion
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator<<(std::basic_ostream<Char, Traits>& os,
-                       const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& str)
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator<<(
+  std::basic_ostream<Char, Traits>& os,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& str)
   -> std::basic_ostream<Char, Traits>& {
     return os << std::basic_string_view<Char, Traits>(str.data(), str.size());
 }
@@ -3988,21 +7431,23 @@ inline auto operator<<(std::basic_ostream<Char, Traits>& os,
  * @tparam Traits Character traits type
  * @tparam Allocator Allocator type
  * @tparam NullTerminated Whether the string maintains null termination
- * @tparam Growth Growth factor for buffer expansion
+ * @tparam Growth Growth policy for buffer expansion
+ * @tparam LongTier Long tier policy
  * @param is Input stream to read from
  * @param str String to store the extracted data
  * @return Reference to the input stream for chaining operations
  * @note Reads characters until whitespace is encountered or stream width limit is reached
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator>>(std::basic_istream<Char, Traits>& is,
-                       basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& str)
+                       basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& str)
   -> std::basic_istream<Char, Traits>& {
-    using _istream_type = std::basic_istream<
-      typename basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated>::value_type,
-      typename basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated>::traits_type>;
+    using _string_type = basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>;
+    using _istream_type =
+      std::basic_istream<typename _string_type::value_type, typename _string_type::traits_type>;
     typename _istream_type::sentry sentry(is);
     size_t extracted = 0;
     typename _istream_type::iostate err = _istream_type::goodbit;
@@ -4021,7 +7466,7 @@ inline auto operator>>(std::basic_istream<Char, Traits>& is,
             if (std::isspace(static_cast<char>(got))) {
                 break;
             }
-            str.push_back(static_cast<char>(got));
+            str.push_back(Traits::to_char_type(got));
             got = is.rdbuf()->snextc();
         }
     }
@@ -4052,11 +7497,13 @@ inline auto operator>>(std::basic_istream<Char, Traits>& is,
  * @complexity Linear in the sum of the lengths of both strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator+(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                      const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs)
-  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth> {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator+(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs)
+  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier> {
     auto result = lhs;
     result.append(rhs);
     return result;
@@ -4074,11 +7521,12 @@ inline auto operator+(const basic_small_string<Char, Buffer, Core, Traits, Alloc
  * @complexity Linear in the sum of the lengths of both strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator+(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                      const Char* rhs)
-  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth> {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator+(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const Char* rhs) -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier> {
     auto result = lhs;
     result.append(rhs);
     return result;
@@ -4096,10 +7544,12 @@ inline auto operator+(const basic_small_string<Char, Buffer, Core, Traits, Alloc
  * @complexity Linear in the length of lhs, constant for appending the character
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator+(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                      Char rhs) -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated> {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator+(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  Char rhs) -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier> {
     auto result = lhs;
     result.push_back(rhs);
     return result;
@@ -4117,12 +7567,16 @@ inline auto operator+(const basic_small_string<Char, Buffer, Core, Traits, Alloc
  * @complexity Linear in the sum of the lengths of both strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator+(const Char* lhs,
-                      const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs)
-  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated> {
-    return basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated>(lhs, rhs.get_allocator()) + rhs;
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator+(
+  const Char* lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs)
+  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier> {
+    return basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>(
+             lhs, rhs.get_allocator()) +
+           rhs;
 }
 
 /**
@@ -4137,12 +7591,16 @@ inline auto operator+(const Char* lhs,
  * @complexity Linear in the length of rhs, constant for prepending the character
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator+(Char lhs,
-                      const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs)
-  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated> {
-    return basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated>(1, lhs, rhs.get_allocator()) + rhs;
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator+(
+  Char lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs)
+  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier> {
+    return basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>(
+             1, lhs, rhs.get_allocator()) +
+           rhs;
 }
 
 /**
@@ -4158,12 +7616,13 @@ inline auto operator+(Char lhs,
  *             due to move semantics avoiding unnecessary copies
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator+(basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>&& lhs,
-                      basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>&& rhs)
-  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated> {
-    basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated> result(std::move(lhs));
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator+(basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>&& lhs,
+                      basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>&& rhs)
+  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier> {
+    basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier> result(std::move(lhs));
     result.append(std::move(rhs));
     return result;
 }
@@ -4181,11 +7640,13 @@ inline auto operator+(basic_small_string<Char, Buffer, Core, Traits, Allocator,
  *             moving from lhs to avoid one copy operation
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator+(basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>&& lhs,
-                      const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs)
-  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth> {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator+(
+  basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>&& lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs)
+  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier> {
     auto result = std::move(lhs);
     result.append(rhs);
     return result;
@@ -4204,11 +7665,12 @@ inline auto operator+(basic_small_string<Char, Buffer, Core, Traits, Allocator,
  *             moving from lhs to avoid copying
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator+(basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>&& lhs,
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator+(basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>&& lhs,
                       const Char* rhs)
-  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth> {
+  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier> {
     auto result = std::move(lhs);
     result.append(rhs);
     return result;
@@ -4226,10 +7688,12 @@ inline auto operator+(basic_small_string<Char, Buffer, Core, Traits, Allocator,
  * @complexity Linear in the length of lhs for the move, constant for appending the character
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator+(basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>&& lhs, Char rhs)
-  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth> {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator+(basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>&& lhs,
+                      Char rhs)
+  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier> {
     auto result = std::move(lhs);
     result.push_back(rhs);
     return result;
@@ -4248,11 +7712,13 @@ inline auto operator+(basic_small_string<Char, Buffer, Core, Traits, Allocator,
  *             for rhs reducing one copy operation
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator+(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                      basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>&& rhs)
-  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated> {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator+(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>&& rhs)
+  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier> {
     auto result = lhs;
     result.append(std::move(rhs));
     return result;
@@ -4271,12 +7737,14 @@ inline auto operator+(const basic_small_string<Char, Buffer, Core, Traits, Alloc
  *             for rhs reducing one copy operation
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator+(const Char* lhs,
-                      basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>&& rhs)
-  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated> {
-    return basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated>(lhs, rhs.get_allocator()) +
+                      basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>&& rhs)
+  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier> {
+    return basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>(
+             lhs, rhs.get_allocator()) +
            std::move(rhs);
 }
 
@@ -4292,11 +7760,14 @@ inline auto operator+(const Char* lhs,
  * @complexity Linear in the length of rhs, with move optimization reducing one copy operation
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator+(Char lhs, basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>&& rhs)
-  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated> {
-    return basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated>(1, lhs, rhs.get_allocator()) +
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator+(Char lhs,
+                      basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>&& rhs)
+  -> basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier> {
+    return basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>(
+             1, lhs, rhs.get_allocator()) +
            std::move(rhs);
 }
 
@@ -4310,11 +7781,12 @@ inline auto operator+(Char lhs, basic_small_string<Char, Buffer, Core, Traits, A
  * @complexity Linear in the length of the shorter string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator<=>(
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
   -> std::strong_ordering {
     return lhs.compare(rhs) <=> 0;
 }
@@ -4339,11 +7811,13 @@ inline auto operator<=>(
  * @note This function is noexcept and will not throw any exceptions
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator==(
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return lhs.size() == rhs.size() and std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
@@ -4361,11 +7835,13 @@ inline auto operator==(
  * @note This function is noexcept and will not throw any exceptions
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator!=(
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return not(lhs == rhs);
 }
 
@@ -4387,11 +7863,13 @@ inline auto operator!=(
  * @note This function is noexcept and uses lexicographical ordering based on character traits
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator>(
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return lhs.compare(rhs) > 0;
 }
 
@@ -4408,11 +7886,13 @@ inline auto operator>(
  * @note This function is noexcept and uses lexicographical ordering based on character traits
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator<(
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return lhs.compare(rhs) < 0;
 }
 
@@ -4429,11 +7909,13 @@ inline auto operator<(
  * @note This function is noexcept and is implemented as the logical negation of operator<
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator>=(
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return not(lhs < rhs);
 }
 
@@ -4450,11 +7932,13 @@ inline auto operator>=(
  * @note This function is noexcept and is implemented as the logical negation of operator>
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator<=(
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return not(lhs > rhs);
 }
 
@@ -4472,11 +7956,12 @@ inline auto operator<=(
  * @complexity Linear in the length of the shorter string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
           template <typename, bool> class Core, class Traits, class Allocator, class STDAllocator, bool NullTerminated,
-          float Growth>
-inline auto operator<=>(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                        const std::basic_string<Char, Traits, STDAllocator>& rhs) noexcept -> std::strong_ordering {
+          class Growth, class LongTier>
+inline auto operator<=>(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const std::basic_string<Char, Traits, STDAllocator>& rhs) noexcept -> std::strong_ordering {
     auto lhs_size = lhs.size();
     auto rhs_size = rhs.size();
     Assert(lhs_size <= std::numeric_limits<typename std::remove_reference_t<decltype(lhs)>::size_type>::max(),
@@ -4496,12 +7981,12 @@ inline auto operator<=>(const basic_small_string<Char, Buffer, Core, Traits, All
  * @complexity Linear in the length of the shorter string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
           template <typename, bool> class Core, class Traits, class Allocator, class STDAllocator, bool NullTerminated,
-          float Growth>
+          class Growth, class LongTier>
 inline auto operator<=>(
   const std::basic_string<Char, Traits, STDAllocator>& lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
   -> std::strong_ordering {
     auto rhs_size = rhs.size();
     auto lhs_size = lhs.size();
@@ -4523,10 +8008,12 @@ inline auto operator<=>(
  * @complexity Linear in the length of the shorter string (includes C-string length computation)
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator<=>(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                        const Char* rhs) noexcept -> std::strong_ordering {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator<=>(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const Char* rhs) noexcept -> std::strong_ordering {
     auto lhs_size = lhs.size();
     auto rhs_len = Traits::length(rhs);
     Assert(lhs_size <= std::numeric_limits<typename std::remove_reference_t<decltype(lhs)>::size_type>::max(),
@@ -4546,11 +8033,12 @@ inline auto operator<=>(const basic_small_string<Char, Buffer, Core, Traits, All
  * @complexity Linear in the length of the shorter string (includes C-string length computation)
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator<=>(
   const Char* lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
   -> std::strong_ordering {
     auto rhs_size = rhs.size();
     auto lhs_size = Traits::length(lhs);
@@ -4567,10 +8055,12 @@ inline auto operator<=>(
  * @complexity Linear in the length of the shorter string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator<=>(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                        std::string_view rhs) noexcept -> std::strong_ordering {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator<=>(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  std::type_identity_t<std::basic_string_view<Char, Traits>> rhs) noexcept -> std::strong_ordering {
     auto lhs_size = lhs.size();
     auto rhs_size = rhs.size();
     Assert(lhs_size <= std::numeric_limits<typename std::remove_reference_t<decltype(lhs)>::size_type>::max(),
@@ -4590,11 +8080,12 @@ inline auto operator<=>(const basic_small_string<Char, Buffer, Core, Traits, All
  * @complexity Linear in the length of the shorter string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator<=>(
-  std::string_view lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept
+  std::type_identity_t<std::basic_string_view<Char, Traits>> lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
   -> std::strong_ordering {
     auto rhs_size = rhs.size();
     auto lhs_size = lhs.size();
@@ -4620,11 +8111,12 @@ inline auto operator<=>(
  * @note This function is noexcept and provides interoperability with std::basic_string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
           template <typename, bool> class Core, class Traits, class Allocator, class STDAllocator, bool NullTerminated,
-          float Growth>
-inline auto operator==(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                       const std::basic_string<Char, Traits, STDAllocator>& rhs) noexcept -> bool {
+          class Growth, class LongTier>
+inline auto operator==(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const std::basic_string<Char, Traits, STDAllocator>& rhs) noexcept -> bool {
     return lhs.size() == rhs.size() and std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
@@ -4641,12 +8133,13 @@ inline auto operator==(const basic_small_string<Char, Buffer, Core, Traits, Allo
  * @note This function is noexcept and provides interoperability with std::basic_string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
           template <typename, bool> class Core, class Traits, class Allocator, class STDAllocator, bool NullTerminated,
-          float Growth>
+          class Growth, class LongTier>
 inline auto operator==(
   const std::basic_string<Char, Traits, STDAllocator>& lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return lhs.size() == rhs.size() and std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
@@ -4663,11 +8156,13 @@ inline auto operator==(
  * @note This function is noexcept and provides interoperability with C-style strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator==(
   const Char* lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return rhs.size() == Traits::length(lhs) and std::equal(rhs.begin(), rhs.end(), lhs);
 }
 
@@ -4684,10 +8179,12 @@ inline auto operator==(
  * @note This function is noexcept and provides interoperability with C-style strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator==(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                       const Char* rhs) noexcept -> bool {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator==(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const Char* rhs) noexcept -> bool {
     return lhs.size() == Traits::length(rhs) and std::equal(lhs.begin(), lhs.end(), rhs);
 }
 
@@ -4704,10 +8201,12 @@ inline auto operator==(const basic_small_string<Char, Buffer, Core, Traits, Allo
  * @note This function is noexcept and provides interoperability with std::string_view
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator==(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                       std::string_view rhs) noexcept -> bool {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator==(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  std::type_identity_t<std::basic_string_view<Char, Traits>> rhs) noexcept -> bool {
     return lhs.size() == rhs.size() and std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
@@ -4724,11 +8223,13 @@ inline auto operator==(const basic_small_string<Char, Buffer, Core, Traits, Allo
  * @note This function is noexcept and provides interoperability with std::string_view
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator==(
-  std::string_view lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  std::type_identity_t<std::basic_string_view<Char, Traits>> lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return lhs.size() == rhs.size() and std::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
@@ -4746,11 +8247,12 @@ inline auto operator==(
  * @note This function is noexcept and provides interoperability with std::basic_string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
           template <typename, bool> class Core, class Traits, class Allocator, class STDAllocator, bool NullTerminated,
-          float Growth>
-inline auto operator!=(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                       const std::basic_string<Char, Traits, STDAllocator>& rhs) noexcept -> bool {
+          class Growth, class LongTier>
+inline auto operator!=(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const std::basic_string<Char, Traits, STDAllocator>& rhs) noexcept -> bool {
     return !(lhs == rhs);
 }
 
@@ -4768,12 +8270,13 @@ inline auto operator!=(const basic_small_string<Char, Buffer, Core, Traits, Allo
  * @note This function is noexcept and provides interoperability with std::basic_string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
           template <typename, bool> class Core, class Traits, class Allocator, class STDAllocator, bool NullTerminated,
-          float Growth>
+          class Growth, class LongTier>
 inline auto operator!=(
   const std::basic_string<Char, Traits, STDAllocator>& lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return !(lhs == rhs);
 }
 
@@ -4791,10 +8294,12 @@ inline auto operator!=(
  * @note This function is noexcept and provides interoperability with C-style strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator!=(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                       const Char* rhs) noexcept -> bool {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator!=(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const Char* rhs) noexcept -> bool {
     return !(lhs == rhs);
 }
 
@@ -4812,11 +8317,13 @@ inline auto operator!=(const basic_small_string<Char, Buffer, Core, Traits, Allo
  * @note This function is noexcept and provides interoperability with C-style strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator!=(
   const Char* lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return !(lhs == rhs);
 }
 
@@ -4834,10 +8341,12 @@ inline auto operator!=(
  * @note This function is noexcept and provides interoperability with std::string_view
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator!=(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                       std::string_view rhs) noexcept -> bool {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator!=(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  std::type_identity_t<std::basic_string_view<Char, Traits>> rhs) noexcept -> bool {
     return !(lhs == rhs);
 }
 
@@ -4855,11 +8364,13 @@ inline auto operator!=(const basic_small_string<Char, Buffer, Core, Traits, Allo
  * @note This function is noexcept and provides interoperability with std::string_view
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator!=(
-  std::string_view lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  std::type_identity_t<std::basic_string_view<Char, Traits>> lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return !(lhs == rhs);
 }
 
@@ -4876,11 +8387,12 @@ inline auto operator!=(
  * @note This function is noexcept and provides interoperability with std::basic_string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
           template <typename, bool> class Core, class Traits, class Allocator, class STDAllocator, bool NullTerminated,
-          float Growth>
-inline auto operator<(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                      const std::basic_string<Char, Traits, STDAllocator>& rhs) noexcept -> bool {
+          class Growth, class LongTier>
+inline auto operator<(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const std::basic_string<Char, Traits, STDAllocator>& rhs) noexcept -> bool {
     return lhs.compare(rhs) < 0;
 }
 
@@ -4897,12 +8409,13 @@ inline auto operator<(const basic_small_string<Char, Buffer, Core, Traits, Alloc
  * @note This function is noexcept and provides interoperability with std::basic_string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
           template <typename, bool> class Core, class Traits, class Allocator, class STDAllocator, bool NullTerminated,
-          float Growth>
+          class Growth, class LongTier>
 inline auto operator<(
   const std::basic_string<Char, Traits, STDAllocator>& lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return rhs.compare(lhs) > 0;
 }
 
@@ -4919,10 +8432,12 @@ inline auto operator<(
  * @note This function is noexcept and provides interoperability with C-style strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator<(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                      const Char* rhs) noexcept -> bool {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator<(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const Char* rhs) noexcept -> bool {
     return lhs.compare(rhs) < 0;
 }
 
@@ -4939,11 +8454,13 @@ inline auto operator<(const basic_small_string<Char, Buffer, Core, Traits, Alloc
  * @note This function is noexcept and provides interoperability with C-style strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator<(
   const Char* lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return rhs.compare(lhs) > 0;
 }
 
@@ -4960,10 +8477,12 @@ inline auto operator<(
  * @note This function is noexcept and provides interoperability with std::string_view
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator<(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                      std::string_view rhs) noexcept -> bool {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator<(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  std::type_identity_t<std::basic_string_view<Char, Traits>> rhs) noexcept -> bool {
     return lhs.compare(rhs) < 0;
 }
 
@@ -4980,11 +8499,13 @@ inline auto operator<(const basic_small_string<Char, Buffer, Core, Traits, Alloc
  * @note This function is noexcept and provides interoperability with std::string_view
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator<(
-  std::string_view lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  std::type_identity_t<std::basic_string_view<Char, Traits>> lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return rhs.compare(lhs) > 0;
 }
 
@@ -5001,12 +8522,13 @@ inline auto operator<(
  * @note This function is noexcept and provides interoperability with std::basic_string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
           template <typename, bool> class Core, class Traits, class Allocator, class STDAllocator, bool NullTerminated,
-          float Growth>
+          class Growth, class LongTier>
 inline auto operator>(
   const std::basic_string<Char, Traits, STDAllocator>& lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return rhs.compare(lhs) < 0;
 }
 
@@ -5023,11 +8545,13 @@ inline auto operator>(
  * @note This function is noexcept and provides interoperability with C-style strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator>(
   const Char* lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return rhs.compare(lhs) < 0;
 }
 
@@ -5044,10 +8568,12 @@ inline auto operator>(
  * @note This function is noexcept and provides interoperability with C-style strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator>(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                      const Char* rhs) noexcept -> bool {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator>(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const Char* rhs) noexcept -> bool {
     return lhs.compare(rhs) > 0;
 }
 
@@ -5064,10 +8590,12 @@ inline auto operator>(const basic_small_string<Char, Buffer, Core, Traits, Alloc
  * @note This function is noexcept and provides interoperability with std::string_view
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator>(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                      std::string_view rhs) noexcept -> bool {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator>(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  std::type_identity_t<std::basic_string_view<Char, Traits>> rhs) noexcept -> bool {
     return lhs.compare(rhs) > 0;
 }
 
@@ -5084,11 +8612,13 @@ inline auto operator>(const basic_small_string<Char, Buffer, Core, Traits, Alloc
  * @note This function is noexcept and provides interoperability with std::string_view
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator>(
-  std::string_view lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  std::type_identity_t<std::basic_string_view<Char, Traits>> lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return rhs.compare(lhs) < 0;
 }
 
@@ -5106,11 +8636,12 @@ inline auto operator>(
  * std::basic_string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
           template <typename, bool> class Core, class Traits, class Allocator, class STDAllocator, bool NullTerminated,
-          float Growth>
-inline auto operator<=(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                       const std::basic_string<Char, Traits, STDAllocator>& rhs) noexcept -> bool {
+          class Growth, class LongTier>
+inline auto operator<=(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const std::basic_string<Char, Traits, STDAllocator>& rhs) noexcept -> bool {
     return !(lhs > rhs);
 }
 
@@ -5128,12 +8659,13 @@ inline auto operator<=(const basic_small_string<Char, Buffer, Core, Traits, Allo
  * std::basic_string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
           template <typename, bool> class Core, class Traits, class Allocator, class STDAllocator, bool NullTerminated,
-          float Growth>
+          class Growth, class LongTier>
 inline auto operator<=(
   const std::basic_string<Char, Traits, STDAllocator>& lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return !(lhs > rhs);
 }
 
@@ -5151,10 +8683,12 @@ inline auto operator<=(
  * C-style strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated>
-inline auto operator<=(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated>& lhs,
-                       const Char* rhs) noexcept -> bool {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator<=(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const Char* rhs) noexcept -> bool {
     return !(lhs > rhs);
 }
 
@@ -5172,11 +8706,13 @@ inline auto operator<=(const basic_small_string<Char, Buffer, Core, Traits, Allo
  * C-style strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator<=(
   const Char* lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return !(lhs > rhs);
 }
 
@@ -5194,10 +8730,12 @@ inline auto operator<=(
  * std::string_view
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator<=(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                       std::string_view rhs) noexcept -> bool {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator<=(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  std::type_identity_t<std::basic_string_view<Char, Traits>> rhs) noexcept -> bool {
     return !(lhs > rhs);
 }
 
@@ -5215,11 +8753,13 @@ inline auto operator<=(const basic_small_string<Char, Buffer, Core, Traits, Allo
  * std::string_view
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator<=(
-  std::string_view lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  std::type_identity_t<std::basic_string_view<Char, Traits>> lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return !(lhs > rhs);
 }
 
@@ -5237,11 +8777,12 @@ inline auto operator<=(
  * std::basic_string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
           template <typename, bool> class Core, class Traits, class Allocator, class STDAllocator, bool NullTerminated,
-          float Growth>
-inline auto operator>=(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                       const std::basic_string<Char, Traits, STDAllocator>& rhs) noexcept -> bool {
+          class Growth, class LongTier>
+inline auto operator>=(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const std::basic_string<Char, Traits, STDAllocator>& rhs) noexcept -> bool {
     return !(lhs < rhs);
 }
 
@@ -5259,12 +8800,13 @@ inline auto operator>=(const basic_small_string<Char, Buffer, Core, Traits, Allo
  * std::basic_string
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
           template <typename, bool> class Core, class Traits, class Allocator, class STDAllocator, bool NullTerminated,
-          float Growth>
+          class Growth, class LongTier>
 inline auto operator>=(
   const std::basic_string<Char, Traits, STDAllocator>& lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return !(lhs < rhs);
 }
 
@@ -5282,10 +8824,12 @@ inline auto operator>=(
  * C-style strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator>=(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                       const Char* rhs) noexcept -> bool {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator>=(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  const Char* rhs) noexcept -> bool {
     return !(lhs < rhs);
 }
 
@@ -5303,11 +8847,13 @@ inline auto operator>=(const basic_small_string<Char, Buffer, Core, Traits, Allo
  * C-style strings
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator>=(
   const Char* lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return !(lhs < rhs);
 }
 
@@ -5325,10 +8871,12 @@ inline auto operator>=(
  * std::string_view
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-inline auto operator>=(const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& lhs,
-                       std::string_view rhs) noexcept -> bool {
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+inline auto operator>=(
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& lhs,
+  std::type_identity_t<std::basic_string_view<Char, Traits>> rhs) noexcept -> bool {
     return !(lhs < rhs);
 }
 
@@ -5346,11 +8894,13 @@ inline auto operator>=(const basic_small_string<Char, Buffer, Core, Traits, Allo
  * std::string_view
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
 inline auto operator>=(
-  std::string_view lhs,
-  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& rhs) noexcept -> bool {
+  std::type_identity_t<std::basic_string_view<Char, Traits>> lhs,
+  const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& rhs) noexcept
+  -> bool {
     return !(lhs < rhs);
 }
 
@@ -5361,6 +8911,343 @@ using small_byte_string =
 static_assert(sizeof(small_string) == 8, "small_string should be same as a pointer");
 static_assert(sizeof(small_byte_string) == 8, "small_byte_string should be same as a pointer");
 
+using wide_small_string = basic_small_string<char, small_string_buffer, wide_core>;
+using wide_small_byte_string =
+  basic_small_string<char, small_string_buffer, wide_core, std::char_traits<char>, std::allocator<char>, false>;
+
+static_assert(sizeof(wide_small_string) == 16, "wide_small_string should be same as two pointers");
+static_assert(sizeof(wide_small_byte_string) == 16, "wide_small_byte_string should be same as two pointers");
+
+using pooled_small_string = basic_small_string<char, small_string_buffer, pooled_core>;
+using pooled_small_byte_string =
+  basic_small_string<char, small_string_buffer, pooled_core, std::char_traits<char>, std::allocator<char>, false>;
+
+static_assert(sizeof(pooled_small_string) == 8, "pooled_small_string should be same as a pointer");
+
+using shared_small_string = basic_small_string<char, small_string_buffer, shared_core>;
+using shared_small_byte_string =
+  basic_small_string<char, small_string_buffer, shared_core, std::char_traits<char>, std::allocator<char>, false>;
+
+static_assert(sizeof(shared_small_string) == 8, "shared_small_string should be same as a pointer");
+
+using borrowing_small_string = basic_small_string<char, small_string_buffer, borrowing_core>;
+using borrowing_small_byte_string =
+  basic_small_string<char, small_string_buffer, borrowing_core, std::char_traits<char>, std::allocator<char>, false>;
+
+static_assert(sizeof(borrowing_small_string) == 16, "borrowing_small_string should be same as two pointers");
+
+using mapped_small_string = basic_small_string<char, small_string_buffer, malloc_core, std::char_traits<char>,
+                                               std::allocator<char>, true, default_growth, mmap_long_tier<>>;
+using mapped_small_byte_string = basic_small_string<char, small_string_buffer, malloc_core, std::char_traits<char>,
+                                                    std::allocator<char>, false, default_growth, mmap_long_tier<>>;
+
+static_assert(sizeof(mapped_small_string) == 8, "mapped_small_string should be same as a pointer");
+
+using huge_small_string = basic_small_string<char, small_string_buffer, huge_core>;
+using huge_small_byte_string =
+  basic_small_string<char, small_string_buffer, huge_core, std::char_traits<char>, std::allocator<char>, false>;
+
+static_assert(sizeof(huge_small_string) == 8, "huge_small_string should be same as a pointer");
+
+using offset_small_string = basic_small_string<char, small_string_buffer, offset_core>;
+using offset_small_byte_string =
+  basic_small_string<char, small_string_buffer, offset_core, std::char_traits<char>, std::allocator<char>, false>;
+
+static_assert(sizeof(offset_small_string) == 8, "offset_small_string should be same as a pointer");
+
+using u16string = basic_small_string<char16_t>;
+using u32string = basic_small_string<char32_t>;
+using wide_u16string = basic_small_string<char16_t, small_string_buffer, wide_core>;
+using wide_u32string = basic_small_string<char32_t, small_string_buffer, wide_core>;
+
+static_assert(sizeof(u16string) == 8, "u16string should be same as a pointer");
+static_assert(sizeof(u32string) == 8, "u32string should be same as a pointer");
+
+/**
+ * @brief Whether a move followed by the destruction of the source can be replaced by a memcpy of the object
+ * @tparam T Type to check
+ * @note Trivially copyable types are, other types opt in with a trivially_relocatable member type, which every
+ * basic_small_string over a malloc_core family core provides
+ */
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T>
+{};
+
+template <typename T>
+    requires requires { typename T::trivially_relocatable; }
+struct is_trivially_relocatable<T> : T::trivially_relocatable
+{};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+static_assert(is_trivially_relocatable_v<small_string>, "small_string should be relocatable with memcpy");
+static_assert(is_trivially_relocatable_v<wide_small_string>, "wide_small_string should be relocatable with memcpy");
+
+/**
+ * @brief Contiguous sequence of trivially relocatable strings, growing with std::realloc
+ * @tparam String Element type, is_trivially_relocatable_v<String> must hold
+ * @note std::vector moves and destroys every element when it reallocates, string_vector moves the bytes only:
+ * realloc often extends the block in place, otherwise it is one memcpy of sizeof(String) * size bytes
+ * @note insert and erase shift the tail with memmove, iterators are pointers and are invalidated like std::vector's
+ */
+template <typename String = small_string>
+class string_vector
+{
+    static_assert(is_trivially_relocatable_v<String>, "string_vector relocates its elements with memcpy");
+
+   public:
+    using value_type = String;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = String&;
+    using const_reference = const String&;
+    using pointer = String*;
+    using const_pointer = const String*;
+    using iterator = String*;
+    using const_iterator = const String*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    string_vector() noexcept = default;
+
+    string_vector(std::initializer_list<String> init) : string_vector(init.begin(), init.end()) {}
+
+    template <std::input_iterator InputIt>
+    string_vector(InputIt first, InputIt last) {
+        if constexpr (std::forward_iterator<InputIt>) {
+            reserve(static_cast<size_type>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    string_vector(const string_vector& other) : string_vector(other.begin(), other.end()) {}
+
+    string_vector(string_vector&& other) noexcept
+        : _data{std::exchange(other._data, nullptr)},
+          _size{std::exchange(other._size, 0)},
+          _capacity{std::exchange(other._capacity, 0)} {}
+
+    auto operator=(const string_vector& other) -> string_vector& {
+        if (this != &other) {
+            string_vector copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    auto operator=(string_vector&& other) noexcept -> string_vector& {
+        string_vector gone(std::move(other));
+        swap(gone);
+        return *this;
+    }
+
+    ~string_vector() {
+        clear();
+        std::free(_data);
+    }
+
+    [[nodiscard]] auto size() const noexcept -> size_type { return _size; }
+    [[nodiscard]] auto capacity() const noexcept -> size_type { return _capacity; }
+    [[nodiscard]] auto empty() const noexcept -> bool { return _size == 0; }
+    [[nodiscard]] auto max_size() const noexcept -> size_type {
+        return std::numeric_limits<difference_type>::max() / sizeof(String);
+    }
+
+    [[nodiscard]] auto data() noexcept -> pointer { return _data; }
+    [[nodiscard]] auto data() const noexcept -> const_pointer { return _data; }
+    [[nodiscard]] auto begin() noexcept -> iterator { return _data; }
+    [[nodiscard]] auto begin() const noexcept -> const_iterator { return _data; }
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator { return _data; }
+    [[nodiscard]] auto end() noexcept -> iterator { return _data + _size; }
+    [[nodiscard]] auto end() const noexcept -> const_iterator { return _data + _size; }
+    [[nodiscard]] auto cend() const noexcept -> const_iterator { return _data + _size; }
+    [[nodiscard]] auto rbegin() noexcept -> reverse_iterator { return reverse_iterator(end()); }
+    [[nodiscard]] auto rbegin() const noexcept -> const_reverse_iterator { return const_reverse_iterator(end()); }
+    [[nodiscard]] auto rend() noexcept -> reverse_iterator { return reverse_iterator(begin()); }
+    [[nodiscard]] auto rend() const noexcept -> const_reverse_iterator { return const_reverse_iterator(begin()); }
+
+    [[nodiscard]] auto operator[](size_type pos) noexcept -> reference {
+        Assert(pos < _size, "string_vector index is out of range");
+        return _data[pos];
+    }
+    [[nodiscard]] auto operator[](size_type pos) const noexcept -> const_reference {
+        Assert(pos < _size, "string_vector index is out of range");
+        return _data[pos];
+    }
+    [[nodiscard]] auto at(size_type pos) -> reference {
+        if (pos >= _size) [[unlikely]] {
+            throw std::out_of_range("string_vector::at: pos is out of range");
+        }
+        return _data[pos];
+    }
+    [[nodiscard]] auto at(size_type pos) const -> const_reference {
+        if (pos >= _size) [[unlikely]] {
+            throw std::out_of_range("string_vector::at: pos is out of range");
+        }
+        return _data[pos];
+    }
+    [[nodiscard]] auto front() noexcept -> reference { return (*this)[0]; }
+    [[nodiscard]] auto front() const noexcept -> const_reference { return (*this)[0]; }
+    [[nodiscard]] auto back() noexcept -> reference { return (*this)[_size - 1]; }
+    [[nodiscard]] auto back() const noexcept -> const_reference { return (*this)[_size - 1]; }
+
+    /**
+     * @brief Makes room for at least new_capacity strings, relocating the elements with std::realloc
+     * @param new_capacity Minimum capacity
+     * @throws std::bad_alloc if the block cannot be grown, the elements are untouched then
+     */
+    void reserve(size_type new_capacity) {
+        if (new_capacity > _capacity) {
+            relocate_to(new_capacity);
+        }
+    }
+
+    /**
+     * @brief Gives the spare capacity back, relocating the elements with std::realloc
+     */
+    void shrink_to_fit() {
+        if (_size == 0) {
+            std::free(std::exchange(_data, nullptr));
+            _capacity = 0;
+        } else if (_size < _capacity) {
+            relocate_to(_size);
+        }
+    }
+
+    template <typename... Args>
+    auto emplace_back(Args&&... args) -> reference {
+        if (_size == _capacity) [[unlikely]] {
+            // args may refer to an element, so the string is built before the block moves
+            String value(std::forward<Args>(args)...);
+            relocate_to(grown_capacity(_size + 1));
+            return *::new (static_cast<void*>(_data + _size++)) String(std::move(value));
+        }
+        auto* slot = ::new (static_cast<void*>(_data + _size)) String(std::forward<Args>(args)...);
+        ++_size;
+        return *slot;
+    }
+
+    void push_back(const String& value) { emplace_back(value); }
+    void push_back(String&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept {
+        Assert(_size > 0, "pop_back on an empty string_vector");
+        std::destroy_at(_data + --_size);
+    }
+
+    /**
+     * @brief Constructs a string in front of pos, the tail is shifted with memmove
+     * @return Iterator to the new string
+     */
+    template <typename... Args>
+    auto emplace(const_iterator pos, Args&&... args) -> iterator {
+        auto index = static_cast<size_type>(pos - _data);
+        Assert(index <= _size, "string_vector insert position is out of range");
+        String value(std::forward<Args>(args)...);
+        if (_size == _capacity) {
+            relocate_to(grown_capacity(_size + 1));
+        }
+        std::memmove(static_cast<void*>(_data + index + 1), static_cast<const void*>(_data + index),
+                     (_size - index) * sizeof(String));
+        ::new (static_cast<void*>(_data + index)) String(std::move(value));
+        ++_size;
+        return _data + index;
+    }
+
+    auto insert(const_iterator pos, const String& value) -> iterator { return emplace(pos, value); }
+    auto insert(const_iterator pos, String&& value) -> iterator { return emplace(pos, std::move(value)); }
+
+    /**
+     * @brief Destroys the strings in [first, last), the tail is shifted with memmove
+     * @return Iterator following the last erased string
+     */
+    auto erase(const_iterator first, const_iterator last) -> iterator {
+        auto index = static_cast<size_type>(first - _data);
+        auto count = static_cast<size_type>(last - first);
+        Assert(index + count <= _size, "string_vector erase range is out of range");
+        std::destroy(_data + index, _data + index + count);
+        std::memmove(static_cast<void*>(_data + index), static_cast<const void*>(_data + index + count),
+                     (_size - index - count) * sizeof(String));
+        _size -= count;
+        return _data + index;
+    }
+
+    auto erase(const_iterator pos) -> iterator { return erase(pos, pos + 1); }
+
+    void resize(size_type new_size) {
+        if (new_size < _size) {
+            erase(_data + new_size, end());
+            return;
+        }
+        reserve(new_size);
+        for (; _size < new_size; ++_size) {
+            ::new (static_cast<void*>(_data + _size)) String();
+        }
+    }
+
+    void resize(size_type new_size, const String& value) {
+        if (new_size < _size) {
+            erase(_data + new_size, end());
+            return;
+        }
+        if (new_size > _capacity) {
+            // value may be an element
+            String copy(value);
+            relocate_to(new_size);
+            resize(new_size, copy);
+            return;
+        }
+        for (; _size < new_size; ++_size) {
+            ::new (static_cast<void*>(_data + _size)) String(value);
+        }
+    }
+
+    void clear() noexcept {
+        std::destroy(_data, _data + _size);
+        _size = 0;
+    }
+
+    void swap(string_vector& other) noexcept {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+    }
+
+    friend void swap(string_vector& lhs, string_vector& rhs) noexcept { lhs.swap(rhs); }
+
+    friend auto operator==(const string_vector& lhs, const string_vector& rhs) -> bool {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+   private:
+    [[nodiscard]] auto grown_capacity(size_type minimum) const noexcept -> size_type {
+        return std::max({minimum, _capacity + _capacity / 2, size_type{4}});
+    }
+
+    /**
+     * @brief Moves the elements to a block of new_capacity strings, the block itself may stay in place
+     * @note The usable size of the block becomes capacity, like the string buffers harvest their slack
+     */
+    void relocate_to(size_type new_capacity) {
+        if (new_capacity > max_size()) [[unlikely]] {
+            throw std::length_error("string_vector: too many strings");
+        }
+        auto* block = std::realloc(static_cast<void*>(_data), new_capacity * sizeof(String));
+        if (block == nullptr) [[unlikely]] {
+            throw std::bad_alloc();
+        }
+        _data = static_cast<String*>(block);
+        _capacity = process_memory::usable_size(block, new_capacity * sizeof(String)) / sizeof(String);
+    }
+
+    String* _data = nullptr;
+    size_type _size = 0;
+    size_type _capacity = 0;
+};
+
 /**
  * @brief Converts a value to a small string using fmt::format.
  *
@@ -5447,15 +9334,18 @@ auto to_small_string(std::string_view view) -> String {
  * @note Provides zero-copy formatting by creating string_view from string data
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-struct fmt::formatter<small::basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+struct fmt::formatter<
+  small::basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>>
     : fmt::formatter<std::string_view>
 {
     using fmt::formatter<std::string_view>::parse;
 
-    auto format(const small::basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated>& str,
-                fmt::format_context& ctx) const noexcept {
+    auto format(
+      const small::basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& str,
+      fmt::format_context& ctx) const noexcept {
         return fmt::formatter<std::string_view>::format({str.data(), str.size()}, ctx);
     }
 };
@@ -5468,6 +9358,39 @@ using small_byte_string = basic_small_string<char, small_string_buffer, pmr_core
 
 static_assert(sizeof(small_string) == 16, "small_string should be same as a pointer");
 
+// strings on a monotonic_buffer_resource or another arena, destroying them is free and release() reclaims the buffers
+using arena_string = basic_small_string<char, small_string_buffer, arena_core, std::char_traits<char>,
+                                        std::pmr::polymorphic_allocator<char>, true>;
+using arena_byte_string = basic_small_string<char, small_string_buffer, arena_core, std::char_traits<char>,
+                                             std::pmr::polymorphic_allocator<char>, false>;
+
+// strings allocating from the resource_registry scope of their thread, the resource is tagged on the buffers
+using tagged_string = basic_small_string<char, small_string_buffer, tagged_core>;
+using tagged_byte_string =
+  basic_small_string<char, small_string_buffer, tagged_core, std::char_traits<char>, std::allocator<char>, false>;
+
+static_assert(sizeof(arena_string) == 16, "arena_string should be same as small_string");
+static_assert(sizeof(tagged_string) == 8, "tagged_string should be same as a pointer");
+static_assert(std::is_trivially_destructible_v<arena_string>, "arena_string should be trivially destructible");
+
+/**
+ * @brief Relocates the buffers of pmr small strings into a fresh resource in one sequential pass
+ * @tparam Range Range of pmr small strings
+ * @param strings Strings to compact, every string moves to resource, Internal strings keep their bytes
+ * @param resource Resource receiving the buffers, typically a new monotonic_buffer_resource
+ * @return Bytes reclaimed by trimming the buffers to their sizes
+ * @note The buffers are allocated in the order of the range, so an arena receives them back to back
+ * @note Afterwards no string refers to the old resource anymore, an arena behind it can be released in one go
+ */
+template <typename Range>
+auto compact(Range&& strings, std::pmr::memory_resource* resource) -> std::size_t {
+    std::size_t reclaimed = 0;
+    for (auto& str : strings) {
+        reclaimed += str.relocate(resource);
+    }
+    return reclaimed;
+}
+
 /**
  * @brief Converts a value to a PMR small string using fmt::format.
  *
@@ -5559,6 +9482,226 @@ auto to_small_string(std::string_view view, std::pmr::polymorphic_allocator<char
 
 namespace small {
 
+/**
+ * @brief Interning table behind small::atom, every distinct text is stored once and numbered
+ * @note The texts live in a monotonic arena until the table dies, atoms of a table must not outlive it
+ * @note Thread safe, a text already interned only takes a shared lock
+ */
+class atom_table
+{
+   public:
+    /**
+     * @brief One interned text
+     * @note The text is null terminated, hash is transparent_string_hash of the text
+     */
+    struct entry
+    {
+        std::size_t hash;  ///< std::hash<std::string_view> of the text
+        uint32_t id;       ///< Dense id, the order of interning starting at 1
+        uint32_t size;     ///< Length of the text
+        const char* text;  ///< Null terminated text, stored right after the entry
+    };
+
+    /**
+     * @brief Creates an arena scoped table
+     * @param upstream Resource the arena takes its blocks from
+     */
+    explicit atom_table(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) : _arena(upstream) {}
+
+    atom_table(const atom_table&) = delete;
+    auto operator=(const atom_table&) -> atom_table& = delete;
+
+    /**
+     * @brief Returns the process wide table, it is never destroyed so atoms stay valid during static destruction
+     */
+    [[nodiscard]] static auto global() -> atom_table& {
+        static auto* table = new atom_table();
+        return *table;
+    }
+
+    /**
+     * @brief Returns the entry of text, adding it on first use
+     * @param text Text to intern, the empty text has no entry
+     * @return Entry of text, nullptr for the empty text
+     * @throws std::length_error if the table holds 2^32 - 1 texts
+     */
+    [[nodiscard]] auto intern(std::string_view text) -> const entry* {
+        if (text.empty()) {
+            return nullptr;
+        }
+        {
+            std::shared_lock lock(_mutex);
+            if (auto it = _index.find(text); it != _index.end()) [[likely]] {
+                return it->second;
+            }
+        }
+        std::unique_lock lock(_mutex);
+        if (auto it = _index.find(text); it != _index.end()) {
+            return it->second;
+        }
+        if (_entries.size() >= std::numeric_limits<uint32_t>::max() - 1) [[unlikely]] {
+            throw std::length_error("atom_table: too many atoms");
+        }
+        auto* storage = static_cast<char*>(_arena.allocate(sizeof(entry) + text.size() + 1, alignof(entry)));
+        auto* text_copy = storage + sizeof(entry);
+        std::memcpy(text_copy, text.data(), text.size());
+        text_copy[text.size()] = '\0';
+        auto* new_entry = std::construct_at(reinterpret_cast<entry*>(storage),
+                                            entry{.hash = std::hash<std::string_view>{}(text),
+                                                  .id = static_cast<uint32_t>(_entries.size() + 1),
+                                                  .size = static_cast<uint32_t>(text.size()),
+                                                  .text = text_copy});
+        _entries.push_back(new_entry);
+        _index.emplace(std::string_view{text_copy, text.size()}, new_entry);
+        return new_entry;
+    }
+
+    /**
+     * @brief Looks text up without interning it
+     * @return Entry of text, nullptr if it was never interned
+     */
+    [[nodiscard]] auto find(std::string_view text) const -> const entry* {
+        std::shared_lock lock(_mutex);
+        auto it = _index.find(text);
+        return it == _index.end() ? nullptr : it->second;
+    }
+
+    /**
+     * @brief Returns the entry of an id
+     * @param id Id of an interned text, 0 is the empty text
+     * @return Entry of id, nullptr for 0 and unknown ids
+     */
+    [[nodiscard]] auto at(uint32_t id) const -> const entry* {
+        std::shared_lock lock(_mutex);
+        return id == 0 or id > _entries.size() ? nullptr : _entries[id - 1];
+    }
+
+    /// @brief Returns the number of interned texts
+    [[nodiscard]] auto size() const -> std::size_t {
+        std::shared_lock lock(_mutex);
+        return _entries.size();
+    }
+
+   private:
+    /// Hashes the keys of _index, the text views point into the arena
+    struct index_hash
+    {
+        using is_transparent = void;
+        [[nodiscard]] auto operator()(std::string_view text) const noexcept -> std::size_t {
+            return std::hash<std::string_view>{}(text);
+        }
+    };
+
+    mutable std::shared_mutex _mutex;                     ///< Readers look up, writers intern
+    std::pmr::monotonic_buffer_resource _arena;           ///< Entries and texts
+    std::vector<const entry*> _entries;                   ///< Entries by id - 1
+    /// Entries by text
+    std::unordered_map<std::string_view, const entry*, index_hash, std::equal_to<>> _index;
+};
+
+/**
+ * @brief An interned string, 8 bytes, equality and hash are O(1)
+ * @note Holds a pointer to an atom_table entry, equal texts of one table share the entry, so two atoms are equal iff
+ * the pointers are equal, the empty atom holds nullptr
+ * @note Immutable, converts to std::string_view and small strings, atoms of different tables never compare equal
+ * @example
+ *   small::atom key{"http.status_code"};
+ *   std::unordered_map<small::atom, int> counts;
+ *   ++counts[key];
+ */
+class atom
+{
+   public:
+    /// @brief Creates the empty atom
+    constexpr atom() noexcept = default;
+
+    /**
+     * @brief Interns text
+     * @param text Text to intern
+     * @param table Table to intern into, the global table by default
+     */
+    explicit atom(std::string_view text, atom_table& table = atom_table::global()) : _entry(table.intern(text)) {}
+
+    /**
+     * @brief Returns the atom of an already interned text without interning it
+     * @return The atom, or the empty atom if text was never interned
+     */
+    [[nodiscard]] static auto find(std::string_view text, const atom_table& table = atom_table::global()) -> atom {
+        return atom{table.find(text)};
+    }
+
+    /**
+     * @brief Returns the atom of an id
+     * @return The atom, or the empty atom for 0 and unknown ids
+     */
+    [[nodiscard]] static auto from_id(uint32_t id, const atom_table& table = atom_table::global()) -> atom {
+        return atom{table.at(id)};
+    }
+
+    /// @brief Returns the 32-bit id of the atom in its table, 0 for the empty atom
+    [[nodiscard, gnu::always_inline]] auto id() const noexcept -> uint32_t {
+        return _entry == nullptr ? 0 : _entry->id;
+    }
+
+    /// @brief Returns the hash of the text, equal to std::hash<std::string_view> of it
+    [[nodiscard, gnu::always_inline]] auto hash() const noexcept -> std::size_t {
+        return _entry == nullptr ? std::hash<std::string_view>{}(std::string_view{}) : _entry->hash;
+    }
+
+    [[nodiscard, gnu::always_inline]] auto size() const noexcept -> std::size_t {
+        return _entry == nullptr ? 0 : _entry->size;
+    }
+
+    [[nodiscard, gnu::always_inline]] auto empty() const noexcept -> bool { return _entry == nullptr; }
+
+    /// @brief Returns the null terminated text
+    [[nodiscard, gnu::always_inline]] auto c_str() const noexcept -> const char* {
+        return _entry == nullptr ? "" : _entry->text;
+    }
+
+    [[nodiscard, gnu::always_inline]] auto data() const noexcept -> const char* { return c_str(); }
+
+    [[nodiscard, gnu::always_inline]] auto view() const noexcept -> std::string_view {
+        return _entry == nullptr ? std::string_view{} : std::string_view{_entry->text, _entry->size};
+    }
+
+    [[nodiscard, gnu::always_inline]] operator std::string_view() const noexcept { return view(); }
+
+    /**
+     * @brief Copies the text into a small string
+     * @tparam String Target string type, small_string by default
+     */
+    template <typename String = small_string>
+    [[nodiscard]] auto to_string() const -> String {
+        return String{view()};
+    }
+
+    [[nodiscard, gnu::always_inline]] friend auto operator==(const atom& lhs, const atom& rhs) noexcept -> bool {
+        return lhs._entry == rhs._entry;
+    }
+
+    [[nodiscard]] friend auto operator==(const atom& lhs, std::string_view rhs) noexcept -> bool {
+        return lhs.view() == rhs;
+    }
+
+    /// Orders by text, not by id, so ordered containers iterate alphabetically, equal texts of different tables are
+    /// ordered by their entries so that only equal atoms compare equal
+    [[nodiscard]] friend auto operator<=>(const atom& lhs, const atom& rhs) noexcept -> std::strong_ordering {
+        if (lhs._entry == rhs._entry) {
+            return std::strong_ordering::equal;
+        }
+        auto by_text = lhs.view() <=> rhs.view();
+        return by_text != 0 ? by_text : std::compare_three_way{}(lhs._entry, rhs._entry);
+    }
+
+   private:
+    explicit atom(const atom_table::entry* entry) noexcept : _entry(entry) {}
+
+    const atom_table::entry* _entry = nullptr;  ///< Interned entry, nullptr for the empty atom
+};
+
+static_assert(sizeof(atom) == 8, "atom should be same as a pointer");
+
 /**
  * @brief Transparent hash functor for heterogeneous lookup in unordered containers
  * @note Enables lookup with string_view without constructing small_string
@@ -5583,12 +9726,17 @@ struct transparent_string_hash {
         return std::hash<std::string_view>{}(s);
     }
 
+    /// Atoms carry the hash of their text, so they hash in O(1) and match the string_view hash
+    [[nodiscard]] auto operator()(const atom& a) const noexcept -> std::size_t { return a.hash(); }
+
     template <typename Char,
-              template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-              template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
+              template <typename, template <class, bool> class, class T, class A, bool N, class G, class L>
+              class Buffer,
+              template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+              class LongTier>
     [[nodiscard]] auto operator()(
-      const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>& str) const noexcept
-      -> std::size_t {
+      const basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>& str) const
+      noexcept -> std::size_t {
         return std::hash<std::string_view>{}(str);
     }
 };
@@ -5605,6 +9753,9 @@ struct transparent_string_equal {
     [[nodiscard]] auto operator()(const T1& lhs, const T2& rhs) const noexcept -> bool {
         return std::string_view(lhs) == std::string_view(rhs);
     }
+
+    /// Interned atoms compare by pointer
+    [[nodiscard]] auto operator()(const atom& lhs, const atom& rhs) const noexcept -> bool { return lhs == rhs; }
 };
 
 /**
@@ -5636,18 +9787,28 @@ namespace std {
  * @note Provides efficient hashing by avoiding string copying
  */
 template <typename Char,
-          template <typename, template <class, bool> class, class T, class A, bool N, float G> class Buffer,
-          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, float Growth>
-struct hash<small::basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>>
+          template <typename, template <class, bool> class, class T, class A, bool N, class G, class L> class Buffer,
+          template <typename, bool> class Core, class Traits, class Allocator, bool NullTerminated, class Growth,
+          class LongTier>
+struct hash<small::basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>>
 {
     /// Type aliases for hash functor compatibility
     using argument_type =
-      small::basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth>;  ///< Input string type
-    using result_type = std::size_t;                                                             ///< Hash result type
+      small::basic_small_string<Char, Buffer, Core, Traits, Allocator, NullTerminated, Growth, LongTier>;
+    using result_type = std::size_t;  ///< Hash result type
 
     auto operator()(const argument_type& str) const noexcept -> result_type {
         return std::hash<std::basic_string_view<Char, Traits>>{}(str);
     }
 };
 
+/**
+ * @brief std::hash specialization for small::atom, returns the hash stored at interning
+ */
+template <>
+struct hash<small::atom>
+{
+    auto operator()(const small::atom& a) const noexcept -> std::size_t { return a.hash(); }
+};
+
 }  // namespace std
@@ -356,6 +356,8 @@ TEST_CASE("smallstring resource management") {
         // Initial growth
         str = "initial";
         capacities.push_back(str.capacity());
+        // malloc may hand out a larger block than the 8 bytes asked for, its slack is capacity too
+        auto initial_block = small::process_memory::usable_size(const_cast<char*>(str.data()), 8) / 8 * 8;
 
         // Reserve
         str.reserve(100);
@@ -369,10 +371,10 @@ TEST_CASE("smallstring resource management") {
         str.resize(10);
         capacities.push_back(str.capacity());
 
-        CHECK(capacities[0] == 6);    // empty internal string's cap
-        CHECK(capacities[1] == 7);    // "initial" will alignUp to 8, then reduce a '\0'
-        CHECK(capacities[2] == 103);  // 100 will alignUp to 104, then reduce a '\0'
-        CHECK(capacities[3] == 103);  // resize will not change capacity
+        CHECK(capacities[0] == 6);                  // empty internal string's cap
+        CHECK(capacities[1] == initial_block - 1);  // "initial" will alignUp to 8, grow to the block, reduce a '\0'
+        CHECK(capacities[2] == 103);                // 100 will alignUp to 104, then reduce a '\0'
+        CHECK(capacities[3] == 103);                // resize will not change capacity
 
         // shrink_to_fit might reduce capacity
         auto cap_before_shrink = str.capacity();
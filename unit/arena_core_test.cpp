@@ -0,0 +1,133 @@
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+namespace {
+
+// an arena that counts what the strings hand back, arena strings should never hand back anything
+class counting_arena : public std::pmr::memory_resource
+{
+   public:
+    std::pmr::monotonic_buffer_resource arena;
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+
+   private:
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+        ++allocations;
+        return arena.allocate(bytes, alignment);
+    }
+
+    auto do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) -> void override {
+        ++deallocations;
+        arena.deallocate(ptr, bytes, alignment);
+    }
+
+    [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override {
+        return this == &other;
+    }
+};
+
+}  // namespace
+
+static_assert(std::is_trivially_destructible_v<small::pmr::arena_string>);
+static_assert(std::is_trivially_destructible_v<small::pmr::arena_byte_string>);
+static_assert(not std::is_trivially_destructible_v<small::pmr::small_string>);
+static_assert(small::is_trivially_relocatable_v<small::pmr::arena_string>);
+
+TEST_CASE("arena strings never deallocate") {
+    counting_arena resource;
+    std::pmr::polymorphic_allocator<char> alloc{&resource};
+
+    SUBCASE("every tier") {
+        {
+            small::pmr::arena_string internal_str("tiny", alloc);
+            small::pmr::arena_string short_str(std::string(100, 's'), alloc);
+            small::pmr::arena_string median_str(std::string(1000, 'm'), alloc);
+            small::pmr::arena_string long_str(std::string(20000, 'l'), alloc);
+            small::pmr::arena_byte_string byte_str(std::string(300, 'b'), alloc);
+            CHECK(internal_str == "tiny");
+            CHECK(short_str.size() == 100);
+            CHECK(median_str.size() == 1000);
+            CHECK(long_str.size() == 20000);
+            CHECK(byte_str.size() == 300);
+        }
+        CHECK(resource.allocations == 4);
+        CHECK(resource.deallocations == 0);
+    }
+
+    SUBCASE("growth, shrink and reassignment") {
+        small::pmr::arena_string str("seed", alloc);
+        std::string expected = "seed";
+        for (int i = 0; i < 2000; ++i) {
+            str.append("0123456789");
+            expected.append("0123456789");
+        }
+        CHECK(std::string_view(str) == expected);
+        str.resize(50);
+        str.shrink_to_fit();
+        CHECK(std::string_view(str) == expected.substr(0, 50));
+        str = std::string(5000, 'r');
+        CHECK(str.size() == 5000);
+        str = "back to internal";
+        CHECK(str == "back to internal");
+        CHECK(resource.allocations > 0);
+        CHECK(resource.deallocations == 0);
+    }
+
+    SUBCASE("copy, move and swap") {
+        small::pmr::arena_string first(std::string(600, 'f'), alloc);
+        small::pmr::arena_string second(std::string(40, 'g'), alloc);
+        small::pmr::arena_string copy(first);
+        CHECK(copy == first);
+        small::pmr::arena_string moved(std::move(copy));
+        CHECK(moved == first);
+        first.swap(second);
+        CHECK(first.size() == 40);
+        CHECK(second.size() == 600);
+        second = first;
+        CHECK(second == first);
+        CHECK(resource.deallocations == 0);
+    }
+
+    SUBCASE("containers of arena strings") {
+        {
+            std::vector<small::pmr::arena_string> strings;
+            for (std::size_t i = 0; i < 200; ++i) {
+                strings.emplace_back(std::string(i * 7, 'v'), alloc);
+            }
+            strings.erase(strings.begin(), strings.begin() + 50);
+            CHECK(strings.front().size() == 350);
+            CHECK(strings.back().size() == 199 * 7);
+        }
+        CHECK(resource.deallocations == 0);
+    }
+}
+
+TEST_CASE("arena strings compact into a fresh arena") {
+    counting_arena old_arena;
+    counting_arena new_arena;
+    std::vector<small::pmr::arena_string> strings;
+    std::vector<std::string> expected;
+    for (std::size_t i = 0; i < 100; ++i) {
+        expected.emplace_back(i * 31, static_cast<char>('a' + i % 26));
+        strings.emplace_back(expected.back(), &old_arena);
+        strings.back().reserve(i * 40);
+    }
+    CHECK(small::pmr::compact(strings, &new_arena) > 0);
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        CHECK(std::string_view(strings[i]) == expected[i]);
+    }
+    CHECK(old_arena.deallocations == 0);
+    // nothing refers to the old arena anymore
+    old_arena.arena.release();
+    strings[42].append("still valid");
+    CHECK(strings[42].ends_with("still valid"));
+    CHECK(new_arena.deallocations == 0);
+}
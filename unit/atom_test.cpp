@@ -0,0 +1,162 @@
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+TEST_CASE("atom interning") {
+    SUBCASE("object size") { CHECK(sizeof(small::atom) == 8); }
+
+    SUBCASE("equal texts intern once") {
+        small::atom a("atom_test.alpha");
+        small::atom b(std::string("atom_test.alpha"));
+        small::atom c("atom_test.beta");
+        CHECK(a == b);
+        CHECK(a.c_str() == b.c_str());
+        CHECK(a.id() == b.id());
+        CHECK(a != c);
+        CHECK(a.id() != c.id());
+        CHECK(a == std::string_view("atom_test.alpha"));
+        CHECK(a.size() == 15);
+        CHECK(a.c_str()[a.size()] == '\0');
+    }
+
+    SUBCASE("empty atom") {
+        small::atom empty;
+        CHECK(empty.empty());
+        CHECK(empty.id() == 0);
+        CHECK(empty.view().empty());
+        CHECK(std::string_view(empty.c_str()).empty());
+        CHECK(small::atom("") == empty);
+        CHECK(small::atom::from_id(0) == empty);
+    }
+
+    SUBCASE("hash matches string_view hash") {
+        small::atom a("atom_test.hash");
+        CHECK(a.hash() == std::hash<std::string_view>{}("atom_test.hash"));
+        CHECK(std::hash<small::atom>{}(a) == a.hash());
+        CHECK(small::transparent_string_hash{}(a) == small::transparent_string_hash{}(std::string_view("atom_test.hash")));
+        CHECK(small::atom().hash() == std::hash<std::string_view>{}(std::string_view{}));
+    }
+
+    SUBCASE("round trip through small strings") {
+        small::small_string long_text(std::string(300, 'q'));
+        small::atom a(long_text);
+        CHECK(a.size() == 300);
+        auto back = a.to_string();
+        CHECK(back == long_text);
+        auto wide = a.to_string<small::wide_small_string>();
+        CHECK(wide == std::string_view(long_text));
+    }
+
+    SUBCASE("ids resolve back to atoms") {
+        small::atom a("atom_test.by_id");
+        CHECK(small::atom::from_id(a.id()) == a);
+        CHECK(small::atom::from_id(static_cast<uint32_t>(small::atom_table::global().size() + 1)).empty());
+        CHECK(small::atom::find("atom_test.by_id") == a);
+        CHECK(small::atom::find("atom_test.never_interned").empty());
+    }
+
+    SUBCASE("ordering follows the text") {
+        small::atom b("atom_test.order_b");
+        small::atom a("atom_test.order_a");
+        CHECK(a < b);
+        std::map<small::atom, int> ordered{{b, 2}, {a, 1}};
+        CHECK(ordered.begin()->first == a);
+    }
+}
+
+TEST_CASE("atom arena scoped table") {
+    std::pmr::monotonic_buffer_resource upstream;
+    small::atom_table table(&upstream);
+    small::atom local("atom_test.scoped", table);
+    small::atom global("atom_test.scoped");
+    CHECK(local.view() == global.view());
+    CHECK(local != global);
+    CHECK(local.id() == 1);
+    CHECK(table.size() == 1);
+    CHECK(small::atom("atom_test.scoped", table) == local);
+    CHECK(small::atom::from_id(1, table) == local);
+    CHECK(small::atom::find("atom_test.scoped", table) == local);
+    CHECK(table.size() == 1);
+}
+
+TEST_CASE("atom ordering across tables agrees with equality") {
+    small::atom_table first;
+    small::atom_table second;
+    small::atom a("atom_test.twice", first);
+    small::atom b("atom_test.twice", second);
+    small::atom c("atom_test.twice_after", first);
+    CHECK(a != b);
+    CHECK((a <=> b) != 0);
+    CHECK((a < b) != (b < a));
+    CHECK((a <=> a) == 0);
+    CHECK(a < c);
+    CHECK(b < c);
+    std::set<small::atom> atoms{a, b, c};
+    CHECK(atoms.size() == 3);
+    CHECK(atoms.rbegin()->view() == "atom_test.twice_after");
+}
+
+TEST_CASE("atom keys in unordered containers") {
+    SUBCASE("std::hash") {
+        std::unordered_map<small::atom, int> map;
+        map[small::atom("atom_test.k1")] = 1;
+        map[small::atom("atom_test.k2")] = 2;
+        CHECK(map.at(small::atom("atom_test.k1")) == 1);
+        CHECK(map.size() == 2);
+    }
+
+    SUBCASE("heterogeneous lookup") {
+        std::unordered_map<small::atom, int, small::transparent_string_hash, small::transparent_string_equal> map;
+        map.emplace(small::atom("atom_test.h1"), 1);
+        map.emplace(small::atom("atom_test.h2"), 2);
+        CHECK(map.find(std::string_view("atom_test.h1"))->second == 1);
+        CHECK(map.find("atom_test.h2")->second == 2);
+        CHECK(map.find(small::small_string("atom_test.h2"))->second == 2);
+        CHECK(map.find(std::string_view("atom_test.h3")) == map.end());
+        CHECK(map.find(small::atom("atom_test.h1"))->second == 1);
+    }
+
+    SUBCASE("atoms and small strings hash alike") {
+        std::unordered_set<small::small_string, small::transparent_string_hash, small::transparent_string_equal> set;
+        set.emplace("atom_test.mixed");
+        CHECK(set.contains(small::atom("atom_test.mixed")));
+    }
+}
+
+TEST_CASE("atom concurrent interning") {
+    small::atom_table table;
+    constexpr int thread_count = 8;
+    constexpr int word_count = 500;
+    std::vector<std::vector<small::atom>> results(thread_count);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < word_count; ++i) {
+                // every thread interns the same words in a different order
+                auto word = "word_" + std::to_string((i * (t + 1)) % word_count);
+                results[static_cast<size_t>(t)].emplace_back(word, table);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    CHECK(table.size() == word_count);
+    for (int t = 0; t < thread_count; ++t) {
+        for (int i = 0; i < word_count; ++i) {
+            auto word = "word_" + std::to_string((i * (t + 1)) % word_count);
+            const auto& interned = results[static_cast<size_t>(t)][static_cast<size_t>(i)];
+            CHECK(interned.view() == word);
+            CHECK(interned == small::atom::find(word, table));
+        }
+    }
+}
@@ -0,0 +1,184 @@
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+namespace {
+
+constexpr small::static_text kShortLiteral{"borrowed"};
+constexpr small::static_text kLongLiteral{
+  "a literal long enough to need a Median buffer if it were copied, but borrowed it needs no buffer at all"};
+constexpr small::static_text kByteLiteral{"bytes\0inside"};
+
+}  // namespace
+
+TEST_CASE("borrowed static storage") {
+    SUBCASE("literal is borrowed without a copy") {
+        small::borrowing_small_string str{kLongLiteral};
+        CHECK(str.is_borrowed());
+        CHECK(std::as_const(str).data() == kLongLiteral.text);
+        CHECK(str.size() == sizeof(kLongLiteral.text) - 1);
+        CHECK(str.capacity() == str.size());
+        CHECK(str == std::string_view(kLongLiteral.text));
+        CHECK(str.c_str()[str.size()] == '\0');
+    }
+
+    SUBCASE("short literals are borrowed too") {
+        small::borrowing_small_string str{kShortLiteral};
+        CHECK(str.is_borrowed());
+        CHECK(str == "borrowed");
+        CHECK(str.find("row") == 3);
+        CHECK(str.substr(3) == "rowed");
+    }
+
+    SUBCASE("copies borrow the same text") {
+        small::borrowing_small_string str{kLongLiteral};
+        auto copy = str;
+        small::borrowing_small_string assigned("something else");
+        assigned = str;
+        CHECK(copy.is_borrowed());
+        CHECK(assigned.is_borrowed());
+        CHECK(std::as_const(copy).data() == kLongLiteral.text);
+        CHECK(std::as_const(assigned).data() == kLongLiteral.text);
+        auto moved = std::move(copy);
+        CHECK(std::as_const(moved).data() == kLongLiteral.text);
+    }
+
+    SUBCASE("first mutation copies") {
+        small::borrowing_small_string appended{kShortLiteral};
+        appended += " and owned";
+        CHECK_FALSE(appended.is_borrowed());
+        CHECK(appended == "borrowed and owned");
+
+        small::borrowing_small_string written{kShortLiteral};
+        written[0] = 'B';
+        CHECK_FALSE(written.is_borrowed());
+        CHECK(written == "Borrowed");
+
+        small::borrowing_small_string erased{kLongLiteral};
+        erased.erase(0, 2);
+        CHECK(erased == std::string_view(kLongLiteral.text).substr(2));
+
+        small::borrowing_small_string cleared{kLongLiteral};
+        cleared.clear();
+        CHECK(cleared.empty());
+
+        small::borrowing_small_string reserved{kShortLiteral};
+        reserved.reserve(1000);
+        CHECK(reserved.capacity() >= 1000);
+        CHECK(reserved == "borrowed");
+
+        small::borrowing_small_string fitted{kLongLiteral};
+        fitted.shrink_to_fit();
+        CHECK(fitted.is_borrowed());
+
+        CHECK(std::string_view(kShortLiteral.text) == "borrowed");
+        CHECK(std::string_view(kLongLiteral.text).starts_with("a literal"));
+    }
+
+    SUBCASE("byte strings") {
+        small::borrowing_small_byte_string str{kByteLiteral};
+        CHECK(str.is_borrowed());
+        CHECK(str.size() == 12);
+        CHECK(str.capacity() == 12);
+        CHECK(std::string_view(str.data(), str.size()) == std::string_view("bytes\0inside", 12));
+        str.push_back('!');
+        CHECK_FALSE(str.is_borrowed());
+        CHECK(std::string_view(str.data(), str.size()) == std::string_view("bytes\0inside!", 13));
+    }
+
+    SUBCASE("owned strings are not borrowed") {
+        small::shared_small_string shared(std::string(1000, 'o'));
+        small::small_string plain(std::string(1000, 'o'));
+        CHECK_FALSE(shared.is_borrowed());
+        CHECK_FALSE(plain.is_borrowed());
+    }
+}
+
+TEST_CASE("borrowed views of caller memory") {
+    SUBCASE("any memory is wrapped without a prefix") {
+        std::string line = "GET /index.html HTTP/1.1";
+        small::borrowing_small_byte_string method(small::borrow, line.data(), 3);
+        small::borrowing_small_byte_string path(small::borrow, std::string_view(line).substr(4, 11));
+        CHECK(method.is_borrowed());
+        CHECK(path.is_borrowed());
+        CHECK(std::as_const(method).data() == line.data());
+        CHECK(std::as_const(path).data() == line.data() + 4);
+        CHECK(method.size() == 3);
+        CHECK(method.capacity() == 3);
+        CHECK(path == "/index.html");
+        CHECK(path.find('.') == 6);
+        CHECK(path.substr(1, 5) == "index");
+        CHECK(path.ends_with("html"));
+        CHECK(std::as_const(path).end() == line.data() + 15);
+    }
+
+    SUBCASE("copies are views of the same memory") {
+        std::string text(3000, 'v');
+        small::borrowing_small_string str(small::borrow, text);
+        auto copy = str;
+        small::borrowing_small_string assigned("something else");
+        assigned = str;
+        auto moved = std::move(copy);
+        CHECK(moved.is_borrowed());
+        CHECK(assigned.is_borrowed());
+        CHECK(std::as_const(moved).data() == text.data());
+        CHECK(std::as_const(assigned).data() == text.data());
+        CHECK(str.c_str() == text.c_str());
+    }
+
+    SUBCASE("first mutation copies, the memory is never written") {
+        std::string text = "view into a caller buffer, long enough for a Short buffer once copied";
+        small::borrowing_small_string appended(small::borrow, text);
+        appended += "!";
+        CHECK_FALSE(appended.is_borrowed());
+        CHECK(appended == text + "!");
+
+        small::borrowing_small_string written(small::borrow, text);
+        written[0] = 'V';
+        CHECK_FALSE(written.is_borrowed());
+        CHECK(written.front() == 'V');
+
+        // a view fitting the core moves into it
+        small::borrowing_small_byte_string word(small::borrow, text.data(), 4);
+        word.push_back('s');
+        CHECK_FALSE(word.is_borrowed());
+        CHECK(word == "views");
+
+        small::borrowing_small_string erased(small::borrow, text);
+        erased.erase(0, 5);
+        CHECK(erased == text.substr(5));
+
+        small::borrowing_small_string reserved(small::borrow, text);
+        reserved.reserve(1000);
+        CHECK(reserved.capacity() >= 1000);
+        CHECK(reserved == text);
+
+        small::borrowing_small_string fitted(small::borrow, text);
+        fitted.shrink_to_fit();
+        CHECK(fitted.is_borrowed());
+
+        CHECK(text.starts_with("view into"));
+    }
+
+    SUBCASE("empty views") {
+        small::borrowing_small_string empty(small::borrow, "", 0);
+        CHECK(empty.empty());
+        CHECK_FALSE(empty.is_borrowed());
+        small::borrowing_small_string empty_literal{small::static_text{""}};
+        CHECK(empty_literal.empty());
+        CHECK_FALSE(empty_literal.is_borrowed());
+    }
+
+    SUBCASE("owned buffers are shared") {
+        small::borrowing_small_string owned(std::string(5000, 'o'));
+        auto copy = owned;
+        CHECK_FALSE(owned.is_borrowed());
+        CHECK(std::as_const(owned).data() == std::as_const(copy).data());
+        copy.push_back('!');
+        CHECK(owned.size() == 5000);
+        CHECK(copy.size() == 5001);
+    }
+}
@@ -0,0 +1,144 @@
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+#include "unit/test_text.hpp"
+
+static auto all_bytes() -> std::string {
+    std::string bytes;
+    for (int byte = 0; byte < 256; ++byte) {
+        bytes.push_back(static_cast<char>(byte));
+    }
+    return bytes;
+}
+
+static auto same_pos(std::size_t small_pos, std::size_t std_pos) -> bool {
+    return std_pos == std::string_view::npos ? small_pos == small::small_string::npos : small_pos == std_pos;
+}
+
+TEST_CASE("char_set membership") {
+    constexpr small::char_set separators(" \t\r\n,;:");
+    static_assert(separators.contains(';'));
+    static_assert(not separators.contains('a'));
+    static_assert(separators.size() == 7);
+    static_assert(separators.has_nibble_tables());
+    static_assert(small::char_set().empty());
+
+    SUBCASE("the nibble tables agree with the bit table") {
+        std::mt19937 gen(17);
+        auto bytes = all_bytes();
+        for (std::size_t count : {1UL, 2UL, 5UL, 12UL, 40UL, 200UL}) {
+            for (int round = 0; round < 20; ++round) {
+                auto chars = make_text(gen, count, bytes);
+                small::char_set set(chars);
+                if (not set.has_nibble_tables()) {
+                    continue;
+                }
+                for (int byte = 0; byte < 256; ++byte) {
+                    auto low = set.low_nibble_table()[byte & 15];
+                    auto high = set.high_nibble_table()[byte >> 4];
+                    CHECK(((low & high) != 0) == set.contains(static_cast<char>(byte)));
+                }
+            }
+        }
+    }
+
+    SUBCASE("sets beyond 8 nibble classes keep the bit table") {
+        small::char_set alphanumerics(
+          "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz!#%&()*+-/<>?@[]^{}~");
+        CHECK(alphanumerics.contains('q'));
+        CHECK_FALSE(alphanumerics.contains(' '));
+    }
+}
+
+TEST_CASE("find_first_of family agrees with string_view") {
+    std::mt19937 gen(23);
+    const std::string alphabet = "abc ,;\t\xe9\x80";
+    for (std::size_t size : {0UL, 1UL, 7UL, 31UL, 32UL, 33UL, 100UL, 1000UL}) {
+        auto text = make_text(gen, size, alphabet);
+        small::small_string str(text);
+        std::string_view view(text);
+        for (std::string_view chars : {"", " ", " ,;", "abc", "\xe9\t", "abc ,;\t\xe9\x80", "xyz"}) {
+            small::char_set set(chars);
+            for (std::size_t pos : {0UL, 1UL, size / 2, size, size + 3}) {
+                CHECK(same_pos(str.find_first_of(chars, pos), view.find_first_of(chars, pos)));
+                CHECK(same_pos(str.find_first_not_of(chars, pos), view.find_first_not_of(chars, pos)));
+                CHECK(same_pos(str.find_first_of(set, pos), view.find_first_of(chars, pos)));
+                CHECK(same_pos(str.find_first_not_of(set, pos), view.find_first_not_of(chars, pos)));
+            }
+            for (std::size_t pos : {0UL, 1UL, size / 2, size, std::string_view::npos}) {
+                auto small_pos = pos == std::string_view::npos ? small::small_string::npos : pos;
+                CHECK(same_pos(str.find_last_of(chars, small_pos), view.find_last_of(chars, pos)));
+                CHECK(same_pos(str.find_last_not_of(chars, small_pos), view.find_last_not_of(chars, pos)));
+                CHECK(same_pos(str.find_last_of(set, small_pos), view.find_last_of(chars, pos)));
+                CHECK(same_pos(str.find_last_not_of(set, small_pos), view.find_last_not_of(chars, pos)));
+            }
+        }
+    }
+}
+
+TEST_CASE("chars given as such past the probe and the lazy nibble tables") {
+    for (std::size_t gap : {0UL, 15UL, 16UL, 17UL, 63UL, 80UL, 81UL, 500UL}) {
+        std::string text = "," + std::string(gap, 'w') + ";" + std::string(gap, 'w') + ",";
+        small::small_string str(text);
+        CHECK(str.find_first_of(";", 1) == text.find_first_of(";", 1));
+        CHECK(str.find_first_not_of("w,", 0) == text.find_first_not_of("w,", 0));
+        CHECK(str.find_last_of(";") == text.find_last_of(";"));
+        CHECK(str.find_last_not_of("w,") == text.find_last_not_of("w,"));
+        CHECK(str.find_first_of("#") == small::small_string::npos);
+        CHECK(str.find_last_of("#") == small::small_string::npos);
+        CHECK(str.find_first_not_of("", 1) == 1);
+        CHECK(str.find_last_not_of(nullptr, small::small_string::npos, 0) == text.size() - 1);
+    }
+}
+
+#ifdef SMALL_STRING_X86_SIMD
+TEST_CASE("the AVX2 classifier matches the table") {
+    if (not small::search::has_avx2()) {
+        return;
+    }
+    std::mt19937 gen(29);
+    auto bytes = all_bytes();
+    for (std::size_t size : {32UL, 64UL, 95UL, 500UL}) {
+        auto text = make_text(gen, size, bytes);
+        for (std::size_t count : {1UL, 3UL, 10UL}) {
+            small::char_set set(make_text(gen, count, bytes));
+            if (not set.has_nibble_tables()) {
+                continue;
+            }
+            for (bool member : {true, false}) {
+                CHECK(small::search::find_first_of_avx2(text.data(), text.size(), set, member) ==
+                      small::search::find_first_of_scalar(text.data(), text.size(), set, member));
+                CHECK(small::search::find_last_of_avx2(text.data(), text.size(), set, member) ==
+                      small::search::find_last_of_scalar(text.data(), text.size(), set, member));
+            }
+        }
+    }
+}
+#endif
+
+TEST_CASE("tokenizing with a char_set") {
+    const small::char_set separators(" \t,;");
+    small::small_string line("alpha, beta;gamma\tdelta   epsilon");
+    std::vector<std::string> tokens;
+    std::size_t begin = line.find_first_not_of(separators);
+    while (begin != small::small_string::npos) {
+        auto end = line.find_first_of(separators, begin);
+        auto length = (end == small::small_string::npos ? line.size() : end) - begin;
+        tokens.emplace_back(line.data() + begin, length);
+        begin = line.find_first_not_of(separators, begin + length);
+    }
+    CHECK(tokens == std::vector<std::string>{"alpha", "beta", "gamma", "delta", "epsilon"});
+}
+
+TEST_CASE("wide strings keep the per char find_first_of") {
+    std::u16string text(100, u'a');
+    text += u"b, c";
+    small::u16string str(text.data(), text.size());
+    CHECK(str.find_first_of(u", ") == text.find_first_of(u", "));
+    CHECK(str.find_last_not_of(u"c") == text.find_last_not_of(u"c"));
+}
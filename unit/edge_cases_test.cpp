@@ -284,7 +284,8 @@ TEST_CASE("smallstring capacity and memory management") {
         // Verify growth is reasonable (capacity should grow exponentially or linearly)
         for (size_t i = 1; i < capacities.size(); ++i) {
             CHECK(capacities[i] > capacities[i - 1]);       // Should always increase
-            CHECK(capacities[i] <= capacities[i - 1] * 3);  // Growth shouldn't be too aggressive
+            // Growth shouldn't be too aggressive, the first heap buffer is at most the smallest malloc block
+            CHECK(capacities[i] <= std::max<size_t>(capacities[i - 1] * 3, 31));
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <bit>
+#include <string>
+#include <string_view>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+namespace {
+
+template <typename String>
+auto append_until(String& str, std::string& expected, size_t final_size) -> void {
+    size_t i = 0;
+    while (str.size() < final_size) {
+        std::string chunk(64, static_cast<char>('a' + i++ % 26));
+        str.append(chunk.data(), static_cast<typename String::size_type>(chunk.size()));
+        expected.append(chunk);
+    }
+}
+
+template <typename Growth>
+using growth_string = small::basic_small_string<char, small::small_string_buffer, small::malloc_core,
+                                                std::char_traits<char>, std::allocator<char>, true, Growth>;
+
+// a user policy, grows to exactly what is needed
+struct exact_growth
+{
+    static auto grow(const small::growth_request& request) noexcept -> small::buffer_type_and_size<uint32_t> {
+        return request.minimum;
+    }
+};
+
+// a broken policy, asks for less than needed
+struct shrinking_growth
+{
+    static auto grow(const small::growth_request& request) noexcept -> small::buffer_type_and_size<uint32_t> {
+        return request.fit_buffer(8);
+    }
+};
+
+// growth request of a null terminated malloc_core string, with the tier layout spelled out
+auto make_request(size_t new_size) -> small::growth_request {
+    auto fit_size = +[](size_t size) noexcept -> small::buffer_type_and_size<uint32_t> {
+        if (size <= 255) {
+            return {.buffer_size = static_cast<uint32_t>((size + 1 + 7) / 8 * 8), .core_type = small::CoreType::Short};
+        }
+        return {.buffer_size = static_cast<uint32_t>((size + 9 + 7) / 8 * 8),
+                .core_type = size <= 16383 ? small::CoreType::Median : small::CoreType::Long};
+    };
+    auto fit_buffer = +[](size_t buffer_size) noexcept -> small::buffer_type_and_size<uint32_t> {
+        buffer_size = buffer_size / 8 * 8;
+        if (buffer_size <= 256) {
+            return {.buffer_size = static_cast<uint32_t>(buffer_size), .core_type = small::CoreType::Short};
+        }
+        return {.buffer_size = static_cast<uint32_t>(buffer_size),
+                .core_type = buffer_size - 9 <= 16383 ? small::CoreType::Median : small::CoreType::Long};
+    };
+    return {.old_size = new_size - 1,
+            .old_tier = small::CoreType::Median,
+            .new_size = new_size,
+            .minimum = fit_size(new_size),
+            .fit_size = fit_size,
+            .fit_buffer = fit_buffer};
+}
+
+// usable bytes of the malloc'ed block behind a string, at least what the text needs, rounded down to 8
+template <typename String>
+auto usable_bytes(const String& str, bool has_header) -> size_t {
+    auto header = has_header ? sizeof(small::capacity_and_size<uint32_t>) : 0;
+    const char* block = str.data() - header;
+    return small::process_memory::usable_size(const_cast<char*>(block), header + str.size() + 1) / 8 * 8;
+}
+
+}  // namespace
+
+TEST_CASE("Median and Long buffers grow with realloc") {
+    SUBCASE("Median to Median") {
+        small::small_string str(std::string(300, 'm'));
+        std::string expected(300, 'm');
+        append_until(str, expected, 4096);
+        CHECK(std::string_view(str) == expected);
+        CHECK(str.c_str()[str.size()] == '\0');
+    }
+
+    SUBCASE("Median to Long") {
+        small::small_string str(std::string(10000, 'm'));
+        std::string expected(10000, 'm');
+        append_until(str, expected, 64 * 1024);
+        CHECK(std::string_view(str) == expected);
+        CHECK(str.c_str()[str.size()] == '\0');
+    }
+
+    SUBCASE("Long to Long") {
+        small::small_string str(std::string(20000, 'l'));
+        std::string expected(20000, 'l');
+        append_until(str, expected, 1024 * 1024);
+        CHECK(std::string_view(str) == expected);
+        CHECK(str.c_str()[str.size()] == '\0');
+    }
+
+    SUBCASE("reserve keeps the content") {
+        small::small_string str(std::string(1000, 'r'));
+        str.reserve(5000);
+        CHECK(str.capacity() >= 5000);
+        CHECK(str == std::string(1000, 'r'));
+        str.reserve(100000);
+        CHECK(str.capacity() >= 100000);
+        CHECK(str == std::string(1000, 'r'));
+        CHECK(str.c_str()[1000] == '\0');
+        str.append(std::string(99000, 's'));
+        CHECK(str.size() == 100000);
+        CHECK(str[999] == 'r');
+        CHECK(str[1000] == 's');
+    }
+
+    SUBCASE("byte string") {
+        small::small_byte_string str(std::string(500, 'b'));
+        std::string expected(500, 'b');
+        append_until(str, expected, 40000);
+        CHECK(std::string_view(str.data(), str.size()) == expected);
+    }
+
+    SUBCASE("pooled and wide cores") {
+        small::pooled_small_string pooled(std::string(400, 'p'));
+        small::wide_small_string wide(std::string(400, 'w'));
+        std::string pooled_expected(400, 'p');
+        std::string wide_expected(400, 'w');
+        append_until(pooled, pooled_expected, 30000);
+        append_until(wide, wide_expected, 30000);
+        CHECK(std::string_view(pooled) == pooled_expected);
+        CHECK(std::string_view(wide) == wide_expected);
+    }
+}
+
+TEST_CASE("growth policies") {
+    SUBCASE("default is 1.5x geometric") {
+        CHECK(std::is_same_v<small::default_growth, small::geometric_growth<1.5F>>);
+        small::small_string str(std::string(1000, 'd'));
+        str.resize(str.capacity(), 'd');
+        auto new_size = str.size() + 1;
+        str.push_back('d');
+        CHECK(str.capacity() >= new_size * 3 / 2);
+        CHECK(str.capacity() < new_size * 3 / 2 + 8 + 16);
+    }
+
+    SUBCASE("power of two") {
+        auto request = make_request(20000);
+        auto grown = small::power_of_two_growth::grow(request);
+        CHECK(grown.buffer_size == 32768);
+        CHECK(grown.core_type == small::CoreType::Long);
+        CHECK(small::power_of_two_growth::grow(make_request(200)).buffer_size == 256);
+        CHECK(small::power_of_two_growth::grow(make_request(1000)).buffer_size == 1024);
+
+        growth_string<small::power_of_two_growth> str;
+        std::string expected;
+        size_t reallocations = 0;
+        for (int i = 0; i < 100000; ++i) {
+            auto ch = static_cast<char>('a' + i % 26);
+            auto capacity = str.capacity();
+            str.push_back(ch);
+            expected.push_back(ch);
+            reallocations += capacity != str.capacity() ? 1U : 0U;
+        }
+        CHECK(std::string_view(str) == expected);
+        CHECK(reallocations <= 17);
+    }
+
+    SUBCASE("jemalloc size classes") {
+        using policy = small::jemalloc_class_growth<>;
+        CHECK(policy::size_class(1) == 8);
+        CHECK(policy::size_class(17) == 32);
+        CHECK(policy::size_class(128) == 128);
+        CHECK(policy::size_class(129) == 160);
+        CHECK(policy::size_class(256) == 256);
+        CHECK(policy::size_class(257) == 320);
+        CHECK(policy::size_class(4097) == 5120);
+        CHECK(policy::size_class(1UL << 20UL) == 1UL << 20UL);
+
+        for (size_t size : {100UL, 300UL, 5000UL, 100000UL}) {
+            auto grown = policy::grow(make_request(size));
+            CHECK(policy::size_class(grown.buffer_size) == grown.buffer_size);
+            CHECK(grown.buffer_size >= small::geometric_growth<>::grow(make_request(size)).buffer_size);
+        }
+
+        growth_string<policy> str;
+        std::string expected;
+        append_until(str, expected, 50000);
+        CHECK(std::string_view(str) == expected);
+    }
+
+    SUBCASE("capped geometric") {
+        growth_string<small::capped_geometric_growth<2.0F, 4096>> str;
+        std::string expected;
+        append_until(str, expected, 200000);
+        CHECK(std::string_view(str) == expected);
+        CHECK(str.capacity() - str.size() <= 4096 + 64 + 8);
+    }
+
+    SUBCASE("user policy") {
+        growth_string<exact_growth> str;
+        std::string expected;
+        append_until(str, expected, 20000);
+        CHECK(std::string_view(str) == expected);
+        // what is left is the alignment to 8 and the slack of the malloc chunk
+        CHECK(str.capacity() - str.size() < 8 + 16);
+    }
+
+    SUBCASE("too small results fall back to the minimum") {
+        growth_string<shrinking_growth> str;
+        std::string expected;
+        append_until(str, expected, 30000);
+        CHECK(std::string_view(str) == expected);
+        CHECK(str.c_str()[str.size()] == '\0');
+    }
+}
+
+TEST_CASE("malloc slack becomes capacity") {
+    SUBCASE("Short uses the largest cap that fits the block") {
+        for (size_t len = 7; len <= 255; len += 8) {
+            small::small_string str(std::string(len, 's'));
+            CHECK(str.capacity() == std::min<size_t>(usable_bytes(str, false), 256) - 1);
+            str.append(str.capacity() - str.size(), 't');
+            CHECK(str.c_str()[str.size()] == '\0');
+        }
+    }
+
+    SUBCASE("Median and Long store the usable size in the header") {
+        for (size_t len : {300UL, 1000UL, 16000UL, 20000UL, 300000UL}) {
+            small::small_string str(std::string(len, 'm'));
+            auto expected = std::min<size_t>(usable_bytes(str, true), len <= 16383 ? 16392 : UINT32_MAX) - 9;
+            CHECK(str.capacity() == expected);
+            str.append(str.capacity() - str.size(), 'n');
+            CHECK(str.size() == expected);
+            CHECK(str.c_str()[str.size()] == '\0');
+        }
+    }
+
+    SUBCASE("realloc growth harvests too") {
+        small::small_string str(std::string(400, 'r'));
+        std::string expected(400, 'r');
+        append_until(str, expected, 100000);
+        CHECK(str.capacity() == usable_bytes(str, true) - 9);
+        CHECK(std::string_view(str) == expected);
+    }
+
+    SUBCASE("byte string") {
+        small::small_byte_string str(std::string(100, 'b'));
+        CHECK(str.capacity() == std::min<size_t>(usable_bytes(str, false), 256));
+    }
+
+    SUBCASE("pooled Short buffers have no slack") {
+        small::pooled_small_string str(std::string(20, 'p'));
+        CHECK(str.capacity() == 23);
+    }
+}
+
+TEST_CASE("hysteresis shrink") {
+    using shrinking_string = growth_string<small::hysteresis_shrink<>>;
+
+    SUBCASE("without a shrink policy the capacity stays") {
+        small::small_string str(std::string(10000, 'k'));
+        auto capacity = str.capacity();
+        str.resize(10);
+        str.erase(0, 5);
+        str.clear();
+        CHECK(str.capacity() == capacity);
+    }
+
+    SUBCASE("resize moves down the tiers") {
+        shrinking_string str(std::string(100000, 'l'));
+        CHECK(str.get_core_type() == static_cast<uint8_t>(small::CoreType::Long));
+        str.resize(5000);
+        CHECK(str.get_core_type() == static_cast<uint8_t>(small::CoreType::Median));
+        CHECK(str.capacity() >= 10000);
+        CHECK(str.capacity() < 20000);
+        str.resize(100);
+        CHECK(str.get_core_type() == static_cast<uint8_t>(small::CoreType::Short));
+        CHECK(str == std::string(100, 'l'));
+        CHECK(str.c_str()[100] == '\0');
+        str.resize(3);
+        CHECK(str.get_core_type() == static_cast<uint8_t>(small::CoreType::Internal));
+        CHECK(str == "lll");
+    }
+
+    SUBCASE("erase and clear") {
+        shrinking_string str(std::string(3000, 'e'));
+        str.erase(10, 2980);
+        CHECK(str.capacity() < 3000 / 4);
+        CHECK(str == std::string(20, 'e'));
+        str.append(std::string(2000, 'f'));
+        str.erase(str.begin(), str.end() - 1);
+        CHECK(str == "f");
+        str.append(std::string(2000, 'g'));
+        str.clear();
+        CHECK(str.get_core_type() == static_cast<uint8_t>(small::CoreType::Internal));
+        CHECK(str.empty());
+    }
+
+    SUBCASE("small Short buffers are kept") {
+        shrinking_string str(std::string(40, 's'));
+        auto capacity = str.capacity();
+        str.clear();
+        CHECK(str.capacity() == capacity);
+    }
+
+    SUBCASE("a size around the threshold does not oscillate") {
+        shrinking_string str(std::string(8000, 'o'));
+        str.resize(str.capacity() / 4 - 10);
+        auto capacity = str.capacity();
+        size_t reallocations = 0;
+        for (int i = 0; i < 1000; ++i) {
+            auto size = static_cast<size_t>(static_cast<double>(capacity) * (i % 2 == 0 ? 0.3 : 0.9));
+            str.resize(size, 'o');
+            reallocations += str.capacity() != capacity ? 1U : 0U;
+            capacity = str.capacity();
+        }
+        CHECK(reallocations == 0);
+    }
+}
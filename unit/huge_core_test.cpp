@@ -0,0 +1,72 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+TEST_CASE("huge_core layout") {
+    CHECK(sizeof(small::huge_small_string) == 8);
+    CHECK(std::is_same_v<small::huge_small_string::size_type, std::uint64_t>);
+    CHECK(std::is_same_v<small::small_string::size_type, std::uint32_t>);
+    CHECK(small::huge_small_string::npos == std::string::npos);
+    CHECK(small::huge_small_string().max_size() > std::numeric_limits<std::uint32_t>::max());
+    CHECK(small::huge_small_string().capacity() == small::small_string().capacity());
+}
+
+TEST_CASE("huge_core strings below 4 GiB behave like small_string") {
+    for (std::size_t length : {0UL, 6UL, 7UL, 100UL, 255UL, 256UL, 300UL, 16383UL, 16384UL, 100000UL}) {
+        std::string expected(length, 'h');
+        small::huge_small_string huge(expected);
+        small::small_string plain(expected);
+        CHECK(std::string_view(huge) == expected);
+        CHECK(huge.c_str()[length] == '\0');
+        huge.append("tail");
+        plain.append("tail");
+        CHECK(std::string_view(huge) == std::string_view(plain));
+        huge.erase(0, length / 2);
+        plain.erase(0, length / 2);
+        CHECK(std::string_view(huge) == std::string_view(plain));
+        huge.shrink_to_fit();
+        CHECK(std::string_view(huge) == std::string_view(plain));
+    }
+
+    SUBCASE("growth across the tiers") {
+        small::huge_small_byte_string bytes;
+        std::string expected;
+        for (int i = 0; i < 20000; ++i) {
+            bytes.push_back(static_cast<char>(i % 251));
+            expected.push_back(static_cast<char>(i % 251));
+        }
+        CHECK(std::string_view(bytes.data(), bytes.size()) == expected);
+        auto copy = bytes;
+        CHECK(copy == bytes);
+    }
+
+    SUBCASE("shrinking growth policies serve 64-bit sizes") {
+        using trimmed = small::basic_small_string<char, small::small_string_buffer, small::huge_core,
+                                                  std::char_traits<char>, std::allocator<char>, true,
+                                                  small::hysteresis_shrink<small::power_of_two_growth>>;
+        trimmed str(std::string(50000, 't'));
+        str.erase(100);
+        CHECK(str.size() == 100);
+        CHECK(str.capacity() < 1000);
+    }
+}
+
+TEST_CASE("huge_core strings beyond 4 GiB") {
+    // the pages of the reserved block are only touched where the test writes
+    constexpr std::size_t kSize = (std::size_t{1} << 32U) + 4096;
+    auto str = small::huge_small_byte_string::create_uninitialized_string(kSize);
+    REQUIRE(str.size() == kSize);
+    CHECK(str.capacity() >= kSize);
+    str[0] = 'a';
+    str[kSize - 1] = 'z';
+    str[std::size_t{1} << 32U] = 'x';
+    CHECK(str.front() == 'a');
+    CHECK(str.back() == 'z');
+    CHECK(str.at(std::size_t{1} << 32U) == 'x');
+    str.resize(kSize - 2);
+    CHECK(str.size() == kSize - 2);
+}
@@ -0,0 +1,129 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+namespace {
+
+// map everything from 64KB on so the tests stay small
+using test_mapped_string =
+  small::basic_small_string<char, small::small_string_buffer, small::malloc_core, std::char_traits<char>,
+                            std::allocator<char>, true, small::default_growth, small::mmap_long_tier<64UL * 1024UL>>;
+using test_mapped_byte_string =
+  small::basic_small_string<char, small::small_string_buffer, small::malloc_core, std::char_traits<char>,
+                            std::allocator<char>, false, small::default_growth,
+                            small::mmap_long_tier<64UL * 1024UL, false>>;
+
+// a mapping starts on a page boundary, the buffer header sits right before the data
+template <typename String>
+auto is_page_aligned_buffer(const String& str) -> bool {
+    auto page_size = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+    auto header = reinterpret_cast<std::uintptr_t>(str.data()) - sizeof(small::capacity_and_size<uint32_t>);
+    return header % page_size == 0;
+}
+
+template <typename String>
+auto append_until(String& str, std::string& expected, size_t final_size) -> void {
+    size_t i = 0;
+    while (str.size() < final_size) {
+        std::string chunk(1000, static_cast<char>('a' + i++ % 26));
+        str.append(chunk.data(), static_cast<typename String::size_type>(chunk.size()));
+        expected.append(chunk);
+    }
+}
+
+}  // namespace
+
+TEST_CASE("mmap_long_tier maps large Long buffers") {
+    SUBCASE("object size") { CHECK(sizeof(small::mapped_small_string) == 8); }
+
+    SUBCASE("below the threshold stays on the heap") {
+        test_mapped_string str(std::string(30000, 'h'));
+        CHECK(str.size() == 30000);
+        CHECK(str == std::string(30000, 'h'));
+    }
+
+    SUBCASE("harvested malloc slack stays below the threshold") {
+        test_mapped_string str(std::string(64UL * 1024UL - 20, 'h'));
+        CHECK(str.capacity() + 9 < 64UL * 1024UL);
+        str.append(str.capacity() - str.size(), 'h');
+        str.push_back('x');
+        CHECK(is_page_aligned_buffer(str));
+        CHECK(str.back() == 'x');
+    }
+
+    SUBCASE("above the threshold is mapped") {
+        test_mapped_string str(std::string(200000, 'm'));
+        CHECK(is_page_aligned_buffer(str));
+        CHECK(str == std::string(200000, 'm'));
+        CHECK(str.c_str()[200000] == '\0');
+    }
+
+    SUBCASE("growth crosses the threshold and keeps growing mapped") {
+        test_mapped_string str;
+        std::string expected;
+        append_until(str, expected, 40000);
+        append_until(str, expected, 4UL * 1024UL * 1024UL);
+        CHECK(is_page_aligned_buffer(str));
+        CHECK(std::string_view(str) == expected);
+        CHECK(str.c_str()[str.size()] == '\0');
+    }
+
+    SUBCASE("reserve maps and keeps the content") {
+        test_mapped_string str(std::string(1000, 'r'));
+        str.reserve(100000);
+        CHECK(is_page_aligned_buffer(str));
+        CHECK(str.capacity() >= 100000);
+        CHECK(str == std::string(1000, 'r'));
+        str.reserve(1000000);
+        CHECK(str.capacity() >= 1000000);
+        CHECK(str == std::string(1000, 'r'));
+    }
+
+    SUBCASE("shrink back to the heap") {
+        test_mapped_string str(std::string(300000, 's'));
+        str.resize(100);
+        str.shrink_to_fit();
+        CHECK(str == std::string(100, 's'));
+        str.resize(20);
+        str.shrink_to_fit();
+        CHECK(str == std::string(20, 's'));
+    }
+
+    SUBCASE("copy, move and swap") {
+        test_mapped_string big(std::string(150000, 'b'));
+        test_mapped_string small_str("small");
+        auto copy = big;
+        CHECK(is_page_aligned_buffer(copy));
+        CHECK(copy == big);
+        test_mapped_string moved(std::move(copy));
+        CHECK(moved == big);
+        moved.swap(small_str);
+        CHECK(moved == "small");
+        CHECK(small_str == big);
+    }
+
+    SUBCASE("byte string without huge pages") {
+        test_mapped_byte_string str;
+        std::string expected;
+        append_until(str, expected, 500000);
+        CHECK(is_page_aligned_buffer(str));
+        CHECK(std::string_view(str.data(), str.size()) == expected);
+    }
+
+    SUBCASE("many mapped strings") {
+        std::vector<test_mapped_string> strings;
+        for (int i = 0; i < 16; ++i) {
+            strings.emplace_back(std::string(static_cast<size_t>(70000 + i * 10000), static_cast<char>('a' + i)));
+        }
+        for (int i = 0; i < 16; ++i) {
+            CHECK(strings[static_cast<size_t>(i)].size() == static_cast<size_t>(70000 + i * 10000));
+            CHECK(strings[static_cast<size_t>(i)].back() == static_cast<char>('a' + i));
+        }
+    }
+}
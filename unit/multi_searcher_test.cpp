@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+#include "unit/test_text.hpp"
+
+using match = small::multi_searcher::match;
+
+// every occurrence of every pattern, in the order the automaton reports them: by end, then longest first
+static auto brute_force(const std::vector<std::string>& patterns, std::string_view text) -> std::vector<match> {
+    std::vector<match> matches;
+    for (std::size_t end = 1; end <= text.size(); ++end) {
+        std::vector<match> ending;
+        for (std::size_t index = 0; index < patterns.size(); ++index) {
+            const auto& pattern = patterns[index];
+            if (not pattern.empty() and pattern.size() <= end and
+                text.substr(end - pattern.size(), pattern.size()) == pattern) {
+                ending.push_back({index, end - pattern.size(), pattern.size()});
+            }
+        }
+        std::stable_sort(ending.begin(), ending.end(),
+                         [](const match& a, const match& b) { return a.length > b.length; });
+        matches.insert(matches.end(), ending.begin(), ending.end());
+    }
+    return matches;
+}
+
+static auto same(const std::vector<match>& found, const std::vector<match>& expected) -> bool {
+    if (found.size() != expected.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < found.size(); ++i) {
+        // patterns of one length ending at one byte are equal, any of their indexes will do
+        if (std::tie(found[i].offset, found[i].length) != std::tie(expected[i].offset, expected[i].length)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("multi_searcher on the textbook patterns") {
+    const small::multi_searcher searcher({"he", "she", "his", "hers"});
+    auto matches = searcher.find_all("ushers");
+    REQUIRE(matches.size() == 3);
+    CHECK(matches[0].pattern == 1);
+    CHECK(matches[0].offset == 1);
+    CHECK(matches[1].pattern == 0);
+    CHECK(matches[1].offset == 2);
+    CHECK(matches[2].pattern == 3);
+    CHECK(matches[2].offset == 2);
+    CHECK(searcher.find_first("ushers").pattern == 1);
+    CHECK(searcher.find_first("nothing here").pattern == 0);
+    CHECK(searcher.find_first("no match").offset == small::search::kNotFound);
+    CHECK(searcher.size() == 4);
+}
+
+TEST_CASE("multi_searcher agrees with a brute force search") {
+    std::mt19937 gen(41);
+    for (std::string_view alphabet : {"ab", "abcde", "abcdefghijklmnopqrstuvwxyz \xff"}) {
+        for (std::size_t pattern_count : {1UL, 3UL, 20UL, 200UL}) {
+            std::vector<std::string> patterns;
+            for (std::size_t i = 0; i < pattern_count; ++i) {
+                patterns.push_back(make_text(gen, 1 + gen() % 8, alphabet));
+            }
+            patterns.emplace_back();
+            patterns.push_back(patterns.front());
+            small::multi_searcher searcher(patterns.begin(), patterns.end());
+            for (std::size_t size : {0UL, 1UL, 10UL, 300UL, 3000UL}) {
+                auto text = make_text(gen, size, alphabet);
+                auto expected = brute_force(patterns, text);
+                CHECK(same(searcher.find_all(text), expected));
+                auto first = searcher.find_first(text);
+                if (expected.empty()) {
+                    CHECK(first.offset == small::search::kNotFound);
+                } else {
+                    CHECK(first.offset == expected.front().offset);
+                    CHECK(first.length == expected.front().length);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("multi_searcher skips to the rare bytes") {
+    // long stretches of common text between the matches, the patterns have rare bytes far from their start
+    std::vector<std::string> patterns = {"zebra", "the quick fox", "quiz", "0x7f", "jukebox", "aaaaaaaaaaq"};
+    small::multi_searcher searcher(patterns.begin(), patterns.end());
+    CHECK(searcher.has_prefilter());
+    std::mt19937 gen(43);
+    for (std::size_t size : {5UL, 100UL, 5000UL, 100000UL}) {
+        auto text = make_text(gen, size, "etaoin shrdlu");
+        for (const auto& pattern : patterns) {
+            text.insert(gen() % text.size(), pattern);
+        }
+        text += "the quick fox";
+        CHECK(same(searcher.find_all(text), brute_force(patterns, text)));
+    }
+
+    SUBCASE("and stops when they are everywhere") {
+        auto text = make_text(gen, 20000, "zqxj ");
+        CHECK(same(searcher.find_all(text), brute_force(patterns, text)));
+    }
+
+    SUBCASE("common bytes only disable it") {
+        std::vector<std::string> common = {"the", "and", "ion", "tea", "seat", "hits", "rode", "lion", "dust",
+                                           "cold", "mule", "wolf", "fog", "yap", "pub", "vat", "keg", "jig"};
+        CHECK_FALSE(small::multi_searcher(common.begin(), common.end()).has_prefilter());
+    }
+}
+
+TEST_CASE("multi_searcher over every byte") {
+    std::vector<std::string> patterns;
+    for (int byte = 0; byte < 256; ++byte) {
+        patterns.emplace_back(2, static_cast<char>(byte));
+    }
+    small::multi_searcher searcher(patterns.begin(), patterns.end());
+    std::string text;
+    for (int byte = 0; byte < 256; ++byte) {
+        text += static_cast<char>(byte);
+        text += static_cast<char>(255 - byte);
+    }
+    text += "\x80\x80";
+    CHECK(same(searcher.find_all(text), brute_force(patterns, text)));
+}
+
+TEST_CASE("find with a multi_searcher") {
+    const small::multi_searcher deny({"password", "secret", "token"});
+    std::string text = std::string(2000, '.') + "user=a;secret=b;token=c";
+    small::small_string str(text);
+    CHECK(str.find(deny) == text.find("secret"));
+    CHECK(str.find(deny, text.find("secret") + 1) == text.find("token"));
+    CHECK(str.find(deny, text.size()) == small::small_string::npos);
+    CHECK(str.find(deny, text.size() + 1) == small::small_string::npos);
+    CHECK(small::small_string("all clear").find(deny) == small::small_string::npos);
+
+    std::size_t count = 0;
+    deny.for_each_match(str, [&count](const match&) {
+        ++count;
+        return true;
+    });
+    CHECK(count == 2);
+}
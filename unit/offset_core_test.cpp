@@ -0,0 +1,203 @@
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+namespace {
+
+constexpr std::size_t kRegionSize = 4UL * 1024UL * 1024UL;
+constexpr std::size_t kTableSize = 64;
+
+// one string of every tier, Internal ones never touch the segment
+auto tiered_text(std::size_t i) -> std::string {
+    static constexpr std::size_t lengths[] = {3, 40, 1000, 20000};
+    return std::string(lengths[i % 4], static_cast<char>('a' + i % 26)) + std::to_string(i);
+}
+
+struct string_table
+{
+    std::size_t count;
+    small::offset_small_string strings[kTableSize];
+};
+
+// what a consumer process does with the region, nonzero on the first mismatch
+auto check_table(const small::shared_segment& segment) -> int {
+    const auto* table = static_cast<const string_table*>(segment.root());
+    if (table == nullptr or table->count != kTableSize) {
+        return 1;
+    }
+    for (std::size_t i = 0; i < kTableSize; ++i) {
+        const auto& str = table->strings[i];
+        if (std::string_view(str) != tiered_text(i) or str.c_str()[str.size()] != '\0') {
+            return 2;
+        }
+        if (str.size() > 6 and not segment.contains(str.data())) {
+            return 3;
+        }
+    }
+    return 0;
+}
+
+// a memfd region mapped read-write, unmapped and closed at the end of the test
+struct shared_region
+{
+    int fd = ::memfd_create("offset_core_test", 0);
+    void* address = nullptr;
+
+    shared_region() {
+        if (fd >= 0 and ::ftruncate(fd, static_cast<off_t>(kRegionSize)) == 0) {
+            address = ::mmap(nullptr, kRegionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+    }
+
+    ~shared_region() {
+        if (address != nullptr and address != MAP_FAILED) {
+            ::munmap(address, kRegionSize);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    shared_region(const shared_region&) = delete;
+    auto operator=(const shared_region&) -> shared_region& = delete;
+};
+
+}  // namespace
+
+TEST_CASE("offset_core layout") {
+    CHECK(sizeof(small::offset_small_string) == 8);
+    CHECK(small::is_trivially_relocatable_v<small::offset_small_string>);
+    CHECK(small::shared_segment::current() == nullptr);
+}
+
+TEST_CASE("offset_core strings in one process") {
+    shared_region region;
+    REQUIRE(region.address != MAP_FAILED);
+    auto* segment = small::shared_segment::create(region.address, kRegionSize, 3);
+    REQUIRE(segment != nullptr);
+    CHECK(small::shared_segment::create(region.address, kRegionSize, 3) == nullptr);
+    CHECK(small::shared_segment::from_id(3) == segment);
+    CHECK(small::shared_segment::attach(region.address) == segment);
+    {
+        small::shared_segment::scope scope(segment);
+        CHECK(small::shared_segment::current() == segment);
+
+        SUBCASE("grow across the tiers") {
+            small::offset_small_string str;
+            std::string expected;
+            for (int i = 0; i < 20000; ++i) {
+                str.push_back(static_cast<char>('a' + i % 26));
+                expected.push_back(static_cast<char>('a' + i % 26));
+                if (i > 6) {
+                    REQUIRE(segment->contains(str.data()));
+                }
+            }
+            CHECK(std::string_view(str) == expected);
+            str.erase(10, 15000);
+            expected.erase(10, 15000);
+            CHECK(std::string_view(str) == expected);
+            str.shrink_to_fit();
+            CHECK(std::string_view(str) == expected);
+            CHECK(segment->contains(str.data()));
+        }
+
+        SUBCASE("copies and freed blocks stay in the segment") {
+            small::offset_small_string original(std::string(300, 'o'));
+            auto copy = original;
+            CHECK(copy == original);
+            CHECK(copy.data() != original.data());
+            const void* first = nullptr;
+            std::size_t used = 0;
+            for (int i = 0; i < 100; ++i) {
+                small::offset_small_string temporary(std::string(300, 't'));
+                if (i == 0) {
+                    first = temporary.data();
+                    used = segment->used_size();
+                }
+                CHECK(temporary.data() == first);
+            }
+            CHECK(segment->used_size() == used);
+        }
+    }
+    CHECK(small::shared_segment::current() == nullptr);
+    small::shared_segment::detach(3);
+    CHECK(small::shared_segment::from_id(3) == nullptr);
+}
+
+TEST_CASE("offset_core strings in a full segment") {
+    constexpr std::size_t kSmallRegion = 64UL * 1024UL;
+    shared_region region;
+    REQUIRE(region.address != MAP_FAILED);
+    auto* segment = small::shared_segment::create(region.address, kSmallRegion, 4);
+    REQUIRE(segment != nullptr);
+    {
+        small::shared_segment::scope scope(segment);
+        small::offset_small_string str;
+        std::size_t pushed = 0;
+        CHECK_THROWS_AS(
+          [&]() {
+              for (; pushed < 200000; ++pushed) {
+                  str.push_back('f');
+              }
+          }(),
+          std::bad_alloc);
+        // the failed growth leaves the string as it was
+        CHECK(pushed < kSmallRegion);
+        CHECK(str.size() == pushed);
+        CHECK(std::string_view(str) == std::string(pushed, 'f'));
+        CHECK_THROWS_AS(small::offset_small_string(std::string(kSmallRegion, 'x')), std::bad_alloc);
+        str.clear();
+        str.shrink_to_fit();
+        small::offset_small_string after(std::string(1000, 'a'));
+        CHECK(segment->contains(after.data()));
+    }
+    small::shared_segment::detach(4);
+}
+
+TEST_CASE("offset_core table read by another process") {
+    shared_region region;
+    REQUIRE(region.address != MAP_FAILED);
+    auto* segment = small::shared_segment::create(region.address, kRegionSize, 5);
+    REQUIRE(segment != nullptr);
+    {
+        small::shared_segment::scope scope(segment);
+        auto* table = ::new (segment->allocate(sizeof(string_table))) string_table{.count = kTableSize, .strings = {}};
+        for (std::size_t i = 0; i < kTableSize; ++i) {
+            table->strings[i] = tiered_text(i);
+        }
+        segment->set_root(table);
+    }
+    REQUIRE(check_table(*segment) == 0);
+
+    auto child = ::fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        // the consumer drops the producer's mapping and maps the region read-only at another address
+        small::shared_segment::detach(5);
+        auto* view = ::mmap(nullptr, kRegionSize, PROT_READ, MAP_SHARED, region.fd, 0);
+        ::munmap(region.address, kRegionSize);
+        if (view == MAP_FAILED or view == region.address) {
+            ::_exit(10);
+        }
+        auto* attached = small::shared_segment::attach(view);
+        ::_exit(attached == nullptr ? 11 : check_table(*attached));
+    }
+    int status = 0;
+    REQUIRE(::waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    CHECK(WEXITSTATUS(status) == 0);
+
+    auto* table = const_cast<string_table*>(static_cast<const string_table*>(segment->root()));
+    std::destroy_n(table->strings, kTableSize);
+    segment->deallocate(table);
+    small::shared_segment::detach(5);
+}
@@ -0,0 +1,194 @@
+#include <cstddef>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+namespace {
+
+// remembers the size of every allocation and counts the deallocations whose size doesn't match
+class size_checking_resource : public std::pmr::memory_resource
+{
+   public:
+    std::map<void*, std::size_t> live;
+    std::size_t mismatches = 0;
+    std::size_t deallocations = 0;
+
+   private:
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+        auto* ptr = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        live[ptr] = bytes;
+        return ptr;
+    }
+
+    auto do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) -> void override {
+        ++deallocations;
+        auto it = live.find(ptr);
+        if (it == live.end() or it->second != bytes) {
+            ++mismatches;
+        } else {
+            live.erase(it);
+        }
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override {
+        return this == &other;
+    }
+};
+
+}  // namespace
+
+TEST_CASE("pmr deallocate receives the allocation size") {
+    size_checking_resource resource;
+    std::pmr::polymorphic_allocator<char> alloc{&resource};
+
+    SUBCASE("destructor of every tier") {
+        {
+            small::pmr::small_string short_str(std::string(100, 's'), alloc);
+            small::pmr::small_string median_str(std::string(1000, 'm'), alloc);
+            small::pmr::small_string long_str(std::string(20000, 'l'), alloc);
+            small::pmr::small_byte_string byte_str(std::string(300, 'b'), alloc);
+        }
+        CHECK(resource.deallocations == 4);
+        CHECK(resource.mismatches == 0);
+        CHECK(resource.live.empty());
+    }
+
+    SUBCASE("growth through all tiers") {
+        {
+            small::pmr::small_string str(alloc);
+            for (int i = 0; i < 40000; ++i) {
+                str.push_back('g');
+            }
+            str.reserve(100000);
+            CHECK(str.size() == 40000);
+        }
+        CHECK(resource.deallocations > 3);
+        CHECK(resource.mismatches == 0);
+        CHECK(resource.live.empty());
+    }
+
+    SUBCASE("shrink_to_fit") {
+        {
+            small::pmr::small_string str(std::string(5000, 'x'), alloc);
+            str.resize(20);
+            str.shrink_to_fit();
+            CHECK(str.size() == 20);
+        }
+        CHECK(resource.mismatches == 0);
+        CHECK(resource.live.empty());
+    }
+}
+
+TEST_CASE("pmr strings over pool resources") {
+    SUBCASE("unsynchronized_pool_resource keeps its upstream stable") {
+        size_checking_resource upstream;
+        std::pmr::unsynchronized_pool_resource pool{&upstream};
+        std::pmr::polymorphic_allocator<char> alloc{&pool};
+        std::size_t live_after_first_round = 0;
+        for (int round = 0; round < 8; ++round) {
+            std::vector<small::pmr::small_string> strings;
+            for (int i = 0; i < 256; ++i) {
+                strings.emplace_back(std::string(static_cast<size_t>(20 + i * 7), 'p'), alloc);
+            }
+            strings.clear();
+            if (round == 0) {
+                live_after_first_round = upstream.live.size();
+            }
+            CHECK(upstream.live.size() <= live_after_first_round);
+        }
+        CHECK(upstream.mismatches == 0);
+    }
+
+    SUBCASE("synchronized_pool_resource mixed sizes") {
+        size_checking_resource upstream;
+        std::pmr::synchronized_pool_resource pool{&upstream};
+        std::pmr::polymorphic_allocator<char> alloc{&pool};
+        for (int round = 0; round < 3; ++round) {
+            std::vector<small::pmr::small_string> strings;
+            for (size_t len = 8; len < 3000; len += 37) {
+                strings.emplace_back(std::string(len, 'z'), alloc);
+                strings.back().append(len, 'y');
+            }
+            for (const auto& str : strings) {
+                CHECK(str.size() % 2 == 0);
+            }
+        }
+        CHECK(upstream.mismatches == 0);
+    }
+}
+
+TEST_CASE("compact relocates pmr strings into a fresh resource") {
+    SUBCASE("every tier moves and the old resource is left empty") {
+        size_checking_resource old_resource;
+        size_checking_resource fresh_resource;
+        std::vector<small::pmr::small_string> strings;
+        for (size_t len : {3UL, 100UL, 1000UL, 20000UL, 40UL}) {
+            strings.emplace_back(std::string(len, 'c'), std::pmr::polymorphic_allocator<char>{&old_resource});
+        }
+        // leave some slack behind
+        strings[2].append(3000, 'd');
+        strings[2].resize(1500);
+        strings[3].resize(100);
+        strings[4].erase(0, 36);
+        std::vector<std::string> expected;
+        for (const auto& str : strings) {
+            expected.emplace_back(str.data(), str.size());
+        }
+        std::size_t old_bytes = 0;
+        for (const auto& [ptr, bytes] : old_resource.live) {
+            old_bytes += bytes;
+        }
+
+        auto reclaimed = small::pmr::compact(strings, &fresh_resource);
+
+        CHECK(old_resource.live.empty());
+        CHECK(old_resource.mismatches == 0);
+        std::size_t new_bytes = 0;
+        for (const auto& [ptr, bytes] : fresh_resource.live) {
+            new_bytes += bytes;
+        }
+        CHECK(reclaimed == old_bytes - new_bytes);
+        CHECK(reclaimed > 0);
+        for (size_t i = 0; i < strings.size(); ++i) {
+            CHECK(strings[i].get_allocator().resource() == &fresh_resource);
+            CHECK(std::string(strings[i].data(), strings[i].size()) == expected[i]);
+            CHECK(strings[i].c_str()[strings[i].size()] == '\0');
+        }
+        CHECK(strings[0].get_core_type() == static_cast<uint8_t>(small::CoreType::Internal));
+        CHECK(strings[3].get_core_type() == static_cast<uint8_t>(small::CoreType::Short));
+        CHECK(strings[4].get_core_type() == static_cast<uint8_t>(small::CoreType::Internal));
+
+        // the strings keep working on the new resource
+        strings[0].append(500, 'e');
+        CHECK(old_resource.live.empty());
+        strings.clear();
+        CHECK(fresh_resource.live.empty());
+        CHECK(fresh_resource.mismatches == 0);
+    }
+
+    SUBCASE("the old arena can be released") {
+        std::pmr::monotonic_buffer_resource fresh_arena;
+        std::vector<small::pmr::small_string> survivors;
+        {
+            std::pmr::monotonic_buffer_resource old_arena;
+            std::pmr::polymorphic_allocator<char> alloc{&old_arena};
+            for (int round = 0; round < 50; ++round) {
+                std::vector<small::pmr::small_string> churn;
+                for (size_t i = 0; i < 20; ++i) {
+                    churn.emplace_back(std::string(50 + i * 30, 'x'), alloc);
+                }
+                survivors.emplace_back(churn[static_cast<size_t>(round) % churn.size()]);
+            }
+            small::pmr::compact(survivors, &fresh_arena);
+        }
+        for (size_t i = 0; i < survivors.size(); ++i) {
+            CHECK(survivors[i] == std::string(50 + (i % 20) * 30, 'x'));
+            CHECK(survivors[i].get_allocator().resource() == &fresh_arena);
+        }
+    }
+}
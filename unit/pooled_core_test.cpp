@@ -0,0 +1,155 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+TEST_CASE("short_buffer_pool size classes") {
+    SUBCASE("every class round trips") {
+        for (size_t size = 8; size <= 256; size += 8) {
+            auto* block = small::short_buffer_pool::allocate(size);
+            REQUIRE(block != nullptr);
+            std::memset(block, 'p', size);
+            small::short_buffer_pool::deallocate(block, size);
+        }
+    }
+
+    SUBCASE("freed block is reused by the same class") {
+        auto* first = small::short_buffer_pool::allocate(64);
+        small::short_buffer_pool::deallocate(first, 64);
+        auto* second = small::short_buffer_pool::allocate(64);
+        CHECK(first == second);
+        small::short_buffer_pool::deallocate(second, 64);
+    }
+
+    SUBCASE("slabs are shared by many blocks") {
+        std::vector<void*> blocks;
+        auto before = small::short_buffer_pool::slab_count();
+        for (int i = 0; i < 1000; ++i) {
+            blocks.push_back(small::short_buffer_pool::allocate(32));
+        }
+        CHECK(small::short_buffer_pool::slab_count() - before <= 1);
+        for (auto* block : blocks) {
+            small::short_buffer_pool::deallocate(block, 32);
+        }
+    }
+}
+
+TEST_CASE("pooled_small_string behaves like small_string") {
+    SUBCASE("object size") { CHECK(sizeof(small::pooled_small_string) == 8); }
+
+    SUBCASE("grow through all tiers") {
+        small::pooled_small_string str;
+        std::string expected;
+        for (int i = 0; i < 20000; ++i) {
+            auto ch = static_cast<char>('a' + i % 26);
+            str.push_back(ch);
+            expected.push_back(ch);
+        }
+        CHECK(std::string_view(str) == expected);
+        CHECK(str.c_str()[str.size()] == '\0');
+    }
+
+    SUBCASE("copy, reserve and shrink") {
+        small::pooled_small_string str("a short tier string of 30 char");
+        auto copy = str;
+        CHECK(copy == str);
+        copy.reserve(200);
+        CHECK(copy == str);
+        copy.resize(10);
+        copy.shrink_to_fit();
+        CHECK(copy == "a short ti");
+    }
+
+    SUBCASE("byte string") {
+        small::pooled_small_byte_string str("0123456789abcdef0123456789");
+        str.append("xyz");
+        CHECK(str.size() == 29);
+        CHECK(str == "0123456789abcdef0123456789xyz");
+    }
+}
+
+TEST_CASE("pooled_small_string cross thread free") {
+    SUBCASE("strings allocated on one thread are destroyed on another") {
+        std::vector<small::pooled_small_string> strings;
+        std::thread producer([&strings]() {
+            for (int i = 0; i < 2000; ++i) {
+                strings.emplace_back(std::string(static_cast<size_t>(8 + i % 200), static_cast<char>('a' + i % 26)));
+            }
+        });
+        producer.join();
+        std::thread consumer([&strings]() { strings.clear(); });
+        consumer.join();
+        CHECK(strings.empty());
+    }
+
+    SUBCASE("blocks freed remotely are recycled by the owner") {
+        std::vector<small::pooled_small_string> strings;
+        for (int i = 0; i < 100; ++i) {
+            strings.emplace_back("remote freed string");
+        }
+        std::thread consumer([&strings]() { strings.clear(); });
+        consumer.join();
+        auto before = small::short_buffer_pool::slab_count();
+        for (int i = 0; i < 100; ++i) {
+            strings.emplace_back("remote freed string");
+        }
+        CHECK(small::short_buffer_pool::slab_count() == before);
+        strings.clear();
+    }
+
+    SUBCASE("many threads") {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([]() {
+                std::vector<small::pooled_small_string> local;
+                for (int i = 0; i < 5000; ++i) {
+                    local.emplace_back(std::string(static_cast<size_t>(10 + i % 100), 'x'));
+                    if (i % 3 == 0) {
+                        local.erase(local.begin());
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        CHECK(threads.size() == 4);
+    }
+}
+
+namespace {
+
+std::atomic<std::size_t> late_allocations = 0;
+
+// destroyed after the cache_guard of its thread, which was constructed later
+struct late_allocator
+{
+    ~late_allocator() {
+        small::pooled_small_string late(std::string(40, 'l'));
+        small::pooled_small_string copy = late;
+        if (copy == late) {
+            late_allocations.fetch_add(1);
+        }
+    }
+};
+
+}  // namespace
+
+TEST_CASE("pooled_small_string allocated after the thread cache is handed back") {
+    for (int round = 0; round < 3; ++round) {
+        std::thread thread([]() {
+            thread_local late_allocator late;
+            small::pooled_small_string warm("attaches the cache of the thread");
+            CHECK(warm.size() == 32);
+        });
+        thread.join();
+    }
+    CHECK(late_allocations.load() == 3);
+    // the borrowed caches went back to the abandoned list, new threads still adopt them
+    std::thread adopter([]() { small::pooled_small_string str(std::string(100, 'a')); });
+    adopter.join();
+}
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+#include "unit/test_text.hpp"
+
+TEST_CASE("searcher picks its algorithm from the needle length") {
+    using algorithm = small::searcher::algorithm;
+    CHECK(small::searcher("").strategy() == algorithm::empty);
+    CHECK(small::searcher("x").strategy() == algorithm::memchr);
+    CHECK(small::searcher("xy").strategy() == algorithm::filter);
+    CHECK(small::searcher(std::string(small::searcher::kFilterMax, 'a')).strategy() == algorithm::filter);
+    if (small::searcher::kFilterMax < small::searcher::kHorspoolMax) {
+        CHECK(small::searcher(std::string(small::searcher::kFilterMax + 1, 'a')).strategy() == algorithm::horspool);
+        CHECK(small::searcher(std::string(small::searcher::kHorspoolMax, 'a')).strategy() == algorithm::horspool);
+    }
+    CHECK(small::searcher(std::string(small::searcher::kHorspoolMax + 1, 'a')).strategy() == algorithm::two_way);
+    CHECK(small::searcher("needle").needle() == "needle");
+}
+
+TEST_CASE("searcher agrees with string_view::find") {
+    std::mt19937 gen(31);
+    // two letters make periodic needles and many partial matches, the worst case of every algorithm
+    for (std::string_view alphabet : {"ab", "abcd", "abcdefghijklmnopqrstuvwxyz "}) {
+        for (std::size_t size : {0UL, 1UL, 20UL, 100UL, 1000UL, 5000UL}) {
+            auto text = make_text(gen, size, alphabet);
+            for (std::size_t count : {1UL, 2UL, 5UL, 17UL, 32UL, 33UL, 64UL, 200UL, 257UL, 600UL}) {
+                for (int round = 0; round < 4; ++round) {
+                    // half of the needles are cut from the text, so they are found
+                    std::uniform_int_distribution<std::size_t> start(0, count > size ? 0 : size - count);
+                    auto needle = round % 2 == 0 or count > size ? make_text(gen, count, alphabet)
+                                                                 : text.substr(start(gen), count);
+                    small::searcher compiled(needle);
+                    CHECK(compiled.find(text.data(), text.size()) == to_kernel(std::string_view(text).find(needle)));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("search::find_horspool agrees with string_view::find") {
+    // the vector builds leave Horspool no needle length, so the kernel is checked directly with the skips a searcher
+    // builds, over every length a scalar build gives it
+    std::mt19937 gen(37);
+    for (std::string_view alphabet : {"ab", "abcd", "abcdefghijklmnopqrstuvwxyz "}) {
+        for (std::size_t size : {0UL, 9UL, 100UL, 3000UL}) {
+            auto text = make_text(gen, size, alphabet);
+            for (std::size_t count : {2UL, 9UL, 10UL, 40UL, 100UL, small::searcher::kHorspoolMax}) {
+                for (int round = 0; round < 6; ++round) {
+                    // half of the needles are cut from the text, the last one from its end
+                    std::uniform_int_distribution<std::size_t> start(0, count > size ? 0 : size - count);
+                    auto from = round == 5 ? size - count : start(gen);
+                    auto needle = round % 2 == 0 or count > size ? make_text(gen, count, alphabet)
+                                                                 : text.substr(from, count);
+                    uint32_t shifts[256];
+                    small::search::fill_shifts(needle.data(), count, count - 1, shifts);
+                    CHECK(small::search::find_horspool(text.data(), text.size(), needle.data(), count, shifts) ==
+                          to_kernel(std::string_view(text).find(needle)));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("two-way on periodic needles") {
+    for (std::string unit : {"a", "ab", "aab", "abcabd"}) {
+        std::string needle;
+        while (needle.size() <= small::searcher::kHorspoolMax) {
+            needle += unit;
+        }
+        auto text = needle.substr(0, needle.size() - 1) + "x" + needle + needle;
+        small::searcher compiled(needle);
+        CHECK(compiled.strategy() == small::searcher::algorithm::two_way);
+        CHECK(compiled.find(text.data(), text.size()) == text.find(needle));
+        auto missing = needle;
+        missing[missing.size() / 2] = 'x';
+        CHECK(small::searcher(missing).find(text.data(), text.size()) == to_kernel(text.find(missing)));
+    }
+}
+
+TEST_CASE("find with a searcher") {
+    std::string text = std::string(3000, '-') + "Content-Length: 42" + std::string(100, '-');
+    small::small_string str(text);
+    small::small_byte_string bytes(text);
+    for (std::string_view needle : {"C", "Content-Length:", "-Content-Length: 42-", "missing", ""}) {
+        small::searcher compiled(needle);
+        for (std::size_t pos : {0UL, 10UL, 3000UL, 3001UL, text.size(), text.size() + 1}) {
+            auto expected = text.find(needle, pos);
+            CHECK(str.find(compiled, pos) == (expected == std::string::npos ? small::small_string::npos : expected));
+            CHECK(bytes.find(compiled, pos) == str.find(compiled, pos));
+        }
+    }
+}
+
+TEST_CASE("searcher works with std::search") {
+    std::string text = "the quick brown fox jumps over the lazy dog";
+    small::small_string str(text);
+    small::searcher fox("fox");
+    auto it = std::search(text.begin(), text.end(), fox);
+    CHECK(it - text.begin() == 16);
+    auto small_it = std::search(str.begin(), str.end(), fox);
+    CHECK(small_it - str.begin() == 16);
+    auto [first, last] = fox(str.data(), str.data() + str.size());
+    CHECK(std::string_view(first, static_cast<std::size_t>(last - first)) == "fox");
+    CHECK(std::search(text.begin(), text.end(), small::searcher("cat")) == text.end());
+    CHECK(std::search(text.begin(), text.end(), small::searcher("")) == text.begin());
+    // same answers as the standard searcher
+    std::string needle(40, 'o');
+    text += needle;
+    CHECK(std::search(text.begin(), text.end(), small::searcher(needle)) ==
+          std::search(text.begin(), text.end(), std::boyer_moore_horspool_searcher(needle.begin(), needle.end())));
+}
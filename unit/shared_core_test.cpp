@@ -0,0 +1,174 @@
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+namespace {
+
+// the const data() never unshares, so it tells whether two strings point to the same buffer
+auto same_buffer(const small::shared_small_string& lhs, const small::shared_small_string& rhs) -> bool {
+    return lhs.data() == rhs.data();
+}
+
+}  // namespace
+
+TEST_CASE("shared_small_string shares Median and Long buffers") {
+    SUBCASE("object size") { CHECK(sizeof(small::shared_small_string) == 8); }
+
+    SUBCASE("copies of Median and Long share, Short and Internal copy") {
+        small::shared_small_string median(std::string(1000, 'm'));
+        small::shared_small_string long_str(std::string(20000, 'l'));
+        small::shared_small_string short_str(std::string(100, 's'));
+        small::shared_small_string internal("abc");
+        auto median_copy = median;
+        auto long_copy = long_str;
+        auto short_copy = short_str;
+        auto internal_copy = internal;
+        CHECK(same_buffer(median, median_copy));
+        CHECK(same_buffer(long_str, long_copy));
+        CHECK_FALSE(same_buffer(short_str, short_copy));
+        CHECK(median_copy == std::string(1000, 'm'));
+        CHECK(long_copy == std::string(20000, 'l'));
+        CHECK(short_copy == std::string(100, 's'));
+        CHECK(internal_copy == "abc");
+        CHECK(long_copy.c_str()[20000] == '\0');
+    }
+
+    SUBCASE("append unshares") {
+        small::shared_small_string original(std::string(5000, 'a'));
+        auto copy = original;
+        copy.append("tail");
+        CHECK_FALSE(same_buffer(original, copy));
+        CHECK(original == std::string(5000, 'a'));
+        CHECK(copy == std::string(5000, 'a') + "tail");
+        // growing beyond the capacity while shared
+        auto grown = original;
+        grown.append(std::string(50000, 'b'));
+        CHECK(original.size() == 5000);
+        CHECK(grown.size() == 55000);
+        CHECK(grown.c_str()[55000] == '\0');
+    }
+
+    SUBCASE("writes through operator[] and data() unshare") {
+        small::shared_small_string original(std::string(3000, 'w'));
+        auto indexed = original;
+        indexed[10] = 'X';
+        CHECK(original[10] == 'w');
+        CHECK(indexed[10] == 'X');
+        auto written = original;
+        written.data()[0] = 'Y';
+        CHECK(original.front() == 'w');
+        CHECK(written.front() == 'Y');
+        auto iterated = original;
+        *iterated.begin() = 'Z';
+        CHECK(original.front() == 'w');
+    }
+
+    SUBCASE("a reference taken before the copy does not write into it") {
+        small::shared_small_string a(std::string(3000, 'a'));
+        char& r = a[0];
+        small::shared_small_string b(a);
+        r = 'X';
+        CHECK(a[0] == 'X');
+        CHECK(b[0] == 'a');
+        CHECK_FALSE(same_buffer(a, b));
+        // the same for the pointers and iterators
+        small::shared_small_string c(std::string(3000, 'c'));
+        auto* p = c.data();
+        auto it = c.end() - 1;
+        small::shared_small_string d(c);
+        *p = 'Y';
+        *it = 'Z';
+        CHECK(std::as_const(d).front() == 'c');
+        CHECK(std::as_const(d).back() == 'c');
+        // a leaked buffer is still freed by its single owner, and fresh buffers share again
+        c.reserve(100000);
+        small::shared_small_string e(c);
+        CHECK(same_buffer(c, e));
+    }
+
+    SUBCASE("size changes unshare") {
+        small::shared_small_string original(std::string(3000, 'r'));
+        auto resized = original;
+        resized.resize(10);
+        CHECK(original.size() == 3000);
+        auto cleared = original;
+        cleared.clear();
+        CHECK(cleared.empty());
+        CHECK(original.size() == 3000);
+        auto erased = original;
+        erased.erase(0, 2000);
+        CHECK(erased.size() == 1000);
+        CHECK(original.size() == 3000);
+        auto reserved = original;
+        reserved.reserve(100000);
+        CHECK(reserved.capacity() >= 100000);
+        CHECK(original.capacity() < 100000);
+        auto popped = original;
+        popped.pop_back();
+        CHECK(popped.size() == 2999);
+        CHECK(original.size() == 3000);
+    }
+
+    SUBCASE("the last owner frees the buffer") {
+        auto* copy = new small::shared_small_string(std::string(4000, 'f'));
+        {
+            small::shared_small_string original(*copy);
+            delete copy;
+            CHECK(original == std::string(4000, 'f'));
+            original.push_back('g');
+            CHECK(original.back() == 'g');
+        }
+    }
+
+    SUBCASE("assignment, move and swap") {
+        small::shared_small_string original(std::string(2000, 'o'));
+        small::shared_small_string target(std::string(3000, 't'));
+        target = original;
+        CHECK(same_buffer(original, target));
+        small::shared_small_string moved(std::move(target));
+        CHECK(same_buffer(original, moved));
+        small::shared_small_string other("short");
+        moved.swap(other);
+        CHECK(other == std::string(2000, 'o'));
+        CHECK(moved == "short");
+        other = small::shared_small_string("tiny");
+        CHECK(original == std::string(2000, 'o'));
+    }
+
+    SUBCASE("copies on many threads") {
+        small::shared_small_string body(std::string(64 * 1024, 'b'));
+        std::vector<small::shared_small_string> copies(8, body);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < copies.size(); ++t) {
+            threads.emplace_back([&copies, t]() {
+                for (int i = 0; i < 100; ++i) {
+                    auto local = copies[t];
+                    auto another = local;
+                    another.push_back(static_cast<char>('0' + t));
+                    CHECK(another.size() == 64 * 1024 + 1);
+                }
+                copies[t].back() = static_cast<char>('0' + t);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        CHECK(body == std::string(64 * 1024, 'b'));
+        for (size_t t = 0; t < copies.size(); ++t) {
+            CHECK(copies[t].back() == static_cast<char>('0' + t));
+        }
+    }
+
+    SUBCASE("byte string") {
+        small::shared_small_byte_string original(std::string(1000, 'y'));
+        auto copy = original;
+        CHECK(std::as_const(original).data() == std::as_const(copy).data());
+        copy.append(10, 'z');
+        CHECK(original.size() == 1000);
+        CHECK(copy.size() == 1010);
+    }
+}
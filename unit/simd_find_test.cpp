@@ -0,0 +1,86 @@
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+#include "unit/test_text.hpp"
+
+TEST_CASE("search::find agrees with string_view::find") {
+    std::mt19937 gen(7);
+    for (std::size_t size : {0UL, 1UL, 5UL, 15UL, 16UL, 17UL, 31UL, 32UL, 33UL, 64UL, 100UL, 257UL, 4099UL}) {
+        auto text = make_text(gen, size, " ab");
+        for (std::size_t count = 1; count <= 40; count += (count < 6 ? 1 : 7)) {
+            for (int round = 0; round < 8; ++round) {
+                auto needle = make_text(gen, count, " ab");
+                auto found = small::search::find(text.data(), text.size(), needle.data(), needle.size());
+                CHECK(found == to_kernel(std::string_view(text).find(needle)));
+            }
+        }
+    }
+}
+
+#ifdef SMALL_STRING_X86_SIMD
+TEST_CASE("every vector kernel finds the same match") {
+    std::mt19937 gen(11);
+    for (std::size_t size : {18UL, 40UL, 65UL, 1000UL}) {
+        auto text = make_text(gen, size, " \"x");
+        for (std::size_t count : {2UL, 3UL, 8UL, 17UL}) {
+            auto needle = make_text(gen, count, " \"x");
+            auto expected = small::search::find_scalar(text.data(), text.size(), needle.data(), needle.size());
+            auto anchor = small::search::anchor_of(needle.data(), needle.size());
+            CHECK(small::search::find_sse2(text.data(), text.size(), needle.data(), needle.size(), anchor) == expected);
+            if (__builtin_cpu_supports("avx2")) {
+                CHECK(small::search::find_avx2(text.data(), text.size(), needle.data(), needle.size(), anchor) ==
+                      expected);
+            }
+        }
+    }
+}
+#endif
+
+TEST_CASE("find on common first chars across the tiers") {
+    for (std::size_t size : {6UL, 200UL, 4000UL, 70000UL}) {
+        // log lines full of spaces, the needle starts with one too
+        std::string text;
+        while (text.size() + 3 < size) {
+            text += "k v ";
+        }
+        text.resize(size - 3, ' ');
+        text += " x=";
+        small::small_string str(text);
+        small::small_byte_string bytes(text);
+        CHECK(str.find(" x=") == size - 3);
+        CHECK(bytes.find(" x=") == size - 3);
+        CHECK(str.find(std::string_view(" x=")) == size - 3);
+        CHECK(str.find(small::small_string(" x=")) == size - 3);
+        CHECK(str.contains(" x="));
+        CHECK(str.contains(std::string_view(" x=")));
+        CHECK_FALSE(str.contains(" y="));
+        CHECK(str.find(" x=", size - 3) == size - 3);
+        CHECK(str.find(" x=", size - 2) == small::small_string::npos);
+        CHECK(str.find(" v ") == text.find(" v "));
+    }
+}
+
+TEST_CASE("find from every position matches std::string") {
+    std::mt19937 gen(3);
+    auto text = make_text(gen, 300, "{\":}");
+    small::small_string str(text);
+    for (std::string_view needle : {"\":", "{\"", "\"}:", "::{\"", "}}}}}}}}}}"}) {
+        for (std::size_t pos = 0; pos <= text.size() + 1; pos += 13) {
+            auto expected = text.find(needle, pos);
+            CHECK(str.find(needle, pos) ==
+                  (expected == std::string::npos ? small::small_string::npos : expected));
+        }
+    }
+}
+
+TEST_CASE("wide strings keep the scalar find") {
+    std::u16string text(500, u' ');
+    text += u" x=";
+    small::u16string str(text.data(), text.size());
+    CHECK(str.find(u" x=") == 500);
+    CHECK(str.find(u" y=") == small::u16string::npos);
+}
@@ -0,0 +1,89 @@
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+#include "unit/test_text.hpp"
+
+TEST_CASE("search::rfind_char agrees with string_view::rfind") {
+    std::mt19937 gen(5);
+    for (std::size_t size : {0UL, 1UL, 15UL, 16UL, 17UL, 63UL, 64UL, 65UL, 127UL, 128UL, 129UL, 1000UL}) {
+        auto text = make_text(gen, size, "abcdefgh/");
+        for (char ch : {'a', '/', 'z'}) {
+            CHECK(small::search::rfind_char(text.data(), text.size(), ch) == to_kernel(std::string_view(text).rfind(ch)));
+        }
+    }
+}
+
+TEST_CASE("search::rfind agrees with string_view::rfind") {
+    std::mt19937 gen(9);
+    for (std::size_t size : {0UL, 2UL, 16UL, 17UL, 33UL, 64UL, 81UL, 100UL, 257UL, 4099UL}) {
+        auto text = make_text(gen, size, "/ab");
+        for (std::size_t count = 1; count <= 40; count += (count < 6 ? 1 : 7)) {
+            for (int round = 0; round < 8; ++round) {
+                auto needle = make_text(gen, count, "/ab");
+                CHECK(small::search::rfind(text.data(), text.size(), needle.data(), needle.size()) ==
+                      to_kernel(std::string_view(text).rfind(needle)));
+            }
+        }
+    }
+}
+
+#ifdef SMALL_STRING_X86_SIMD
+TEST_CASE("every backward kernel finds the same match") {
+    std::mt19937 gen(13);
+    for (std::size_t size : {18UL, 70UL, 130UL, 1000UL}) {
+        auto text = make_text(gen, size, "/.x");
+        CHECK(small::search::rfind_char_sse2(text.data(), text.size(), '/') ==
+              small::search::rfind_char_scalar(text.data(), text.size(), '/'));
+        for (std::size_t count : {2UL, 3UL, 9UL}) {
+            auto needle = make_text(gen, count, "/.x");
+            auto anchor = small::search::anchor_of(needle.data(), needle.size());
+            auto expected = small::search::rfind_scalar(text.data(), text.size(), needle.data(), needle.size());
+            CHECK(small::search::rfind_sse2(text.data(), text.size(), needle.data(), needle.size(), anchor) ==
+                  expected);
+            if (__builtin_cpu_supports("avx2")) {
+                CHECK(small::search::rfind_char_avx2(text.data(), text.size(), '/') ==
+                      small::search::rfind_char_scalar(text.data(), text.size(), '/'));
+                CHECK(small::search::rfind_avx2(text.data(), text.size(), needle.data(), needle.size(), anchor) ==
+                      expected);
+            }
+        }
+    }
+}
+#endif
+
+TEST_CASE("rfind of paths across the tiers") {
+    for (std::size_t depth : {1UL, 20UL, 400UL, 5000UL}) {
+        std::string path;
+        for (std::size_t i = 0; i < depth; ++i) {
+            path += "/dir";
+        }
+        path += "/file.tar.gz";
+        small::small_string str(path);
+        small::small_byte_string bytes(path);
+        CHECK(str.rfind('/') == path.rfind('/'));
+        CHECK(bytes.rfind('/') == path.rfind('/'));
+        CHECK(str.rfind('.') == path.rfind('.'));
+        CHECK(str.rfind('#') == small::small_string::npos);
+        CHECK(str.rfind("/dir") == path.rfind("/dir"));
+        CHECK(str.rfind(std::string_view(".tar")) == path.rfind(".tar"));
+        CHECK(str.rfind(small::small_string("/d")) == path.rfind("/d"));
+        CHECK(str.rfind("") == path.size());
+        for (std::size_t pos : {0UL, 3UL, 4UL, path.size() / 2, path.size() - 1, path.size() + 5}) {
+            CHECK(str.rfind('/', pos) == path.rfind('/', pos));
+            CHECK(str.rfind("/dir", pos) == path.rfind("/dir", pos));
+            CHECK(str.rfind("", pos) == path.rfind("", pos));
+        }
+    }
+}
+
+TEST_CASE("wide strings keep the scalar rfind") {
+    std::u32string text(300, U'a');
+    text += U"/b/c";
+    small::u32string str(text.data(), text.size());
+    CHECK(str.rfind(U'/') == text.rfind(U'/'));
+    CHECK(str.rfind(U"/b") == text.rfind(U"/b"));
+}
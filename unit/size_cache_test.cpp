@@ -0,0 +1,115 @@
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+// the debug build asserts the size cached by wide_core against the buffer header on every read, so these walk
+// Median/Long strings through every path writing the header and compare them with std::string
+template <typename String>
+static void check_long_tier_edits() {
+    std::string expected(20000, 'a');
+    String str(expected.c_str(), expected.size());
+
+    SUBCASE("append within the capacity") {
+        for (int i = 0; i < 500; ++i) {
+            str.append("0123456789");
+            expected.append("0123456789");
+            CHECK(str.size() == expected.size());
+            CHECK(str.capacity() >= str.size());
+        }
+        CHECK(std::string_view(str.data(), str.size()) == expected);
+    }
+
+    SUBCASE("append into a reserved buffer") {
+        str.reserve(100000);
+        for (int i = 0; i < 3000; ++i) {
+            str.append("0123456789abcdef");
+            expected.append("0123456789abcdef");
+        }
+        CHECK(str.size() == expected.size());
+        CHECK(std::string_view(str.data(), str.size()) == expected);
+        CHECK(str.end() - str.begin() == static_cast<std::ptrdiff_t>(expected.size()));
+    }
+
+    SUBCASE("erase and push_back") {
+        for (int i = 0; i < 20; ++i) {
+            str.erase(0, 900);
+            expected.erase(0, 900);
+            CHECK(str.size() == expected.size());
+            str.push_back('z');
+            expected.push_back('z');
+        }
+        CHECK(std::string_view(str.data(), str.size()) == expected);
+    }
+
+    SUBCASE("resize and clear") {
+        str.resize(30000, 'b');
+        expected.resize(30000, 'b');
+        CHECK(str.size() == 30000);
+        str.resize(100);
+        expected.resize(100);
+        CHECK(str.size() == 100);
+        CHECK(std::string_view(str.data(), str.size()) == expected);
+        str.clear();
+        CHECK(str.empty());
+        str.append(expected.c_str(), expected.size());
+        CHECK(str.size() == expected.size());
+    }
+
+    SUBCASE("copies and moves keep the cache") {
+        str.append("tail");
+        expected.append("tail");
+        String copy(str);
+        String moved(std::move(str));
+        CHECK(copy.size() == expected.size());
+        CHECK(moved.size() == expected.size());
+        copy.swap(moved);
+        copy.pop_back();
+        CHECK(copy.size() == expected.size() - 1);
+        CHECK(moved.size() == expected.size());
+    }
+}
+
+TEST_CASE("Long tier size cache") {
+    SUBCASE("malloc_core") { check_long_tier_edits<small::small_string>(); }
+    SUBCASE("wide_core") { check_long_tier_edits<small::wide_small_string>(); }
+    SUBCASE("huge_core") { check_long_tier_edits<small::huge_small_string>(); }
+    SUBCASE("shared_core") { check_long_tier_edits<small::shared_small_string>(); }
+}
+
+TEST_CASE("wide_core caches the size of Median/Long strings") {
+    for (std::size_t length : {300UL, 16383UL, 16384UL, 70000UL}) {
+        std::string expected(length, 'w');
+        small::wide_small_string str(expected.c_str(), expected.size());
+        CHECK(str.size() == length);
+        CHECK(std::string_view(str) == expected);
+        str.insert(0, "head");
+        expected.insert(0, "head");
+        CHECK(str.size() == expected.size());
+        str.replace(10, 100, "x");
+        expected.replace(10, 100, "x");
+        CHECK(std::string_view(str) == expected);
+        str.shrink_to_fit();
+        CHECK(str.size() == expected.size());
+    }
+}
+
+TEST_CASE("pmr Long strings keep the cache through relocation") {
+    std::pmr::unsynchronized_pool_resource pool;
+    std::pmr::monotonic_buffer_resource arena;
+    std::string expected(40000, 'p');
+    std::vector<small::pmr::small_string> strings;
+    strings.emplace_back(expected.c_str(), expected.size(), &pool);
+    auto& str = strings.front();
+    str.append("more");
+    expected.append("more");
+    CHECK(str.size() == expected.size());
+    small::pmr::compact(strings, &arena);
+    CHECK(str.size() == expected.size());
+    str.push_back('!');
+    expected.push_back('!');
+    CHECK(std::string_view(str) == expected);
+}
@@ -0,0 +1,134 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+namespace {
+
+auto total_bytes_balance(const small::stats::counters& counters) -> int64_t {
+    int64_t balance = 0;
+    for (const auto& tier : counters.tiers) {
+        balance += static_cast<int64_t>(tier.allocated_bytes) - static_cast<int64_t>(tier.deallocated_bytes);
+    }
+    return balance;
+}
+
+}  // namespace
+
+#ifdef SMALL_STRING_STATS
+
+TEST_CASE("stats count buffers by tier") {
+    using small::CoreType;
+    small::stats::reset();
+
+    SUBCASE("internal strings allocate nothing") {
+        {
+            small::small_string str("abc");
+            CHECK(str.size() == 3);
+        }
+        auto counters = small::stats::snapshot();
+        for (const auto& tier : counters.tiers) {
+            CHECK(tier.allocations == 0);
+        }
+    }
+
+    SUBCASE("allocation and release of every tier") {
+        {
+            small::small_string short_str(std::string(100, 's'));
+            small::small_string median_str(std::string(1000, 'm'));
+            small::small_string long_str(std::string(20000, 'l'));
+            auto counters = small::stats::snapshot();
+            CHECK(counters.tier(CoreType::Short).allocations == 1);
+            CHECK(counters.tier(CoreType::Median).allocations == 1);
+            CHECK(counters.tier(CoreType::Long).allocations == 1);
+            CHECK(counters.tier(CoreType::Long).allocated_bytes >= 20000);
+            CHECK(counters.tier(CoreType::Long).deallocations == 0);
+        }
+        auto counters = small::stats::snapshot();
+        for (auto type : {CoreType::Short, CoreType::Median, CoreType::Long}) {
+            CHECK(counters.tier(type).deallocations == 1);
+            CHECK(counters.tier(type).allocated_bytes == counters.tier(type).deallocated_bytes);
+        }
+    }
+
+    SUBCASE("growth records the transitions") {
+        {
+            small::small_string str;
+            for (int i = 0; i < 40000; ++i) {
+                str.push_back('g');
+            }
+        }
+        auto counters = small::stats::snapshot();
+        CHECK(counters.transition(CoreType::Internal, CoreType::Short) == 1);
+        CHECK(counters.transition(CoreType::Short, CoreType::Median) == 1);
+        CHECK(counters.transition(CoreType::Median, CoreType::Long) == 1);
+        CHECK(counters.transition(CoreType::Short, CoreType::Short) > 0);
+        CHECK(counters.transition(CoreType::Long, CoreType::Long) > 0);
+        // Median and Long grow with realloc
+        CHECK(counters.tier(CoreType::Median).reallocations > 0);
+        CHECK(counters.tier(CoreType::Long).reallocations > 0);
+        CHECK(total_bytes_balance(counters) == 0);
+    }
+
+    SUBCASE("reserve and shrink_to_fit") {
+        {
+            small::small_string str("metric");
+            str.reserve(1000);
+            str.reserve(100000);
+            str.shrink_to_fit();
+            CHECK(str == "metric");
+        }
+        auto counters = small::stats::snapshot();
+        CHECK(counters.transition(CoreType::Internal, CoreType::Median) == 1);
+        CHECK(counters.transition(CoreType::Median, CoreType::Long) == 1);
+        CHECK(counters.transition(CoreType::Long, CoreType::Internal) == 1);
+        CHECK(total_bytes_balance(counters) == 0);
+    }
+
+    SUBCASE("pmr strings are counted too") {
+        {
+            small::pmr::small_string str(std::string(500, 'p'), std::pmr::polymorphic_allocator<char>{});
+            CHECK(small::stats::snapshot().tier(CoreType::Median).allocations == 1);
+        }
+        CHECK(small::stats::snapshot().tier(CoreType::Median).deallocations == 1);
+    }
+
+    SUBCASE("threads") {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([]() {
+                for (int i = 0; i < 1000; ++i) {
+                    small::small_string str(std::string(static_cast<size_t>(100 + i % 2000), 't'));
+                    str.append(300, 'u');
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto counters = small::stats::snapshot();
+        uint64_t allocations = 0;
+        uint64_t deallocations = 0;
+        for (const auto& tier : counters.tiers) {
+            allocations += tier.allocations;
+            deallocations += tier.deallocations;
+        }
+        CHECK(allocations >= 4000);
+        CHECK(allocations == deallocations);
+        CHECK(total_bytes_balance(counters) == 0);
+    }
+}
+
+#else
+
+TEST_CASE("stats stay zero when disabled") {
+    static_assert(not small::stats::enabled);
+    small::small_string str(std::string(1000, 'd'));
+    auto counters = small::stats::snapshot();
+    CHECK(total_bytes_balance(counters) == 0);
+    CHECK(counters.tier(small::CoreType::Median).allocations == 0);
+}
+
+#endif
@@ -0,0 +1,152 @@
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+namespace {
+
+// one string of every tier, so relocation moves Internal bytes and Short/Median/Long pointers alike
+auto tiered_text(std::size_t i) -> std::string {
+    static constexpr std::size_t lengths[] = {3, 20, 300, 20000};
+    return std::string(lengths[i % 4], static_cast<char>('a' + i % 26)) + std::to_string(i);
+}
+
+template <typename String>
+void check_growth() {
+    small::string_vector<String> vec;
+    std::vector<std::string> expected;
+    for (std::size_t i = 0; i < 200; ++i) {
+        vec.emplace_back(tiered_text(i));
+        expected.push_back(tiered_text(i));
+    }
+    REQUIRE(vec.size() == expected.size());
+    CHECK(vec.capacity() >= vec.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        CHECK(std::string_view(vec[i]) == expected[i]);
+    }
+}
+
+}  // namespace
+
+TEST_CASE("trivially relocatable strings") {
+    CHECK(small::is_trivially_relocatable_v<small::small_string>);
+    CHECK(small::is_trivially_relocatable_v<small::small_byte_string>);
+    CHECK(small::is_trivially_relocatable_v<small::pooled_small_string>);
+    CHECK(small::is_trivially_relocatable_v<small::shared_small_string>);
+    CHECK(small::is_trivially_relocatable_v<small::pmr::small_string>);
+    CHECK(small::is_trivially_relocatable_v<int>);
+    CHECK_FALSE(small::is_trivially_relocatable_v<std::vector<int>>);
+
+    // a relocated string is the same string, the source is forgotten without its destructor
+    small::small_string source(std::string(500, 'r'));
+    const auto* text = source.data();
+    alignas(small::small_string) unsigned char storage[sizeof(small::small_string)];
+    std::memcpy(static_cast<void*>(storage), static_cast<const void*>(&source), sizeof(source));
+    ::new (static_cast<void*>(&source)) small::small_string();
+    auto* relocated = std::launder(reinterpret_cast<small::small_string*>(storage));
+    CHECK(relocated->data() == text);
+    CHECK(*relocated == std::string(500, 'r'));
+    std::destroy_at(relocated);
+}
+
+TEST_CASE("string_vector") {
+    SUBCASE("grows across the tiers") {
+        check_growth<small::small_string>();
+        check_growth<small::wide_small_string>();
+        check_growth<small::shared_small_string>();
+        check_growth<small::pooled_small_string>();
+    }
+
+    SUBCASE("construction copy and move") {
+        small::string_vector<> vec{"one", "two", small::small_string(std::string(400, 't'))};
+        CHECK(vec.size() == 3);
+        CHECK(vec.front() == "one");
+        CHECK(vec.back() == std::string(400, 't'));
+        auto copy = vec;
+        CHECK(copy == vec);
+        CHECK(copy[2].data() != vec[2].data());
+        auto moved = std::move(copy);
+        CHECK(moved == vec);
+        CHECK(copy.empty());  // NOLINT(bugprone-use-after-move)
+        small::string_vector<> assigned{"x"};
+        assigned = vec;
+        CHECK(assigned == vec);
+        assigned = small::string_vector<>{};
+        CHECK(assigned.empty());
+        std::vector<std::string> source{"a", "b", "c"};
+        small::string_vector<> from_range(source.begin(), source.end());
+        CHECK(from_range.size() == 3);
+        CHECK(from_range[1] == "b");
+    }
+
+    SUBCASE("an element may be appended to its own vector") {
+        small::string_vector<> vec;
+        vec.emplace_back(std::string(1000, 'e'));
+        while (vec.size() < vec.capacity()) {
+            vec.emplace_back("filler");
+        }
+        vec.push_back(vec[0]);
+        CHECK(vec.back() == std::string(1000, 'e'));
+        vec.resize(vec.capacity() + 1, vec[0]);
+        CHECK(vec.back() == std::string(1000, 'e'));
+    }
+
+    SUBCASE("insert and erase shift the tail") {
+        small::string_vector<> vec;
+        std::vector<std::string> expected;
+        for (std::size_t i = 0; i < 20; ++i) {
+            vec.emplace_back(tiered_text(i));
+            expected.push_back(tiered_text(i));
+        }
+        vec.insert(vec.begin() + 3, small::small_string("inserted"));
+        expected.insert(expected.begin() + 3, "inserted");
+        vec.erase(vec.begin() + 5, vec.begin() + 9);
+        expected.erase(expected.begin() + 5, expected.begin() + 9);
+        auto next = vec.erase(vec.begin());
+        expected.erase(expected.begin());
+        CHECK(next == vec.begin());
+        vec.emplace(vec.end(), "last");
+        expected.emplace_back("last");
+        REQUIRE(vec.size() == expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            CHECK(std::string_view(vec[i]) == expected[i]);
+        }
+    }
+
+    SUBCASE("resize reserve and shrink") {
+        small::string_vector<> vec;
+        vec.reserve(100);
+        CHECK(vec.capacity() >= 100);
+        const auto* block = vec.data();
+        vec.resize(50);
+        CHECK(vec.data() == block);
+        CHECK(vec[49].empty());
+        vec.resize(60, small::small_string("sixty"));
+        CHECK(vec[59] == "sixty");
+        vec.resize(10);
+        CHECK(vec.size() == 10);
+        vec.shrink_to_fit();
+        CHECK(vec.capacity() >= 10);
+        CHECK(vec.capacity() < 100);
+        vec.pop_back();
+        CHECK(vec.size() == 9);
+        vec.clear();
+        vec.shrink_to_fit();
+        CHECK(vec.capacity() == 0);
+        CHECK(vec.data() == nullptr);
+    }
+
+    SUBCASE("bounds") {
+        small::string_vector<> vec{"only"};
+        CHECK(vec.at(0) == "only");
+        CHECK_THROWS_AS((void)vec.at(1), std::out_of_range);
+    }
+}
@@ -0,0 +1,193 @@
+#include <cstddef>
+#include <map>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+namespace {
+
+// remembers the size of every live allocation, a deallocation with another size or from another resource mismatches
+class tracking_resource : public std::pmr::memory_resource
+{
+   public:
+    std::map<void*, std::size_t> live;
+    std::size_t allocations = 0;
+    std::size_t mismatches = 0;
+
+   private:
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+        ++allocations;
+        auto* ptr = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        live[ptr] = bytes;
+        return ptr;
+    }
+
+    auto do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) -> void override {
+        auto it = live.find(ptr);
+        if (it == live.end() or it->second != bytes) {
+            ++mismatches;
+        } else {
+            live.erase(it);
+        }
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override {
+        return this == &other;
+    }
+};
+
+// registers a resource for the duration of a test
+struct registration
+{
+    uint8_t index;
+
+    explicit registration(std::pmr::memory_resource* resource) : index(small::resource_registry::add(resource)) {}
+    ~registration() { small::resource_registry::remove(index); }
+};
+
+}  // namespace
+
+static_assert(sizeof(small::pmr::tagged_string) == 8);
+static_assert(sizeof(small::pmr::tagged_byte_string) == 8);
+static_assert(small::is_trivially_relocatable_v<small::pmr::tagged_string>);
+
+TEST_CASE("resource_registry slots") {
+    tracking_resource first;
+    tracking_resource second;
+    auto first_index = small::resource_registry::add(&first);
+    auto second_index = small::resource_registry::add(&second);
+    CHECK(first_index != 0);
+    CHECK(second_index != 0);
+    CHECK(first_index != second_index);
+    CHECK(small::resource_registry::resource(first_index) == &first);
+    CHECK(small::resource_registry::resource(0) == std::pmr::new_delete_resource());
+
+    small::resource_registry::remove(first_index);
+    CHECK(small::resource_registry::resource(first_index) == nullptr);
+    auto reused = small::resource_registry::add(&first);
+    CHECK(reused == first_index);
+    small::resource_registry::remove(reused);
+    small::resource_registry::remove(second_index);
+
+    // a full registry is reported instead of handing out the default resource
+    std::vector<uint8_t> taken;
+    for (std::size_t i = 1; i < small::resource_registry::kMaxResources; ++i) {
+        taken.push_back(small::resource_registry::add(&first));
+    }
+    CHECK_THROWS_AS((void)small::resource_registry::add(&second), std::length_error);
+    for (auto index : taken) {
+        small::resource_registry::remove(index);
+    }
+
+    CHECK(small::resource_registry::current() == 0);
+    {
+        small::resource_registry::scope outer(7);
+        CHECK(small::resource_registry::current() == 7);
+        {
+            small::resource_registry::scope inner(9);
+            CHECK(small::resource_registry::current() == 9);
+        }
+        CHECK(small::resource_registry::current() == 7);
+    }
+    CHECK(small::resource_registry::current() == 0);
+}
+
+TEST_CASE("tagged strings allocate from the resource of their scope") {
+    tracking_resource resource;
+    registration reg(&resource);
+
+    SUBCASE("every tier") {
+        {
+            small::resource_registry::scope scope(reg.index);
+            small::pmr::tagged_string internal_str("tiny");
+            small::pmr::tagged_string short_str(std::string(100, 's'));
+            small::pmr::tagged_string median_str(std::string(1000, 'm'));
+            small::pmr::tagged_string long_str(std::string(20000, 'l'));
+            small::pmr::tagged_byte_string byte_str(std::string(300, 'b'));
+            CHECK(internal_str == "tiny");
+            CHECK(short_str == std::string(100, 's'));
+            CHECK(median_str.size() == 1000);
+            CHECK(long_str.size() == 20000);
+            CHECK(byte_str.size() == 300);
+            CHECK(resource.allocations == 4);
+            CHECK(resource.live.size() == 4);
+        }
+        CHECK(resource.live.empty());
+        CHECK(resource.mismatches == 0);
+    }
+
+    SUBCASE("Median and Long growth stays in the resource of the buffer") {
+        std::string expected(1000, 'g');
+        small::pmr::tagged_string str;
+        {
+            small::resource_registry::scope scope(reg.index);
+            str.append(expected);
+        }
+        CHECK(resource.allocations == 1);
+        // outside the scope, the Median buffer is reallocated into a Long one in its own resource
+        for (int i = 0; i < 3000; ++i) {
+            str.append("0123456789");
+            expected.append("0123456789");
+        }
+        CHECK(std::string_view(str) == expected);
+        CHECK(resource.allocations > 1);
+        CHECK(resource.live.size() == 1);
+        str = small::pmr::tagged_string();
+        CHECK(resource.live.empty());
+        CHECK(resource.mismatches == 0);
+    }
+
+    SUBCASE("copies allocate from the current scope") {
+        small::resource_registry::scope scope(reg.index);
+        small::pmr::tagged_string original(std::string(500, 'o'));
+        small::pmr::tagged_string copy;
+        {
+            small::resource_registry::scope fallback(0);
+            copy = original;
+        }
+        CHECK(copy == original);
+        CHECK(resource.live.size() == 1);
+        small::pmr::tagged_string moved(std::move(original));
+        CHECK(moved == copy);
+        CHECK(resource.live.size() == 1);
+    }
+
+    SUBCASE("strings outside every scope use the default resource") {
+        small::pmr::tagged_string str(std::string(5000, 'd'));
+        str.append(std::string(50000, 'e'));
+        CHECK(str.size() == 55000);
+        CHECK(resource.allocations == 0);
+    }
+
+    SUBCASE("a monotonic arena") {
+        std::pmr::monotonic_buffer_resource arena;
+        registration arena_reg(&arena);
+        small::resource_registry::scope scope(arena_reg.index);
+        std::vector<small::pmr::tagged_string> strings;
+        for (std::size_t i = 0; i < 300; ++i) {
+            strings.emplace_back(std::string(i * 3, static_cast<char>('a' + i % 26)));
+        }
+        for (std::size_t i = 0; i < strings.size(); ++i) {
+            CHECK(strings[i].size() == i * 3);
+        }
+        CHECK(resource.allocations == 0);
+    }
+
+    SUBCASE("an exhausted resource throws like it does for pmr_core") {
+        char storage[1024];
+        std::pmr::monotonic_buffer_resource arena(storage, sizeof(storage), std::pmr::null_memory_resource());
+        registration arena_reg(&arena);
+        small::resource_registry::scope scope(arena_reg.index);
+        small::pmr::tagged_string str(std::string(300, 'x'));
+        CHECK_THROWS_AS(str.append(std::string(4000, 'y')), std::bad_alloc);
+        CHECK(str == std::string(300, 'x'));
+        CHECK_THROWS_AS(small::pmr::tagged_string(std::string(4000, 'z')), std::bad_alloc);
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "include/smallstring.hpp"
+
+// a text over a tiny alphabet, so needles built from it match often and partially match everywhere
+inline auto make_text(std::mt19937& gen, std::size_t size, std::string_view alphabet) -> std::string {
+    std::uniform_int_distribution<std::size_t> pick(0, alphabet.size() - 1);
+    std::string text(size, ' ');
+    for (auto& ch : text) {
+        ch = alphabet[pick(gen)];
+    }
+    return text;
+}
+
+// the position string_view reports, as the search kernels report it
+inline auto to_kernel(std::size_t pos) -> std::size_t {
+    return pos == std::string_view::npos ? small::search::kNotFound : pos;
+}
@@ -0,0 +1,159 @@
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+namespace {
+
+// a text of the given length cycling through code units that need more than one byte
+template <typename Char>
+auto make_text(std::size_t length) -> std::basic_string<Char> {
+    std::basic_string<Char> text;
+    for (std::size_t i = 0; i < length; ++i) {
+        text.push_back(static_cast<Char>(0x3b1 + (i % 40)));
+    }
+    return text;
+}
+
+template <typename String>
+void check_wide_string() {
+    using Char = typename String::value_type;
+    using std_string = std::basic_string<Char>;
+    using view = std::basic_string_view<Char>;
+
+    SUBCASE("round trips through every tier") {
+        for (std::size_t length : {0UL, 1UL, 2UL, 3UL, 7UL, 8UL, 30UL, 31UL, 100UL, 255UL, 256UL, 1000UL, 5000UL}) {
+            auto text = make_text<Char>(length);
+            String str(text);
+            CHECK(str.size() == length);
+            CHECK(str.capacity() >= length);
+            CHECK(view(str) == text);
+            CHECK(str.c_str()[length] == Char());
+        }
+    }
+
+    SUBCASE("append grows across the tiers") {
+        String str;
+        std_string expected;
+        for (std::size_t i = 0; i < 3000; ++i) {
+            auto ch = static_cast<Char>(0x4e00 + i);
+            str.push_back(ch);
+            expected.push_back(ch);
+            if (i % 97 == 0) {
+                REQUIRE(view(str) == expected);
+                REQUIRE(str.c_str()[str.size()] == Char());
+            }
+        }
+        str.append(expected.data(), 10);
+        expected.append(expected.data(), 10);
+        CHECK(view(str) == expected);
+    }
+
+    SUBCASE("insert erase replace") {
+        auto text = make_text<Char>(300);
+        String str(text);
+        std_string expected(text);
+        str.insert(5, view(text).substr(0, 40));
+        expected.insert(5, text.substr(0, 40));
+        CHECK(view(str) == expected);
+        str.erase(10, 200);
+        expected.erase(10, 200);
+        CHECK(view(str) == expected);
+        str.replace(1, 3, view(text).substr(100, 70));
+        expected.replace(1, 3, text.substr(100, 70));
+        CHECK(view(str) == expected);
+        str.resize(2);
+        expected.resize(2);
+        CHECK(view(str) == expected);
+        str.resize(50, Char('x'));
+        expected.resize(50, Char('x'));
+        CHECK(view(str) == expected);
+    }
+
+    SUBCASE("reserve and shrink keep the text") {
+        auto text = make_text<Char>(20);
+        String str(text);
+        str.reserve(4000);
+        CHECK(str.capacity() >= 4000);
+        CHECK(view(str) == text);
+        str.shrink_to_fit();
+        CHECK(str.capacity() >= 20);
+        CHECK(str.capacity() < 4000);
+        CHECK(view(str) == text);
+    }
+
+    SUBCASE("search and compare") {
+        auto text = make_text<Char>(500);
+        String str(text);
+        auto needle = text.substr(123, 9);
+        CHECK(str.find(needle.data(), 0, needle.size()) == text.find(needle));
+        CHECK(str.rfind(Char(0x3b1 + 5)) == text.rfind(Char(0x3b1 + 5)));
+        CHECK(str.find(Char(0xffff)) == String::npos);
+        CHECK(str.starts_with(view(text).substr(0, 41)));
+        CHECK(str == view(text));
+        CHECK(view(text).substr(0, 10) < str);
+        CHECK(String(view(text).substr(0, 10)) < str);
+    }
+
+    SUBCASE("copy move and hash") {
+        auto text = make_text<Char>(64);
+        String str(text);
+        String copy = str;
+        String moved = std::move(copy);
+        CHECK(moved == str);
+        CHECK(std::hash<String>{}(str) == std::hash<view>{}(text));
+        std::unordered_set<String> set{str};
+        CHECK(set.contains(moved));
+    }
+}
+
+}  // namespace
+
+TEST_CASE("wide code unit strings") {
+    SUBCASE("u16string") { check_wide_string<small::u16string>(); }
+    SUBCASE("u32string") { check_wide_string<small::u32string>(); }
+    SUBCASE("wide_u16string") { check_wide_string<small::wide_u16string>(); }
+    SUBCASE("wide_u32string") { check_wide_string<small::wide_u32string>(); }
+}
+
+TEST_CASE("wide code unit internal capacity") {
+    CHECK(sizeof(small::u16string) == 8);
+    CHECK(sizeof(small::u32string) == 8);
+    CHECK(small::u16string().capacity() == 2);
+    CHECK(small::u32string().capacity() == 0);
+    CHECK(small::wide_u16string().capacity() == 6);
+    CHECK(small::wide_u32string().capacity() == 2);
+
+    small::u16string two(u"ab");
+    small::u16string three(u"abc");
+    CHECK(two.capacity() == 2);
+    CHECK(three.capacity() > 2);
+    CHECK(two == u"ab");
+    CHECK(three == u"abc");
+
+    small::u32string one(U"\U0001F600");
+    CHECK(one.size() == 1);
+    CHECK(one == U"\U0001F600");
+}
+
+TEST_CASE("wide code unit byte strings") {
+    using u16_byte_string = small::basic_small_string<char16_t, small::small_string_buffer, small::malloc_core,
+                                                      std::char_traits<char16_t>, std::allocator<char16_t>, false>;
+    using u32_byte_string = small::basic_small_string<char32_t, small::small_string_buffer, small::malloc_core,
+                                                      std::char_traits<char32_t>, std::allocator<char32_t>, false>;
+    CHECK(u16_byte_string().capacity() == 3);
+    CHECK(u32_byte_string().capacity() == 1);
+
+    std::u16string text16(u"nul\0inside", 10);
+    u16_byte_string bytes16(text16);
+    bytes16.append(text16);
+    CHECK(std::u16string_view(bytes16.data(), bytes16.size()) == text16 + text16);
+
+    std::u32string text32(300, U'\0');
+    u32_byte_string bytes32(text32);
+    CHECK(bytes32.size() == 300);
+    CHECK(std::u32string_view(bytes32.data(), bytes32.size()) == text32);
+}
@@ -0,0 +1,116 @@
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "doctest/doctest/doctest.h"
+#include "include/smallstring.hpp"
+
+TEST_CASE("wide_core internal storage") {
+    SUBCASE("object size") {
+        CHECK(sizeof(small::wide_small_string) == 16);
+        CHECK(sizeof(small::wide_small_byte_string) == 16);
+    }
+
+    SUBCASE("empty string") {
+        small::wide_small_string str;
+        CHECK(str.empty());
+        CHECK(str.size() == 0);
+        CHECK(str.capacity() == 14);
+        CHECK(str.c_str()[0] == '\0');
+    }
+
+    SUBCASE("up to 14 chars stay internal") {
+        for (size_t len = 1; len <= 14; ++len) {
+            std::string expected(len, 'k');
+            small::wide_small_string str(expected.c_str());
+            CHECK(str.size() == len);
+            CHECK(str.capacity() == 14);
+            CHECK(str == expected.c_str());
+            CHECK(str.c_str()[len] == '\0');
+        }
+    }
+
+    SUBCASE("15 chars go to the Short tier") {
+        small::wide_small_string str("123456789012345");
+        CHECK(str.size() == 15);
+        CHECK(str.capacity() > 14);
+        CHECK(str == "123456789012345");
+        CHECK(str.c_str()[15] == '\0');
+    }
+
+    SUBCASE("byte string inlines 15 chars") {
+        small::wide_small_byte_string str("123456789012345");
+        CHECK(str.size() == 15);
+        CHECK(str.capacity() == 15);
+        CHECK(std::memcmp(str.data(), "123456789012345", 15) == 0);
+    }
+}
+
+TEST_CASE("wide_core external storage and growth") {
+    SUBCASE("append across all tiers") {
+        small::wide_small_string str;
+        std::string expected;
+        for (int i = 0; i < 20000; ++i) {
+            auto ch = static_cast<char>('a' + i % 26);
+            str.push_back(ch);
+            expected.push_back(ch);
+        }
+        CHECK(str.size() == expected.size());
+        CHECK(std::string_view(str) == expected);
+        CHECK(str.c_str()[str.size()] == '\0');
+    }
+
+    SUBCASE("shrink back to internal") {
+        small::wide_small_string str(300, 'x');
+        str.resize(10);
+        str.shrink_to_fit();
+        CHECK(str.size() == 10);
+        CHECK(str.capacity() == 14);
+        CHECK(str == "xxxxxxxxxx");
+    }
+
+    SUBCASE("reserve keeps content") {
+        small::wide_small_string str("metric.tag.01");
+        str.reserve(1000);
+        CHECK(str.capacity() >= 1000);
+        CHECK(str == "metric.tag.01");
+    }
+}
+
+TEST_CASE("wide_core copy move and swap") {
+    SUBCASE("copy internal and external") {
+        small::wide_small_string inner("AAPL.NASDAQ");
+        small::wide_small_string outer("550e8400-e29b-41d4-a716-446655440000");
+        auto inner_copy = inner;
+        auto outer_copy = outer;
+        CHECK(inner_copy == inner);
+        CHECK(outer_copy == outer);
+        CHECK(outer_copy.data() != outer.data());
+    }
+
+    SUBCASE("move leaves source empty") {
+        small::wide_small_string src("550e8400-e29b-41d4-a716-446655440000");
+        small::wide_small_string dst(std::move(src));
+        CHECK(dst == "550e8400-e29b-41d4-a716-446655440000");
+        CHECK(src.empty());  // NOLINT(bugprone-use-after-move)
+    }
+
+    SUBCASE("swap internal with external") {
+        small::wide_small_string a("short-key");
+        small::wide_small_string b("a much longer value that lives on the heap");
+        a.swap(b);
+        CHECK(a == "a much longer value that lives on the heap");
+        CHECK(b == "short-key");
+    }
+
+    SUBCASE("as map key") {
+        std::map<small::wide_small_string, int> map;
+        map["host.cpu.user"] = 1;
+        map["host.cpu.system"] = 2;
+        map["host.cpu.user"] += 10;
+        CHECK(map.size() == 2);
+        CHECK(map["host.cpu.user"] == 11);
+        CHECK(map["host.cpu.system"] == 2);
+    }
+}